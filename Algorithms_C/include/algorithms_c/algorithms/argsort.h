@@ -0,0 +1,105 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_ARGSORT_H
+#define ALGORITHMS_C_ALGORITHMS_ARGSORT_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file argsort.h
+ * @brief Indirect sorting: order indices instead of moving records.
+ *
+ * The generic sorts in ``sorting.h`` move whole records on every swap, which
+ * dominates the cost once elements are a few hundred bytes wide.  The
+ * functions below leave ``data`` untouched and sort an array of ``size_t``
+ * indices instead; ``ac_apply_permutation`` can then reorder the records with
+ * every record moving exactly once.
+ *
+ * A permutation ``perm`` produced here lists, for every output position
+ * ``i``, the input index of the record that belongs there: sorted order is
+ * ``data[perm[0]], data[perm[1]], ...``.
+ */
+
+/**
+ * @brief Compute the permutation that sorts ``data`` (unstable).
+ *
+ * Sorts ``out_perm`` with an introsort (median-of-three or ninther pivots,
+ * Hoare partitioning that splits runs of equal keys evenly, heap-sort
+ * fallback) whose comparisons dereference ``data``.  Records never move and
+ * no memory is allocated.
+ *
+ * @param data Records to inspect; left unchanged.
+ * @param size Number of records.
+ * @param element_size Size in bytes of each record.
+ * @param compare Comparator defining the order.
+ * @param out_perm Output array of ``size`` indices.
+ * @return ``0`` on success or ``-EINVAL`` when a pointer is ``NULL`` (with a
+ *         non-zero ``size``) or ``element_size`` is zero.
+ * @signature int ac_argsort(const void *data, size_t size,
+ *                           size_t element_size, ac_compare_fn compare,
+ *                           size_t *out_perm)
+ */
+int ac_argsort(
+    const void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t *out_perm
+);
+
+/**
+ * @brief Stable variant of ``ac_argsort``.
+ *
+ * Records that compare equal keep their input order, i.e. their indices
+ * appear in ascending order in ``out_perm``.  Stability comes from breaking
+ * comparator ties on the index itself, so the same allocation-free engine is
+ * used.
+ *
+ * @return ``0`` on success or ``-EINVAL`` for invalid arguments.
+ * @signature int ac_stable_argsort(const void *data, size_t size,
+ *                                  size_t element_size,
+ *                                  ac_compare_fn compare, size_t *out_perm)
+ */
+int ac_stable_argsort(
+    const void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t *out_perm
+);
+
+/**
+ * @brief Reorder ``data`` in place so that ``data[i]`` becomes the old
+ *        ``data[perm[i]]``.
+ *
+ * Follows the cycles of ``perm``: every record is copied exactly once, plus
+ * one copy through a temporary slot per cycle of length two or more.  ``perm``
+ * is validated first; if it is not a permutation of ``[0, size)`` nothing is
+ * moved.
+ *
+ * @param data Records to reorder.
+ * @param size Number of records.
+ * @param element_size Size in bytes of each record.
+ * @param perm Permutation, e.g. produced by ``ac_argsort``; left unchanged.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or a ``perm``
+ *         that is not a permutation, or ``-ENOMEM`` if the ``size``-bit
+ *         visited map cannot be allocated.
+ * @signature int ac_apply_permutation(void *data, size_t size,
+ *                                     size_t element_size,
+ *                                     const size_t *perm)
+ */
+int ac_apply_permutation(
+    void *data,
+    size_t size,
+    size_t element_size,
+    const size_t *perm
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
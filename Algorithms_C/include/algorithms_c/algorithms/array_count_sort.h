@@ -9,7 +9,7 @@ extern "C" {
 
 /**
  * @file array_count_sort.h
- * @brief Counting-sort helper for two-dimensional integer arrays.
+ * @brief Counting-sort helpers for two-dimensional integer arrays.
  *
  * The Python project ships an educational routine that sorts a matrix by a
  * selected key column while keeping rows intact. This header mirrors that
@@ -17,13 +17,20 @@ extern "C" {
  * remains self-contained for readers who study the API before opening sources.
  */
 
+/**
+ * Flag for ``ac_row_sort_int``: treat ``INT_MIN`` as a null that sorts after
+ * every other value, the order used by ``ac_array_count_sort``.
+ */
+#define AC_ROW_SORT_NULLS_LAST 1U
+
 /**
  * @brief Stable-sort matrix rows by values in column ``key``.
  *
- * The algorithm performs a counting-sort pass over the selected column,
- * preserving relative order for rows with equal keys. The matrix is expected
- * to contain non-negative values inside the key column because counts are used
- * directly as indexes. Invalid inputs are treated as no-ops, matching the
+ * Rows are ordered by the key column with ``INT_MIN`` treated as a null that
+ * sorts last, preserving relative order for rows with equal keys.  The order
+ * is computed as a permutation by the engine of ``ac_row_sort_int``, and the
+ * cells are then moved once through a single contiguous copy of the table.
+ * Invalid inputs and allocation failures are treated as no-ops, matching the
  * defensive style used across the translated repository.
  *
  * @param arr Matrix represented as an array of row pointers.
@@ -35,6 +42,48 @@ extern "C" {
  */
 void ac_array_count_sort(int **arr, size_t rows, size_t cols, size_t key);
 
+/**
+ * @brief Stable-sort the rows of a contiguous row-major table by several key
+ *        columns.
+ *
+ * Row ``i`` starts at ``table + i * stride``; only its first ``cols`` cells
+ * belong to the row and are moved.  Rows are compared by ``keys[0]`` first,
+ * ties are broken by ``keys[1]`` and so on; rows equal on every key keep
+ * their order.
+ *
+ * Only a permutation of row indices moves while sorting: for each key column,
+ * least significant first, the keys are gathered in permutation order and
+ * sorted together with it by stable LSD counting passes of at most 11 bits
+ * over the column's value span.  A column spanning at most 2048 values
+ * therefore costs one pass.  The rows are then gathered once into a packed
+ * copy of the table and copied back.  If that copy cannot be allocated and
+ * ``stride == cols``, ``ac_apply_permutation`` reorders the rows in place
+ * instead.
+ *
+ * @param table Row-major table holding ``(rows - 1) * stride + cols`` ints.
+ * @param rows Number of rows.
+ * @param cols Number of cells per row.
+ * @param stride Distance in ints between the starts of consecutive rows; at
+ *        least ``cols``.
+ * @param keys ``key_count`` column indices, most significant first.
+ * @param key_count Number of key columns; zero leaves the table unchanged.
+ * @param flags ``0`` or ``AC_ROW_SORT_NULLS_LAST``.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or key columns
+ *         outside ``[0, cols)``, or ``-ENOMEM``.
+ * @signature int ac_row_sort_int(int *table, size_t rows, size_t cols,
+ *                                size_t stride, const size_t *keys,
+ *                                size_t key_count, unsigned flags)
+ */
+int ac_row_sort_int(
+    int *table,
+    size_t rows,
+    size_t cols,
+    size_t stride,
+    const size_t *keys,
+    size_t key_count,
+    unsigned flags
+);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,6 +1,9 @@
 #ifndef ALGORITHMS_C_ALGORITHMS_DAMERAU_LEVENSHTEIN_H
 #define ALGORITHMS_C_ALGORITHMS_DAMERAU_LEVENSHTEIN_H
 
+#include <stddef.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -31,6 +34,41 @@ extern "C" {
  */
 int ac_damerau_levenshtein_distance(const char *lhs, const char *rhs);
 
+/**
+ * @brief Workspace bytes needed by ``ac_damerau_levenshtein_distance_ws``.
+ *
+ * The dynamic program keeps three rows indexed by the shorter string, so the
+ * result is ``3 * (min(lhs_len, rhs_len) + 1)`` cells plus alignment slack, or
+ * ``SIZE_MAX`` on overflow.
+ *
+ * @param lhs_len Length of the first string in bytes.
+ * @param rhs_len Length of the second string in bytes.
+ * @signature size_t ac_damerau_levenshtein_workspace_bytes(size_t lhs_len,
+ *                                                         size_t rhs_len)
+ */
+size_t ac_damerau_levenshtein_workspace_bytes(size_t lhs_len, size_t rhs_len);
+
+/**
+ * @brief Allocation-free variant of ::ac_damerau_levenshtein_distance.
+ *
+ * The dynamic-programming rows live in ``workspace``.
+ *
+ * @param workspace Scratch memory of at least
+ *        ``ac_damerau_levenshtein_workspace_bytes`` bytes.
+ * @param lhs Source string. Must not be ``NULL``.
+ * @param rhs Target string. Must not be ``NULL``.
+ * @return Non-negative edit distance on success, ``-EINVAL`` for ``NULL``
+ *         arguments, ``-ENOSPC`` when the workspace is too small, or
+ *         ``-ERANGE`` when the distance does not fit in an ``int``.
+ * @signature int ac_damerau_levenshtein_distance_ws(
+ *     ac_sort_workspace *workspace, const char *lhs, const char *rhs)
+ */
+int ac_damerau_levenshtein_distance_ws(
+    ac_sort_workspace *workspace,
+    const char *lhs,
+    const char *rhs
+);
+
 /**
  * @brief Compatibility alias preserving the Python file spelling
  *        ``damerau_levenstein``.
@@ -0,0 +1,74 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_EXTERNAL_SORT_H
+#define ALGORITHMS_C_ALGORITHMS_EXTERNAL_SORT_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file external_sort.h
+ * @brief Merge sort for files of fixed-width records larger than memory.
+ *
+ * ``ac_external_sort`` works in three stages:
+ *
+ * 1. **Run generation.**  The input is read in chunks of about two thirds of
+ *    ``memory_budget``.  Each chunk is sorted with ``ac_tim_sort_ws``, using
+ *    the rest of the budget as its workspace, and written sequentially to a
+ *    temporary run file.
+ * 2. **Intermediate merges.**  While there are more runs than can be merged
+ *    at once, groups of runs are merged into longer runs in a second
+ *    temporary file.
+ * 3. **Final merge.**  The remaining runs are merged straight into the
+ *    output file.
+ *
+ * Merges use a loser tree, so every output record costs one comparison per
+ * tree level.  Each run gets two read buffers.  When the library is built
+ * with POSIX threads, a prefetch thread refills the buffer the merge is not
+ * using, which overlaps the reads with the comparisons.  Without threads the
+ * refill happens synchronously.
+ *
+ * Buffers of at least a page are page-aligned.  The temporary files live in
+ * ``$TMPDIR`` (``/tmp`` when unset) and are unlinked as soon as they are
+ * created.  Their combined size peaks at twice the input size.
+ *
+ * Records that compare equal keep their input order, so the sort is stable.
+ */
+
+/**
+ * @brief Sort the records of ``in_path`` into ``out_path``.
+ *
+ * The record data, sort chunks, read buffers and output buffer all come out
+ * of ``memory_budget``.  Per-run bookkeeping is allocated separately: a few
+ * words per run.  ``in_path`` and ``out_path`` may name the same file
+ * because the input is fully consumed before the output is opened.
+ *
+ * @param in_path File containing a whole number of records.
+ * @param out_path File to create or truncate for the sorted output.
+ * @param element_size Size in bytes of each record.
+ * @param compare Comparator defining the order.
+ * @param memory_budget Bytes of memory the sort may use for record data; at
+ *        least ``6 * element_size``.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments, a budget that
+ *         is too small or an input whose size is not a multiple of
+ *         ``element_size``, ``-ENOMEM`` if the budget cannot be allocated,
+ *         or the negated ``errno`` of a failed file operation.
+ * @signature int ac_external_sort(const char *in_path, const char *out_path,
+ *                                 size_t element_size, ac_compare_fn compare,
+ *                                 size_t memory_budget)
+ */
+int ac_external_sort(
+    const char *in_path,
+    const char *out_path,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t memory_budget
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,155 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_EYTZINGER_H
+#define ALGORITHMS_C_ALGORITHMS_EYTZINGER_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/binary_search.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file eytzinger.h
+ * @brief Static search index in Eytzinger (BFS) order for repeated lookups.
+ *
+ * ``ac_lower_bound`` halves a sorted array, so on tables larger than the
+ * cache almost every probe is a miss and the next probe address depends on
+ * it.  The index below copies the sorted table once into the breadth-first
+ * order of an implicit binary search tree: the children of node ``k`` are
+ * nodes ``2k`` and ``2k + 1``.  The top levels then share a few cache lines,
+ * and the 16 descendants four levels below node ``k`` are contiguous from
+ * node ``16k``, so a query prefetches that block while it resolves the
+ * current level.  The descent itself is branchless: each level adds the
+ * comparison result to ``2k``.
+ *
+ * Queries return the same rank as ``ac_lower_bound`` on the original array,
+ * so callers can switch without other changes.  The index keeps its own copy
+ * and never refers back to the source table.
+ */
+
+/**
+ * @struct ac_eytzinger_index
+ * @brief Sorted elements laid out in Eytzinger order.
+ */
+typedef struct {
+    /** Node ``k`` (``1 <= k <= size``) starts at ``k * element_size``. */
+    unsigned char *nodes;
+    /** Allocation behind ``nodes``, which is aligned to a cache line. */
+    void *memory;
+    /** Number of indexed elements. */
+    size_t size;
+    /** Size in bytes of each element. */
+    size_t element_size;
+    /** Comparator the source table is sorted by. */
+    ac_compare_fn compare;
+} ac_eytzinger_index;
+
+/**
+ * @brief Build an index over ``size`` elements of ``sorted``.
+ *
+ * @param index Index to initialise; release it with ``ac_eytzinger_destroy``.
+ * @param sorted Table sorted ascending under ``compare``; may be ``NULL``
+ *        only when ``size`` is zero.
+ * @param size Number of elements in ``sorted``.
+ * @param element_size Size in bytes of each element.
+ * @param compare Comparator the table is sorted by.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or
+ *         ``-ENOMEM`` when the copy cannot be allocated.
+ * @signature int ac_eytzinger_init(ac_eytzinger_index *index,
+ *                                  const void *sorted, size_t size,
+ *                                  size_t element_size,
+ *                                  ac_compare_fn compare)
+ */
+int ac_eytzinger_init(
+    ac_eytzinger_index *index,
+    const void *sorted,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief Build an index over a sorted ``int`` table.
+ *
+ * The index answers ``ac_eytzinger_lower_bound_int`` as well as the generic
+ * query.
+ *
+ * @signature int ac_eytzinger_init_int(ac_eytzinger_index *index,
+ *                                      const int *sorted, size_t size)
+ */
+int ac_eytzinger_init_int(
+    ac_eytzinger_index *index,
+    const int *sorted,
+    size_t size
+);
+
+/**
+ * @brief Build an index over a sorted ``double`` table without NaNs.
+ *
+ * The index answers ``ac_eytzinger_lower_bound_double`` as well as the
+ * generic query.
+ *
+ * @signature int ac_eytzinger_init_double(ac_eytzinger_index *index,
+ *                                         const double *sorted, size_t size)
+ */
+int ac_eytzinger_init_double(
+    ac_eytzinger_index *index,
+    const double *sorted,
+    size_t size
+);
+
+/**
+ * @brief Release the memory of ``index`` and reset it to empty.
+ *
+ * @signature void ac_eytzinger_destroy(ac_eytzinger_index *index)
+ */
+void ac_eytzinger_destroy(ac_eytzinger_index *index);
+
+/**
+ * @brief Rank of the first element not less than ``target``.
+ *
+ * @return The value ``ac_lower_bound`` returns on the source table, in
+ *         ``[0, size]``.  Returns ``size`` (``0`` for a ``NULL`` index) on
+ *         invalid input to stay fail-safe.
+ * @signature size_t ac_eytzinger_lower_bound(const ac_eytzinger_index *index,
+ *                                           const void *target)
+ */
+size_t ac_eytzinger_lower_bound(
+    const ac_eytzinger_index *index,
+    const void *target
+);
+
+/**
+ * @brief ``ac_eytzinger_lower_bound`` for an index built over ``int``.
+ *
+ * Compares with ``<`` instead of calling the comparator.  Returns ``size``
+ * unless the index holds plain ``int`` elements ordered by ``ac_compare_int``,
+ * as built by ``ac_eytzinger_init_int``.
+ *
+ * @signature size_t ac_eytzinger_lower_bound_int(
+ *     const ac_eytzinger_index *index, int target)
+ */
+size_t ac_eytzinger_lower_bound_int(
+    const ac_eytzinger_index *index,
+    int target
+);
+
+/**
+ * @brief ``ac_eytzinger_lower_bound`` for an index built over ``double``.
+ *
+ * Compares with ``<`` instead of calling the comparator.  Returns ``size``
+ * unless the index was built by ``ac_eytzinger_init_double``.
+ *
+ * @signature size_t ac_eytzinger_lower_bound_double(
+ *     const ac_eytzinger_index *index, double target)
+ */
+size_t ac_eytzinger_lower_bound_double(
+    const ac_eytzinger_index *index,
+    double target
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_KEY_SORT_H
+#define ALGORITHMS_C_ALGORITHMS_KEY_SORT_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file key_sort.h
+ * @brief Sort records by a scalar field described by offset and type.
+ *
+ * Most record sorts order structs by one embedded number.  Expressing that
+ * through an ``ac_compare_fn`` costs an indirect call per comparison and
+ * rules out radix sorting.  ``ac_sort_by_key`` is told where the key lives
+ * and what it is instead, so it can:
+ *
+ * 1. read every key once and map it to an unsigned integer whose order is
+ *    the requested one (sign bit flipped for signed integers, the IEEE
+ *    mapping of ``ac_radix_sort_float`` for floating point, complemented for
+ *    descending order), paired with the record's index;
+ * 2. sort the (key, index) pairs with stable LSD radix passes of at most 11
+ *    bits, skipping passes whose digit is shared by every key, or with an
+ *    inline insertion sort for short inputs;
+ * 3. move every record exactly once into a scratch table in sorted order and
+ *    copy the table back.
+ */
+
+/** Type of the key field. */
+typedef enum {
+    AC_KEY_INT8,
+    AC_KEY_UINT8,
+    AC_KEY_INT16,
+    AC_KEY_UINT16,
+    AC_KEY_INT32,
+    AC_KEY_UINT32,
+    AC_KEY_INT64,
+    AC_KEY_UINT64,
+    AC_KEY_FLOAT,
+    AC_KEY_DOUBLE,
+} ac_key_type;
+
+/** Flag for ``ac_sort_by_key``: largest keys first. */
+#define AC_SORT_BY_KEY_DESCENDING 1U
+
+/**
+ * Flag for ``ac_sort_by_key``: records with equal keys keep their input
+ * order.  Every current engine path is stable, so the flag costs nothing.
+ */
+#define AC_SORT_BY_KEY_STABLE 2U
+
+/**
+ * @brief Sort records by the scalar key stored at ``key_offset``.
+ *
+ * Keys are read with ``memcpy`` in native byte order, so the field need not
+ * be aligned.  Floating-point keys follow the total order
+ * ``-NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN`` (reversed when
+ * descending).
+ *
+ * Records move only after the order is known: each is copied once into a
+ * scratch table and the table is copied back.  If the table cannot be
+ * allocated, ``ac_apply_permutation`` reorders the records in place instead.
+ *
+ * @param data Records to sort in place.
+ * @param size Number of records.
+ * @param element_size Size in bytes of each record.
+ * @param key_offset Byte offset of the key within a record.
+ * @param key_type Type of the key.
+ * @param flags Bitwise OR of ``AC_SORT_BY_KEY_DESCENDING`` and
+ *        ``AC_SORT_BY_KEY_STABLE``, or ``0``.
+ * @return ``0`` on success, ``-EINVAL`` when ``data`` is ``NULL`` with a
+ *         non-zero ``size``, ``element_size`` is zero, the key does not fit
+ *         inside a record, or ``key_type`` or ``flags`` is unknown, or
+ *         ``-ENOMEM`` when the (key, index) pairs cannot be allocated.
+ * @signature int ac_sort_by_key(void *data, size_t size,
+ *                               size_t element_size, size_t key_offset,
+ *                               ac_key_type key_type, unsigned flags)
+ */
+int ac_sort_by_key(
+    void *data,
+    size_t size,
+    size_t element_size,
+    size_t key_offset,
+    ac_key_type key_type,
+    unsigned flags
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
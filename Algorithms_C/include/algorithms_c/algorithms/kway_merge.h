@@ -0,0 +1,199 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_KWAY_MERGE_H
+#define ALGORITHMS_C_ALGORITHMS_KWAY_MERGE_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file kway_merge.h
+ * @brief Merge many sorted inputs at once with a tournament (loser) tree.
+ *
+ * A loser tree keeps, for every internal node of a complete binary tree over
+ * the ``k`` inputs, the input that lost the match played there; the overall
+ * winner sits above the root.  After the winner's record is emitted only the
+ * matches on its leaf-to-root path are replayed, against the stored losers,
+ * so each output record costs at most ``ceil(log2(k))`` comparisons.  A binary
+ * heap needs up to twice as many, because every sift-down level compares two
+ * children and then the parent.
+ *
+ * All merges are stable: records that compare equal are emitted in input
+ * order, i.e. records of input ``i`` before equal records of input ``j > i``.
+ */
+
+/**
+ * @struct ac_merge_span
+ * @brief One sorted input: ``size`` contiguous records starting at ``data``.
+ */
+typedef struct {
+    const void *data;
+    size_t size;
+} ac_merge_span;
+
+/**
+ * @brief Supplies the next block of an input to a refilling cursor.
+ *
+ * Called when input ``input`` has been fully consumed, and once per input
+ * when the cursor starts.  The callback stores the next sorted block in
+ * ``span``; a ``size`` of zero marks the input as finished.  Each block must
+ * continue the order of the previous one.  The memory of the previous block
+ * is no longer referenced and may be reused.
+ *
+ * @return ``0`` on success; a negative value aborts the merge and is
+ *         reported by ``ac_kway_cursor_next``.
+ */
+typedef int (*ac_kway_refill_fn)(
+    void *context,
+    size_t input,
+    ac_merge_span *span
+);
+
+/**
+ * @struct ac_kway_cursor
+ * @brief Streaming k-way merge state.
+ *
+ * The fields are private; the struct is public only so that cursors can live
+ * on the stack.
+ */
+typedef struct {
+    size_t count;
+    size_t element_size;
+    ac_compare_fn compare;
+    ac_kway_refill_fn refill;
+    void *context;
+    const unsigned char **head;
+    const unsigned char **end;
+    size_t *tree;
+    int status;
+} ac_kway_cursor;
+
+/**
+ * @brief Merge ``count`` sorted spans into ``out``.
+ *
+ * @param inputs Array of ``count`` spans, each sorted by ``compare``.
+ * @param count Number of spans; zero is allowed.
+ * @param element_size Size in bytes of each record.
+ * @param compare Comparator defining the order.
+ * @param out Destination with room for the sum of all span sizes; must not
+ *        overlap any input.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or ``-ENOMEM``
+ *         when more than 64 inputs need a heap-allocated tree that cannot be
+ *         allocated.
+ * @signature int ac_kway_merge(const ac_merge_span *inputs, size_t count,
+ *                              size_t element_size, ac_compare_fn compare,
+ *                              void *out)
+ */
+int ac_kway_merge(
+    const ac_merge_span *inputs,
+    size_t count,
+    size_t element_size,
+    ac_compare_fn compare,
+    void *out
+);
+
+/**
+ * @brief ``ac_kway_merge`` for ``int`` spans with the built-in ``<``.
+ *
+ * Records are compared inline instead of through a callback.
+ *
+ * @signature int ac_kway_merge_int(const ac_merge_span *inputs, size_t count,
+ *                                  int *out)
+ */
+int ac_kway_merge_int(const ac_merge_span *inputs, size_t count, int *out);
+
+/**
+ * @brief ``ac_kway_merge`` for ``double`` spans with the built-in ``<``.
+ *
+ * As with the typed sorts, the placement of NaN values is unspecified.
+ *
+ * @signature int ac_kway_merge_double(const ac_merge_span *inputs,
+ *                                     size_t count, double *out)
+ */
+int ac_kway_merge_double(
+    const ac_merge_span *inputs,
+    size_t count,
+    double *out
+);
+
+/**
+ * @brief Start a streaming merge over fixed spans.
+ *
+ * ``inputs`` is copied, so the array (but not the records) may be released
+ * after the call.
+ *
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or ``-ENOMEM``.
+ * @signature int ac_kway_cursor_init(ac_kway_cursor *cursor,
+ *                                    const ac_merge_span *inputs,
+ *                                    size_t count, size_t element_size,
+ *                                    ac_compare_fn compare)
+ */
+int ac_kway_cursor_init(
+    ac_kway_cursor *cursor,
+    const ac_merge_span *inputs,
+    size_t count,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief Start a streaming merge whose inputs arrive block by block.
+ *
+ * ``refill`` is called once per input during initialisation and again
+ * whenever an input's current block is used up, which lets callers merge
+ * inputs that never fit in memory at once (for example runs read from
+ * files).
+ *
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments, ``-ENOMEM``,
+ *         or the first negative value returned by ``refill``.
+ * @signature int ac_kway_cursor_init_refill(ac_kway_cursor *cursor,
+ *                                           size_t count,
+ *                                           size_t element_size,
+ *                                           ac_compare_fn compare,
+ *                                           ac_kway_refill_fn refill,
+ *                                           void *context)
+ */
+int ac_kway_cursor_init_refill(
+    ac_kway_cursor *cursor,
+    size_t count,
+    size_t element_size,
+    ac_compare_fn compare,
+    ac_kway_refill_fn refill,
+    void *context
+);
+
+/**
+ * @brief Emit up to ``capacity`` further records into ``out``.
+ *
+ * @param cursor Initialised cursor.
+ * @param out Destination for up to ``capacity`` records.
+ * @param capacity Maximum number of records to write.
+ * @param out_count Receives the number written; fewer than ``capacity``
+ *        only once the merge is complete.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments, or the
+ *         negative value returned by a failing ``refill``.  After an error
+ *         every further call fails the same way.
+ * @signature int ac_kway_cursor_next(ac_kway_cursor *cursor, void *out,
+ *                                    size_t capacity, size_t *out_count)
+ */
+int ac_kway_cursor_next(
+    ac_kway_cursor *cursor,
+    void *out,
+    size_t capacity,
+    size_t *out_count
+);
+
+/**
+ * @brief Release the memory owned by ``cursor``.
+ *
+ * @signature void ac_kway_cursor_destroy(ac_kway_cursor *cursor)
+ */
+void ac_kway_cursor_destroy(ac_kway_cursor *cursor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_NTH_ELEMENT_H
+#define ALGORITHMS_C_ALGORITHMS_NTH_ELEMENT_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file nth_element.h
+ * @brief Selection and partial sorting for any element type.
+ *
+ * When only the ``k`` smallest records (or the ``k``-th smallest one) are
+ * needed, a full sort does far more work than necessary.  The helpers below
+ * follow the C++ ``std::nth_element``/``std::partial_sort`` family on the
+ * ``ac_compare_fn`` interface used by ``sorting.h``.  For the largest ``k``
+ * records, pass a comparator with the operands reversed.
+ */
+
+/**
+ * @brief Partially order ``data`` around its ``nth`` smallest element.
+ *
+ * Afterwards ``data[nth]`` holds the record that would be there if ``data``
+ * were sorted, no record before it compares greater and no record after it
+ * compares less.  The order within both sides is unspecified.
+ *
+ * Large ranges are narrowed with Floyd-Rivest sampling: the selection is
+ * first solved recursively on a small window around the expected position, so
+ * the pivot lands very close to ``nth`` and the expected number of
+ * comparisons is ``n + min(nth, n - nth) + o(n)``.  Should a range fail to
+ * shrink within ``2 * log2(n)`` partitioning rounds, it is finished by
+ * median-of-medians selection, which bounds the worst case by ``O(n)``.  No
+ * random numbers are used.  Records up to 256 bytes wide are staged on the
+ * stack; wider ones need a heap-allocated scratch slot.
+ *
+ * @param data Records to reorder.
+ * @param size Number of records.
+ * @param element_size Size in bytes of each record.
+ * @param compare Comparator defining the order.
+ * @param nth Zero-based rank to place; must be less than ``size``.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or
+ *         ``nth >= size``, or ``-ENOMEM`` if the scratch slot for wide records
+ *         cannot be allocated.
+ * @signature int ac_nth_element(void *data, size_t size, size_t element_size,
+ *                               ac_compare_fn compare, size_t nth)
+ */
+int ac_nth_element(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t nth
+);
+
+/**
+ * @brief Move the ``k`` smallest records to the front of ``data`` in order.
+ *
+ * Selects with ``ac_nth_element`` and then sorts only the first ``k``
+ * records, for ``O(n + k log k)`` time.  The remaining records end up in an
+ * unspecified order.  ``k >= size`` sorts the whole array.  Not stable.
+ *
+ * @param data Records to reorder.
+ * @param size Number of records.
+ * @param element_size Size in bytes of each record.
+ * @param compare Comparator defining the order.
+ * @param k Number of leading records to produce.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or ``-ENOMEM``
+ *         as for ``ac_nth_element``.
+ * @signature int ac_partial_sort(void *data, size_t size, size_t element_size,
+ *                                ac_compare_fn compare, size_t k)
+ */
+int ac_partial_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t k
+);
+
+/**
+ * @brief Copy the ``min(size, dest_size)`` smallest records of ``src`` into
+ *        ``dest`` in ascending order, leaving ``src`` untouched.
+ *
+ * ``dest`` is used as a bounded max-heap while ``src`` is scanned once: a
+ * record enters only when it is smaller than the largest record kept so far,
+ * so on typical inputs almost every record costs a single comparison.  The
+ * heap is sorted in place at the end.  The worst case is
+ * ``O(size log dest_size)``.
+ *
+ * @param src Records to select from; left unchanged.
+ * @param size Number of records in ``src``.
+ * @param element_size Size in bytes of each record.
+ * @param compare Comparator defining the order.
+ * @param dest Output buffer with room for ``dest_size`` records; must not
+ *        overlap ``src``.
+ * @param dest_size Capacity of ``dest`` in records.
+ * @return ``0`` on success, ``-EINVAL`` for invalid arguments or ``-ENOMEM``
+ *         if the scratch slot for records wider than 256 bytes cannot be
+ *         allocated.
+ * @signature int ac_partial_sort_copy(const void *src, size_t size,
+ *                                     size_t element_size,
+ *                                     ac_compare_fn compare, void *dest,
+ *                                     size_t dest_size)
+ */
+int ac_partial_sort_copy(
+    const void *src,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    void *dest,
+    size_t dest_size
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
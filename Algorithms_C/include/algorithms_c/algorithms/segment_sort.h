@@ -0,0 +1,106 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_SEGMENT_SORT_H
+#define ALGORITHMS_C_ALGORITHMS_SEGMENT_SORT_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file segment_sort.h
+ * @brief Sort many short arrays packed back to back in one buffer.
+ *
+ * The segments are described CSR-style: segment ``i`` holds the elements
+ * ``[offsets[i], offsets[i + 1])`` of ``data``, so ``offsets`` has
+ * ``num_segments + 1`` non-decreasing entries.  Each segment is sorted
+ * independently; elements never move between segments.
+ *
+ * Sorting every segment with its own ``ac_quick_sort`` call repeats the
+ * argument checks, the scratch set-up and the recursion bookkeeping per
+ * segment.  The functions below instead cut the segments into batches of
+ * roughly ``AC_SEGMENT_SORT_BATCH`` elements, prepare the scratch once per
+ * batch and finish segments of up to 16 elements (32 for ``int``) with
+ * insertion sort or a sorting network.  Batches are distributed over
+ * ``ac_parallel_for`` once the input holds at least
+ * ``AC_SEGMENT_SORT_PARALLEL_MIN`` elements.
+ *
+ * Every function returns ``0`` on success or ``-EINVAL`` when ``offsets`` is
+ * ``NULL`` with a non-zero ``num_segments``, the offsets decrease, ``data``
+ * is ``NULL`` while the segments are not empty, or (for the generic variant)
+ * ``element_size`` is zero or ``compare`` is ``NULL``.  Arguments are
+ * checked before any element moves.  None of the variants is stable.
+ */
+
+/** Elements per batch; one batch is the unit of work given to a thread. */
+#define AC_SEGMENT_SORT_BATCH 16384U
+
+/** Inputs with fewer elements than this are sorted on the calling thread. */
+#define AC_SEGMENT_SORT_PARALLEL_MIN 65536U
+
+/**
+ * @brief Sort every segment of ``data`` with ``compare``.
+ *
+ * Short segments are finished by insertion sort, longer ones by the
+ * introsort of ``ac_quick_sort``.
+ *
+ * @param data Buffer holding the segments back to back.
+ * @param offsets ``num_segments + 1`` element offsets delimiting the
+ *        segments.
+ * @param num_segments Number of segments.
+ * @param element_size Size in bytes of each element.
+ * @param compare Comparator defining the order; must be thread-safe.
+ * @param threads Maximum worker threads including the caller; ``0`` uses
+ *        every hardware thread.
+ * @signature int ac_sort_segments(void *data, const size_t *offsets,
+ *                                 size_t num_segments, size_t element_size,
+ *                                 ac_compare_fn compare, size_t threads)
+ */
+int ac_sort_segments(
+    void *data,
+    const size_t *offsets,
+    size_t num_segments,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t threads
+);
+
+/**
+ * @brief ``ac_sort_segments`` for ``int`` elements in ascending order.
+ *
+ * Segments of up to ``AC_SORT_SMALL_MAX_INT`` elements use the sorting
+ * networks of ``small_sort.h``, longer ones ``ac_quick_sort_int``.
+ *
+ * @signature int ac_sort_segments_int(int *data, const size_t *offsets,
+ *                                     size_t num_segments, size_t threads)
+ */
+int ac_sort_segments_int(
+    int *data,
+    const size_t *offsets,
+    size_t num_segments,
+    size_t threads
+);
+
+/**
+ * @brief ``ac_sort_segments`` for ``double`` elements in ascending order.
+ *
+ * Segments of up to ``AC_SORT_SMALL_MAX_DOUBLE`` elements use the sorting
+ * networks of ``small_sort.h``, longer ones ``ac_quick_sort_double``.  NaNs
+ * have no defined position, as with those functions.
+ *
+ * @signature int ac_sort_segments_double(double *data, const size_t *offsets,
+ *                                        size_t num_segments, size_t threads)
+ */
+int ac_sort_segments_double(
+    double *data,
+    const size_t *offsets,
+    size_t num_segments,
+    size_t threads
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_SMALL_SORT_H
+#define ALGORITHMS_C_ALGORITHMS_SMALL_SORT_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file small_sort.h
+ * @brief Sorting networks for short ``int``, ``float`` and ``double`` arrays.
+ *
+ * Short inputs are padded to the next power of two and run through a bitonic
+ * sorting network.  Every compare-exchange is branch-free, so the running
+ * time does not depend on the input order.  On x86-64 builds with GCC or Clang
+ * a vectorized AVX2 network (eight ``int``/``float`` or four ``double`` lanes
+ * per register) is selected at runtime when the CPU supports it; otherwise a
+ * portable scalar network is used.  Both order values identically, except that
+ * the relative placement of ``-0.0`` and ``+0.0`` may differ.
+ *
+ * The typed introsort kernels from ``typed_sort.h`` use these functions as
+ * their base case for the three supported element types.  The networks are
+ * not stable, so the typed merge sort kernels keep insertion sort instead.
+ */
+
+/** Largest ``size`` handled by the ``int`` network. */
+#define AC_SORT_SMALL_MAX_INT 32U
+
+/** Largest ``size`` handled by the ``float`` network. */
+#define AC_SORT_SMALL_MAX_FLOAT 32U
+
+/** Largest ``size`` handled by the ``double`` network. */
+#define AC_SORT_SMALL_MAX_DOUBLE 16U
+
+/**
+ * @brief Sort up to ``AC_SORT_SMALL_MAX_INT`` integers with a sorting network.
+ *
+ * Larger inputs are forwarded to ``ac_quick_sort_int``.  The vector kernel
+ * requires 32-bit ``int``; other platforms always use the scalar network.
+ *
+ * @param data Array to sort ascending; ``NULL`` is ignored.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_sort_small_int(int *data, size_t size)
+ */
+void ac_sort_small_int(int *data, size_t size);
+
+/**
+ * @brief Sort up to ``AC_SORT_SMALL_MAX_FLOAT`` floats with a sorting network.
+ *
+ * NaN values are moved to the end first and the remaining values are sorted
+ * ascending.  Every input bit pattern is preserved, including the sign of
+ * zeros.  Larger inputs are forwarded to ``ac_quick_sort_float``.
+ *
+ * @param data Array to sort ascending; ``NULL`` is ignored.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_sort_small_float(float *data, size_t size)
+ */
+void ac_sort_small_float(float *data, size_t size);
+
+/**
+ * @brief Sort up to ``AC_SORT_SMALL_MAX_DOUBLE`` doubles with a sorting
+ *        network.
+ *
+ * Same NaN and signed-zero treatment as ``ac_sort_small_float``.  Larger
+ * inputs are forwarded to ``ac_quick_sort_double``.
+ *
+ * @param data Array to sort ascending; ``NULL`` is ignored.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_sort_small_double(double *data, size_t size)
+ */
+void ac_sort_small_double(double *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_SORT_AUTO_H
+#define ALGORITHMS_C_ALGORITHMS_SORT_AUTO_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file sort_auto.h
+ * @brief Sort front-ends that inspect the input and pick the engine.
+ *
+ * Choosing among the sorts of ``sorting.h`` requires knowing the input.  The
+ * functions below measure it first and route to the engine that wins for
+ * that shape in ``algorithms_c_sort_bench``:
+ *
+ * - short inputs go to insertion sort or a sorting network;
+ * - inputs that are already sorted are left alone;
+ * - integer keys whose range is at most the input size go to counting sort;
+ * - inputs made of few ascending or descending runs go to the adaptive merge
+ *   sort (``ac_tim_sort``); from the radix size on, only one or two runs do;
+ * - ``double`` samples with few distinct values go to the introsort, whose
+ *   three-way partition finishes equal keys in one pass;
+ * - large typed inputs go to LSD radix sort, the rest to introsort.
+ *
+ * The typed variants scan the whole input once for the run count and, for
+ * integers, the exact key range.  The generic variant cannot afford that many
+ * comparator calls and compares short windows spread over the input instead.
+ * None of the variants is stable.
+ */
+
+/** Engine chosen by an ``ac_sort_auto`` call. */
+typedef enum {
+    /** Fewer than two elements, or the input was already sorted. */
+    AC_SORT_ENGINE_NONE,
+    /** Binary insertion sort (``ac_binary_insertion_sort``). */
+    AC_SORT_ENGINE_INSERTION,
+    /** Sorting network from ``small_sort.h``. */
+    AC_SORT_ENGINE_NETWORK,
+    /** Counting sort (``ac_counting_sort_int``). */
+    AC_SORT_ENGINE_COUNTING,
+    /** LSD radix sort (``ac_radix_sort_int32``, ``ac_radix_sort_double``). */
+    AC_SORT_ENGINE_RADIX,
+    /** Adaptive merge sort (``ac_tim_sort``). */
+    AC_SORT_ENGINE_ADAPTIVE_MERGE,
+    /** Introsort (``ac_quick_sort`` or a typed ``ac_quick_sort_*``). */
+    AC_SORT_ENGINE_INTROSORT,
+} ac_sort_engine;
+
+/**
+ * @brief Short lowercase name of ``engine`` for logs, e.g. ``"radix"``.
+ *
+ * @return A static string; ``"unknown"`` for values outside the enum.
+ * @signature const char *ac_sort_engine_name(ac_sort_engine engine)
+ */
+const char *ac_sort_engine_name(ac_sort_engine engine);
+
+/**
+ * @brief Sort ``data`` with the engine that suits its sampled shape.
+ *
+ * Up to 32 windows of 9 adjacent elements spread over the input are compared
+ * to estimate how presorted it is.  When at least three windows in four are
+ * monotone the input goes to ``ac_tim_sort``, otherwise to ``ac_quick_sort``.
+ *
+ * @param data Array to sort.
+ * @param size Number of elements in ``data``.
+ * @param element_size Size in bytes of each element.
+ * @param compare Comparator defining the order.
+ * @param engine Optional output receiving the engine that sorted ``data``.
+ * @return ``0`` on success or ``-EINVAL`` when ``compare`` is ``NULL``,
+ *         ``element_size`` is zero or ``data`` is ``NULL`` with a non-zero
+ *         ``size``.
+ * @signature int ac_sort_auto(void *data, size_t size, size_t element_size,
+ *                             ac_compare_fn compare, ac_sort_engine *engine)
+ */
+int ac_sort_auto(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    ac_sort_engine *engine
+);
+
+/**
+ * @brief ``ac_sort_auto`` for ``int`` arrays.
+ *
+ * One pass finds the minimum, the maximum and the number of descents.  The
+ * radix engine requires 32-bit ``int``; elsewhere large inputs use the typed
+ * introsort.
+ *
+ * @return ``0`` on success or ``-EINVAL`` when ``data`` is ``NULL`` with a
+ *         non-zero ``size``.
+ * @signature int ac_sort_auto_int(int *data, size_t size,
+ *                                 ac_sort_engine *engine)
+ */
+int ac_sort_auto_int(int *data, size_t size, ac_sort_engine *engine);
+
+/**
+ * @brief ``ac_sort_auto`` for ``double`` arrays.
+ *
+ * Inputs containing NaN always go to ``ac_radix_sort_double``, since ``<``
+ * does not order them and only the radix total order gives NaNs a defined
+ * place.
+ *
+ * @return ``0`` on success or ``-EINVAL`` when ``data`` is ``NULL`` with a
+ *         non-zero ``size``.
+ * @signature int ac_sort_auto_double(double *data, size_t size,
+ *                                    ac_sort_engine *engine)
+ */
+int ac_sort_auto_double(double *data, size_t size, ac_sort_engine *engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,494 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_SORT_KERNELS_H
+#define ALGORITHMS_C_ALGORITHMS_SORT_KERNELS_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file sort_kernels.h
+ * @brief Compile-time generator for type-specialized sort kernels.
+ *
+ * The generic helpers in ``sorting.h`` move elements with
+ * ``memcpy(..., element_size)`` and reach the ordering through an
+ * ``ac_compare_fn`` pointer on every comparison.  For scalar keys both costs
+ * dominate the actual work.  The macros below stamp out the same algorithms
+ * for one concrete element type with the comparison written inline, so the
+ * compiler sees plain loads, stores and ``<``.
+ *
+ * ``AC_DEFINE_SORT_KERNELS(scope, suffix, type, less)`` defines six entry
+ * points (``scope`` is empty for external linkage or ``static``):
+ *
+ * - ``ac_insertion_sort_<suffix>(type *data, size_t size)`` - stable;
+ * - ``ac_binary_insertion_sort_<suffix>(type *data, size_t size)`` - stable,
+ *   upper-bound search plus one ``memmove`` per misplaced element;
+ * - ``ac_shell_sort_<suffix>(type *data, size_t size)`` - in place, over
+ *   ``AC_SORT_KERNEL_SHELL_GAPS``;
+ * - ``ac_heap_sort_<suffix>(type *data, size_t size)`` - in place;
+ * - ``ac_quick_sort_<suffix>(type *data, size_t size)`` - introsort with the
+ *   same pivot, three-way partition and depth-limit policy as
+ *   ``ac_quick_sort``;
+ * - ``ac_merge_sort_<suffix>(type *data, size_t size)`` - stable top-down
+ *   merge sort that ping-pongs between ``data`` and one buffer instead of
+ *   copying back after every merge.  If the buffer cannot be allocated it
+ *   merges in place by rotations instead, still stably.
+ *
+ * ``less(a, b)`` receives two values (not pointers) and must implement a
+ * strict weak ordering.  Every loop is bounds-checked, so an inconsistent
+ * ordering such as ``<`` over NaNs yields an unspecified permutation but never
+ * touches memory outside ``data``.
+ *
+ * The library instantiates the family for the standard integer and floating
+ * types in ``typed_sort.c`` and declares them in ``typed_sort.h``; callers may
+ * instantiate their own element types the same way.
+ */
+
+/** Ranges at or below this size are finished by insertion sort. */
+#define AC_SORT_KERNEL_INSERTION_THRESHOLD 16U
+
+/** Ranges above this size pick the introsort pivot with Tukey's ninther. */
+#define AC_SORT_KERNEL_NINTHER_THRESHOLD 128U
+
+/**
+ * Shell sort gaps in ascending order: Ciura's experimentally tuned sequence
+ * up to 1750, then extended by Tokuda's growth factor of 2.25.  Arrays larger
+ * than the last gap simply start from it.
+ */
+#define AC_SORT_KERNEL_SHELL_GAPS                                              \
+    1U, 4U, 10U, 23U, 57U, 132U, 301U, 701U, 1750U, 3937U, 8858U, 19930U,      \
+        44842U, 100894U, 227011U, 510774U, 1149241U, 2585792U, 5818032U,       \
+        13090572U, 29453787U, 66271020U, 149109795U, 335497038U, 754868335U,   \
+        1698453753U, 3821520944U
+
+/**
+ * @brief Declare the kernels generated by ``AC_DEFINE_SORT_KERNELS``.
+ *
+ * @signature AC_DECLARE_SORT_KERNELS(suffix, type)
+ */
+#define AC_DECLARE_SORT_KERNELS(suffix, type)                        \
+    void ac_insertion_sort_##suffix(type *data, size_t size);        \
+    void ac_binary_insertion_sort_##suffix(type *data, size_t size); \
+    void ac_shell_sort_##suffix(type *data, size_t size);            \
+    void ac_heap_sort_##suffix(type *data, size_t size);             \
+    void ac_quick_sort_##suffix(type *data, size_t size);            \
+    void ac_merge_sort_##suffix(type *data, size_t size)
+
+/**
+ * @brief Define the insertion, Shell, heap, quick and merge sort kernels.
+ *
+ * Ranges of at most ``AC_SORT_KERNEL_INSERTION_THRESHOLD`` elements are
+ * finished by the generated insertion sort.
+ *
+ * @signature AC_DEFINE_SORT_KERNELS(scope, suffix, type, less)
+ */
+#define AC_DEFINE_SORT_KERNELS(scope, suffix, type, less)                      \
+    AC_DEFINE_SORT_KERNELS_WITH_LEAF(                                          \
+        scope, suffix, type, less, ac_sk_##suffix##_insertion,                 \
+        AC_SORT_KERNEL_INSERTION_THRESHOLD                                     \
+    )
+
+/**
+ * @brief Like ``AC_DEFINE_SORT_KERNELS`` with a custom base case.
+ *
+ * The introsort kernel hands every range of at most ``leaf_size`` elements
+ * to ``leaf(type *data, size_t size)`` instead of insertion sort, for example
+ * a sorting network from ``small_sort.h``.  ``leaf`` must sort ascending
+ * under ``less`` but need not be stable: the merge kernel keeps finishing
+ * short ranges with the generated insertion sort.
+ *
+ * @signature AC_DEFINE_SORT_KERNELS_WITH_LEAF(scope, suffix, type, less,
+ *                                             leaf, leaf_size)
+ */
+#define AC_DEFINE_SORT_KERNELS_WITH_LEAF(                                      \
+    scope, suffix, type, less, leaf, leaf_size                                 \
+)                                                                              \
+    static void ac_sk_##suffix##_insertion(type *data, size_t size) {          \
+        for (size_t i = 1; i < size; ++i) {                                    \
+            type current = data[i];                                            \
+            size_t j = i;                                                      \
+            while (j > 0 && less(current, data[j - 1U])) {                     \
+                data[j] = data[j - 1U];                                        \
+                --j;                                                           \
+            }                                                                  \
+            data[j] = current;                                                 \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static void ac_sk_##suffix##_binary_insertion(type *data, size_t size) {   \
+        for (size_t i = 1; i < size; ++i) {                                    \
+            type current = data[i];                                            \
+            if (!less(current, data[i - 1U])) {                                \
+                continue;                                                      \
+            }                                                                  \
+            size_t low = 0;                                                    \
+            size_t high = i - 1U;                                              \
+            while (low < high) {                                               \
+                size_t mid = low + ((high - low) / 2U);                        \
+                if (less(current, data[mid])) {                                \
+                    high = mid;                                                \
+                } else {                                                       \
+                    low = mid + 1U;                                            \
+                }                                                              \
+            }                                                                  \
+            memmove(data + low + 1U, data + low, (i - low) * sizeof(type));    \
+            data[low] = current;                                               \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static void ac_sk_##suffix##_shell(type *data, size_t size) {              \
+        static const size_t gaps[] = {AC_SORT_KERNEL_SHELL_GAPS};              \
+        size_t g = sizeof(gaps) / sizeof(gaps[0]);                             \
+        while (g > 1U && gaps[g - 1U] >= size) {                               \
+            --g;                                                               \
+        }                                                                      \
+        while (g-- > 0) {                                                      \
+            size_t gap = gaps[g];                                              \
+            for (size_t i = gap; i < size; ++i) {                              \
+                type current = data[i];                                        \
+                size_t j = i;                                                  \
+                while (j >= gap && less(current, data[j - gap])) {             \
+                    data[j] = data[j - gap];                                   \
+                    j -= gap;                                                  \
+                }                                                              \
+                data[j] = current;                                             \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static void ac_sk_##suffix##_sift_down(                                    \
+        type *data, size_t root, size_t size                                   \
+    ) {                                                                        \
+        type value = data[root];                                               \
+        for (;;) {                                                             \
+            size_t child = (2U * root) + 1U;                                   \
+            if (child >= size) {                                               \
+                break;                                                         \
+            }                                                                  \
+            if (child + 1U < size && less(data[child], data[child + 1U])) {    \
+                ++child;                                                       \
+            }                                                                  \
+            if (!less(value, data[child])) {                                   \
+                break;                                                         \
+            }                                                                  \
+            data[root] = data[child];                                          \
+            root = child;                                                      \
+        }                                                                      \
+        data[root] = value;                                                    \
+    }                                                                          \
+                                                                               \
+    /* Bottom-up sift of ``value`` into the hole at slot zero: walk the */     \
+    /* hole to a leaf along the larger children, then let ``value`` climb. */  \
+    static void ac_sk_##suffix##_sift_from_leaf(                               \
+        type *data, size_t size, type value                                    \
+    ) {                                                                        \
+        size_t hole = 0;                                                       \
+        size_t child = 2U;                                                     \
+        for (; child < size; child = (2U * hole) + 2U) {                       \
+            child -= less(data[child], data[child - 1U]) ? 1U : 0U;            \
+            data[hole] = data[child];                                          \
+            hole = child;                                                      \
+        }                                                                      \
+        if (child == size) {                                                   \
+            data[hole] = data[size - 1U];                                      \
+            hole = size - 1U;                                                  \
+        }                                                                      \
+        while (hole > 0) {                                                     \
+            size_t parent = (hole - 1U) / 2U;                                  \
+            if (!less(data[parent], value)) {                                  \
+                break;                                                         \
+            }                                                                  \
+            data[hole] = data[parent];                                         \
+            hole = parent;                                                     \
+        }                                                                      \
+        data[hole] = value;                                                    \
+    }                                                                          \
+                                                                               \
+    static void ac_sk_##suffix##_heap(type *data, size_t size) {               \
+        for (size_t root = size / 2U; root > 0; --root) {                      \
+            ac_sk_##suffix##_sift_down(data, root - 1U, size);                 \
+        }                                                                      \
+        for (size_t end = size - 1U; end > 0; --end) {                         \
+            type value = data[end];                                            \
+            data[end] = data[0];                                               \
+            ac_sk_##suffix##_sift_from_leaf(data, end, value);                 \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static size_t ac_sk_##suffix##_median3(                                    \
+        const type *data, size_t a, size_t b, size_t c                         \
+    ) {                                                                        \
+        if (less(data[a], data[b])) {                                          \
+            if (less(data[b], data[c])) {                                      \
+                return b;                                                      \
+            }                                                                  \
+            return less(data[a], data[c]) ? c : a;                             \
+        }                                                                      \
+        if (less(data[a], data[c])) {                                          \
+            return a;                                                          \
+        }                                                                      \
+        return less(data[b], data[c]) ? c : b;                                 \
+    }                                                                          \
+                                                                               \
+    static size_t ac_sk_##suffix##_pivot(const type *data, size_t size) {      \
+        size_t last = size - 1U;                                               \
+        size_t mid = size / 2U;                                                \
+        if (size <= AC_SORT_KERNEL_NINTHER_THRESHOLD) {                        \
+            return ac_sk_##suffix##_median3(data, 0U, mid, last);              \
+        }                                                                      \
+        size_t step = size / 8U;                                               \
+        return ac_sk_##suffix##_median3(                                       \
+            data, ac_sk_##suffix##_median3(data, 0U, step, 2U * step),         \
+            ac_sk_##suffix##_median3(data, mid - step, mid, mid + step),       \
+            ac_sk_##suffix##_median3(                                          \
+                data, last - (2U * step), last - step, last                    \
+            )                                                                  \
+        );                                                                     \
+    }                                                                          \
+                                                                               \
+    static void ac_sk_##suffix##_introsort(                                    \
+        type *data, size_t size, size_t depth_limit                            \
+    ) {                                                                        \
+        while (size > (leaf_size)) {                                           \
+            if (depth_limit == 0) {                                            \
+                ac_sk_##suffix##_heap(data, size);                             \
+                return;                                                        \
+            }                                                                  \
+            --depth_limit;                                                     \
+                                                                               \
+            size_t chosen = ac_sk_##suffix##_pivot(data, size);                \
+            type pivot = data[chosen];                                         \
+            data[chosen] = data[0];                                            \
+            data[0] = pivot;                                                   \
+                                                                               \
+            /* Bentley-McIlroy: [0,a) == p, [a,b) < p, (c,d] > p,              \
+             * (d,size) == p. */                                               \
+            size_t a = 1U;                                                     \
+            size_t b = 1U;                                                     \
+            size_t c = size - 1U;                                              \
+            size_t d = size - 1U;                                              \
+            for (;;) {                                                         \
+                while (b <= c && !less(pivot, data[b])) {                      \
+                    if (!less(data[b], pivot)) {                               \
+                        type tmp = data[a];                                    \
+                        data[a++] = data[b];                                   \
+                        data[b] = tmp;                                         \
+                    }                                                          \
+                    ++b;                                                       \
+                }                                                              \
+                while (b <= c && !less(data[c], pivot)) {                      \
+                    if (!less(pivot, data[c])) {                               \
+                        type tmp = data[d];                                    \
+                        data[d--] = data[c];                                   \
+                        data[c] = tmp;                                         \
+                    }                                                          \
+                    --c;                                                       \
+                }                                                              \
+                if (b > c) {                                                   \
+                    break;                                                     \
+                }                                                              \
+                type tmp = data[b];                                            \
+                data[b++] = data[c];                                           \
+                data[c--] = tmp;                                               \
+            }                                                                  \
+                                                                               \
+            size_t less_count = b - a;                                         \
+            size_t greater_count = d - c;                                      \
+            size_t count = a < less_count ? a : less_count;                    \
+            for (size_t i = 0; i < count; ++i) {                               \
+                type tmp = data[i];                                            \
+                data[i] = data[b - count + i];                                 \
+                data[b - count + i] = tmp;                                     \
+            }                                                                  \
+            count = greater_count < (size - 1U - d) ? greater_count            \
+                                                    : (size - 1U - d);         \
+            for (size_t i = 0; i < count; ++i) {                               \
+                type tmp = data[b + i];                                        \
+                data[b + i] = data[size - count + i];                          \
+                data[size - count + i] = tmp;                                  \
+            }                                                                  \
+                                                                               \
+            type *upper = data + (size - greater_count);                       \
+            if (less_count < greater_count) {                                  \
+                ac_sk_##suffix##_introsort(data, less_count, depth_limit);     \
+                data = upper;                                                  \
+                size = greater_count;                                          \
+            } else {                                                           \
+                ac_sk_##suffix##_introsort(                                    \
+                    upper, greater_count, depth_limit                          \
+                );                                                             \
+                size = less_count;                                             \
+            }                                                                  \
+        }                                                                      \
+        leaf(data, size);                                                      \
+    }                                                                          \
+                                                                               \
+    /* Sort ``src`` into ``dst``; both must hold the same values on entry. */  \
+    static void ac_sk_##suffix##_merge_into(                                   \
+        type *src, type *dst, size_t size                                      \
+    ) {                                                                        \
+        if (size <= AC_SORT_KERNEL_INSERTION_THRESHOLD) {                      \
+            ac_sk_##suffix##_insertion(dst, size);                             \
+            return;                                                            \
+        }                                                                      \
+        size_t mid = size / 2U;                                                \
+        ac_sk_##suffix##_merge_into(dst, src, mid);                            \
+        ac_sk_##suffix##_merge_into(dst + mid, src + mid, size - mid);         \
+        size_t i = 0;                                                          \
+        size_t j = mid;                                                        \
+        size_t k = 0;                                                          \
+        while (i < mid && j < size) {                                          \
+            if (less(src[j], src[i])) {                                        \
+                dst[k++] = src[j++];                                           \
+            } else {                                                           \
+                dst[k++] = src[i++];                                           \
+            }                                                                  \
+        }                                                                      \
+        while (i < mid) {                                                      \
+            dst[k++] = src[i++];                                               \
+        }                                                                      \
+        while (j < size) {                                                     \
+            dst[k++] = src[j++];                                               \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static void ac_sk_##suffix##_reverse(type *data, size_t size) {            \
+        for (size_t i = 0, j = size; i + 1U < j; ++i) {                        \
+            --j;                                                               \
+            type tmp = data[i];                                                \
+            data[i] = data[j];                                                 \
+            data[j] = tmp;                                                     \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Stable merge of the sorted runs [0, left) and [left, left + right) */   \
+    /* without a buffer: split the longer run in half, find the matching */    \
+    /* cut in the other one, rotate the middle and recurse on both sides. */   \
+    static void ac_sk_##suffix##_merge_in_place(                               \
+        type *data, size_t left, size_t right                                  \
+    ) {                                                                        \
+        while (left != 0 && right != 0) {                                      \
+            if (left + right == 2U) {                                          \
+                if (less(data[1], data[0])) {                                  \
+                    type tmp = data[0];                                        \
+                    data[0] = data[1];                                         \
+                    data[1] = tmp;                                             \
+                }                                                              \
+                return;                                                        \
+            }                                                                  \
+            size_t cut_left;                                                   \
+            size_t cut_right;                                                  \
+            if (left > right) {                                                \
+                cut_left = left / 2U;                                          \
+                size_t low = 0;                                                \
+                size_t high = right;                                           \
+                while (low < high) {                                           \
+                    size_t mid = low + ((high - low) / 2U);                    \
+                    if (less(data[left + mid], data[cut_left])) {              \
+                        low = mid + 1U;                                        \
+                    } else {                                                   \
+                        high = mid;                                            \
+                    }                                                          \
+                }                                                              \
+                cut_right = low;                                               \
+            } else {                                                           \
+                cut_right = right / 2U;                                        \
+                size_t low = 0;                                                \
+                size_t high = left;                                            \
+                while (low < high) {                                           \
+                    size_t mid = low + ((high - low) / 2U);                    \
+                    if (less(data[left + cut_right], data[mid])) {             \
+                        high = mid;                                            \
+                    } else {                                                   \
+                        low = mid + 1U;                                        \
+                    }                                                          \
+                }                                                              \
+                cut_left = low;                                                \
+            }                                                                  \
+            ac_sk_##suffix##_reverse(data + cut_left, left - cut_left);        \
+            ac_sk_##suffix##_reverse(data + left, cut_right);                  \
+            ac_sk_##suffix##_reverse(                                          \
+                data + cut_left, left - cut_left + cut_right                   \
+            );                                                                 \
+            size_t split = cut_left + cut_right;                               \
+            ac_sk_##suffix##_merge_in_place(data, cut_left, cut_right);        \
+            data += split;                                                     \
+            left -= cut_left;                                                  \
+            right -= cut_right;                                                \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Stable sort without heap memory, for when the merge buffer cannot */    \
+    /* be allocated: insertion-sorted blocks merged bottom-up in place. */     \
+    static void ac_sk_##suffix##_merge_sort_in_place(                          \
+        type *data, size_t size                                                \
+    ) {                                                                        \
+        size_t width = AC_SORT_KERNEL_INSERTION_THRESHOLD;                     \
+        for (size_t start = 0; start < size; start += width) {                 \
+            size_t block = size - start < width ? size - start : width;        \
+            ac_sk_##suffix##_insertion(data + start, block);                   \
+        }                                                                      \
+        for (; width < size; width *= 2U) {                                    \
+            for (size_t start = 0; start + width < size;                       \
+                 start += 2U * width) {                                        \
+                size_t right = size - start - width;                           \
+                ac_sk_##suffix##_merge_in_place(                               \
+                    data + start, width, right < width ? right : width         \
+                );                                                             \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    scope void ac_insertion_sort_##suffix(type *data, size_t size) {           \
+        if (data == NULL || size < 2U) {                                       \
+            return;                                                            \
+        }                                                                      \
+        ac_sk_##suffix##_insertion(data, size);                                \
+    }                                                                          \
+                                                                               \
+    scope void ac_binary_insertion_sort_##suffix(type *data, size_t size) {    \
+        if (data == NULL || size < 2U) {                                       \
+            return;                                                            \
+        }                                                                      \
+        ac_sk_##suffix##_binary_insertion(data, size);                         \
+    }                                                                          \
+                                                                               \
+    scope void ac_shell_sort_##suffix(type *data, size_t size) {               \
+        if (data == NULL || size < 2U) {                                       \
+            return;                                                            \
+        }                                                                      \
+        ac_sk_##suffix##_shell(data, size);                                    \
+    }                                                                          \
+                                                                               \
+    scope void ac_heap_sort_##suffix(type *data, size_t size) {                \
+        if (data == NULL || size < 2U) {                                       \
+            return;                                                            \
+        }                                                                      \
+        ac_sk_##suffix##_heap(data, size);                                     \
+    }                                                                          \
+                                                                               \
+    scope void ac_quick_sort_##suffix(type *data, size_t size) {               \
+        if (data == NULL || size < 2U) {                                       \
+            return;                                                            \
+        }                                                                      \
+        size_t depth_limit = 0;                                                \
+        for (size_t n = size; n > 1U; n >>= 1U) {                              \
+            depth_limit += 2U;                                                 \
+        }                                                                      \
+        ac_sk_##suffix##_introsort(data, size, depth_limit);                   \
+    }                                                                          \
+                                                                               \
+    scope void ac_merge_sort_##suffix(type *data, size_t size) {               \
+        if (data == NULL || size < 2U) {                                       \
+            return;                                                            \
+        }                                                                      \
+        type *buffer = (type *)malloc(size * sizeof(type));                    \
+        if (buffer == NULL) {                                                  \
+            ac_sk_##suffix##_merge_sort_in_place(data, size);                  \
+            return;                                                            \
+        }                                                                      \
+        memcpy(buffer, data, size * sizeof(type));                             \
+        ac_sk_##suffix##_merge_into(buffer, data, size);                       \
+        free(buffer);                                                          \
+    }
+
+#endif
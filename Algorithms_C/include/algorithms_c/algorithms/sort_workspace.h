@@ -0,0 +1,277 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_SORT_WORKSPACE_H
+#define ALGORITHMS_C_ALGORITHMS_SORT_WORKSPACE_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file sort_workspace.h
+ * @brief Caller-owned scratch memory for allocation-free sorting.
+ *
+ * The generic sorts in ``sorting.h`` obtain their scratch space from
+ * ``malloc`` on every call and quietly do nothing when that fails.  The
+ * ``*_ws`` variants declared here take the scratch space from an
+ * ``ac_sort_workspace`` instead.  A workspace is sized once, for example with
+ * ``ac_sort_workspace_bytes``, and can then be reused by any number of calls;
+ * the variants never call the allocator and report problems through their
+ * return value:
+ *
+ * - ``0`` on success;
+ * - ``-EINVAL`` when a pointer is ``NULL`` (with a non-zero ``size``), the
+ *   element size is zero or the comparator is missing;
+ * - ``-ENOSPC`` when the workspace is too small for the request, in which
+ *   case the data is left untouched.
+ *
+ * A workspace is not synchronised; concurrent calls need one workspace each.
+ */
+
+/**
+ * @struct ac_sort_workspace
+ * @brief Block of scratch memory shared by the ``*_ws`` functions.
+ */
+typedef struct {
+    /** Start of the scratch memory. */
+    unsigned char *memory;
+    /** Size of ``memory`` in bytes. */
+    size_t capacity;
+    /** Non-zero when ``memory`` was allocated by ``ac_sort_workspace_init``. */
+    int owns_memory;
+} ac_sort_workspace;
+
+/**
+ * @brief Bytes of workspace that every ``*_ws`` sort in this header needs to
+ *        sort up to ``max_size`` elements of ``element_size`` bytes.
+ *
+ * Merge sort is the most demanding variant and needs ``max_size`` elements;
+ * the remaining sorts need a single element.  Returns ``SIZE_MAX`` when the
+ * product overflows.
+ *
+ * @signature size_t ac_sort_workspace_bytes(size_t max_size,
+ *                                          size_t element_size)
+ */
+size_t ac_sort_workspace_bytes(size_t max_size, size_t element_size);
+
+/**
+ * @brief Allocate a workspace of ``capacity`` bytes.
+ *
+ * This is the only function of the module that allocates; release the memory
+ * with ``ac_sort_workspace_destroy``.
+ *
+ * @param workspace Workspace to initialise.
+ * @param capacity Size of the scratch block in bytes; may be zero.
+ * @return ``0`` on success, ``-EINVAL`` when ``workspace`` is ``NULL`` or
+ *         ``-ENOMEM`` when the allocation fails.
+ * @signature int ac_sort_workspace_init(ac_sort_workspace *workspace,
+ *                                       size_t capacity)
+ */
+int ac_sort_workspace_init(ac_sort_workspace *workspace, size_t capacity);
+
+/**
+ * @brief Wrap caller-provided memory, e.g. a static or stack buffer.
+ *
+ * The workspace borrows ``memory``; ``ac_sort_workspace_destroy`` will not
+ * free it.  Functions that store typed values in the workspace skip the few
+ * bytes needed to align them, so a buffer that is not suitably aligned is
+ * accepted but provides slightly less room.
+ *
+ * @param workspace Workspace to initialise.
+ * @param memory Scratch block; may be ``NULL`` only when ``capacity`` is zero.
+ * @param capacity Size of ``memory`` in bytes.
+ * @return ``0`` on success or ``-EINVAL`` for invalid arguments.
+ * @signature int ac_sort_workspace_init_buffer(ac_sort_workspace *workspace,
+ *                                              void *memory, size_t capacity)
+ */
+int ac_sort_workspace_init_buffer(
+    ac_sort_workspace *workspace,
+    void *memory,
+    size_t capacity
+);
+
+/**
+ * @brief Release memory owned by ``workspace`` and reset it to empty.
+ *
+ * @signature void ac_sort_workspace_destroy(ac_sort_workspace *workspace)
+ */
+void ac_sort_workspace_destroy(ac_sort_workspace *workspace);
+
+/**
+ * @brief Return ``count * element_size`` bytes of the workspace aligned to
+ *        ``alignment``, or ``NULL`` if the workspace is too small.
+ *
+ * Every call hands out the start of the same block; the helper exists so that
+ * code building on the workspace performs the overflow and alignment checks
+ * the same way as the functions in this library.
+ *
+ * @param workspace Workspace to carve from; ``NULL`` yields ``NULL``.
+ * @param count Number of elements required.
+ * @param element_size Size in bytes of each element.
+ * @param alignment Required alignment; must be a power of two.
+ * @signature void *ac_sort_workspace_reserve(
+ *     const ac_sort_workspace *workspace, size_t count, size_t element_size,
+ *     size_t alignment)
+ */
+void *ac_sort_workspace_reserve(
+    const ac_sort_workspace *workspace,
+    size_t count,
+    size_t element_size,
+    size_t alignment
+);
+
+/**
+ * @brief ``ac_insertion_sort`` using one element of workspace.
+ * @signature int ac_insertion_sort_ws(ac_sort_workspace *workspace,
+ *                                     void *data, size_t size,
+ *                                     size_t element_size,
+ *                                     ac_compare_fn compare)
+ */
+int ac_insertion_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_bubble_sort`` using one element of workspace.
+ * @signature int ac_bubble_sort_ws(ac_sort_workspace *workspace, void *data,
+ *                                  size_t size, size_t element_size,
+ *                                  ac_compare_fn compare)
+ */
+int ac_bubble_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_binary_insertion_sort`` using one element of workspace.
+ * @signature int ac_binary_insertion_sort_ws(ac_sort_workspace *workspace,
+ *                                            void *data, size_t size,
+ *                                            size_t element_size,
+ *                                            ac_compare_fn compare)
+ */
+int ac_binary_insertion_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_selection_sort`` using one element of workspace.
+ * @signature int ac_selection_sort_ws(ac_sort_workspace *workspace,
+ *                                     void *data, size_t size,
+ *                                     size_t element_size,
+ *                                     ac_compare_fn compare)
+ */
+int ac_selection_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_shell_sort`` using one element of workspace.
+ * @signature int ac_shell_sort_ws(ac_sort_workspace *workspace, void *data,
+ *                                 size_t size, size_t element_size,
+ *                                 ac_compare_fn compare)
+ */
+int ac_shell_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_comb_sort`` using one element of workspace.
+ * @signature int ac_comb_sort_ws(ac_sort_workspace *workspace, void *data,
+ *                                size_t size, size_t element_size,
+ *                                ac_compare_fn compare)
+ */
+int ac_comb_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_merge_sort`` using ``size`` elements of workspace.
+ * @signature int ac_merge_sort_ws(ac_sort_workspace *workspace, void *data,
+ *                                 size_t size, size_t element_size,
+ *                                 ac_compare_fn compare)
+ */
+int ac_merge_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_tim_sort`` using whatever workspace is available.
+ *
+ * One element is required.  Merges whose shorter run fits in the workspace
+ * use the linear galloping merge; larger ones fall back to the stable
+ * rotation merge instead of failing, so ``size / 2`` elements make every
+ * merge linear.
+ *
+ * @signature int ac_tim_sort_ws(ac_sort_workspace *workspace, void *data,
+ *                               size_t size, size_t element_size,
+ *                               ac_compare_fn compare)
+ */
+int ac_tim_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_quick_sort`` using one element of workspace.
+ * @signature int ac_quick_sort_ws(ac_sort_workspace *workspace, void *data,
+ *                                 size_t size, size_t element_size,
+ *                                 ac_compare_fn compare)
+ */
+int ac_quick_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_heap_sort`` using one element of workspace.
+ * @signature int ac_heap_sort_ws(ac_sort_workspace *workspace, void *data,
+ *                                size_t size, size_t element_size,
+ *                                ac_compare_fn compare)
+ */
+int ac_heap_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
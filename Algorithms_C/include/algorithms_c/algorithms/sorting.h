@@ -2,6 +2,7 @@
 #define ALGORITHMS_C_ALGORITHMS_SORTING_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include "algorithms_c/algorithms/binary_search.h"
 
 #ifdef __cplusplus
@@ -30,10 +31,35 @@ void ac_insertion_sort(
     ac_compare_fn compare
 );
 
+/**
+ * @brief Stable insertion sort that finds each slot by binary search.
+ *
+ * The slot is the upper bound of the element in the sorted prefix, so equal
+ * elements keep their relative order, and the tail is shifted with a single
+ * ``memmove``.  This takes O(n log n) comparator calls instead of O(n^2),
+ * while the moves stay quadratic.  An element already in order with its
+ * predecessor costs one comparison, which keeps appends to a sorted buffer
+ * cheap.  Elements up to 256 bytes need no allocation.  The typed kernels
+ * ``ac_binary_insertion_sort_int``, ``ac_binary_insertion_sort_double`` and
+ * friends live in ``typed_sort.h``.
+ *
+ * @signature void ac_binary_insertion_sort(void *data, size_t size,
+ *                                          size_t element_size,
+ *                                          ac_compare_fn compare)
+ */
+void ac_binary_insertion_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
 /**
  * @brief In-place insertion sort specialized for ``double`` arrays.
  *
- * Mirrors ``insert_sort`` from ``Algorithms_Python/insert_sort.py``.
+ * Mirrors ``insert_sort`` from ``Algorithms_Python/insert_sort.py``.  The
+ * body is generated by ``AC_DEFINE_SORT_KERNELS`` (see ``typed_sort.h``) so the
+ * comparison is an inlined ``<`` rather than a comparator call.
  *
  * @param data ``double`` array to sort in ascending order.
  * @param size Number of elements in ``data``.
@@ -65,7 +91,8 @@ size_t ac_bin_search_double(
  * @brief Optimized insertion sort for ``double`` arrays.
  *
  * Mirrors ``insert_sort_opt`` from ``Algorithms_Python/insert_sort.py`` by
- * using binary search to locate insertion positions before shifting elements.
+ * using binary search to locate insertion positions, then shifts the tail
+ * with one ``memmove``.
  *
  * @param data ``double`` array to sort in ascending order.
  * @param size Number of elements in ``data``.
@@ -113,8 +140,12 @@ void ac_selection_sort(
 /**
  * @brief Shell sort with shrinking-gap insertion passes.
  *
- * The helper mirrors the translated Python educational routine with a simple
- * gap sequence ``N/2, N/4, ..., 1``.
+ * Gaps follow ``AC_SORT_KERNEL_SHELL_GAPS`` (Ciura's sequence extended by a
+ * factor of 2.25), which avoids the quadratic worst case of the textbook
+ * ``N/2, N/4, ..., 1`` sequence.  4-, 8- and 16-byte elements move through
+ * fixed-width copies, and elements up to 256 bytes need no allocation.  The
+ * typed kernels ``ac_shell_sort_int``, ``ac_shell_sort_double`` and friends
+ * from ``typed_sort.h`` skip the comparator entirely.
  *
  * @signature void ac_shell_sort(void *data, size_t size,
  *                               size_t element_size,
@@ -147,6 +178,9 @@ void ac_comb_sort(
 /**
  * @brief Stable divide-and-conquer merge sort.
  *
+ * Allocates a ``size``-element buffer.  If that fails, the sort runs without
+ * it through ``ac_inplace_merge_sort``.
+ *
  * @signature void ac_merge_sort(void *data, size_t size, size_t element_size,
  *                               ac_compare_fn compare)
  */
@@ -157,6 +191,108 @@ void ac_merge_sort(
     ac_compare_fn compare
 );
 
+/**
+ * @brief Stable merge sort that never allocates.
+ *
+ * Sorted blocks are merged bottom-up.  A merge whose shorter run fits in a
+ * fixed 4 KiB stack buffer goes through the buffer.  Larger merges split
+ * recursively around block rotations (SymMerge).  That is O(n log n)
+ * comparisons and O(n log^2 n) moves in the worst case, with O(log n) stack
+ * and no heap memory.  Presorted runs cost one comparison per merge.
+ *
+ * @signature void ac_inplace_merge_sort(void *data, size_t size,
+ *                                       size_t element_size,
+ *                                       ac_compare_fn compare)
+ */
+void ac_inplace_merge_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief ``ac_inplace_merge_sort`` with a caller-provided scratch buffer.
+ *
+ * A buffer larger than the built-in 4 KiB lets more merges and rotations run
+ * in linear time.  A buffer that can hold half the input makes every merge
+ * linear.  Smaller buffers, or none, fall back to the built-in one.
+ *
+ * @param buffer Scratch memory; may be ``NULL`` when ``buffer_bytes`` is 0.
+ * @param buffer_bytes Size of ``buffer`` in bytes.
+ * @return ``0`` on success or ``-EINVAL`` for invalid arguments.
+ * @signature int ac_inplace_merge_sort_buffered(void *data, size_t size,
+ *                                               size_t element_size,
+ *                                               ac_compare_fn compare,
+ *                                               void *buffer,
+ *                                               size_t buffer_bytes)
+ */
+int ac_inplace_merge_sort_buffered(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    void *buffer,
+    size_t buffer_bytes
+);
+
+/**
+ * @brief Adaptive stable merge sort (TimSort).
+ *
+ * Detects natural ascending and strictly descending runs (reversing the
+ * latter), extends short runs to ``minrun`` with binary insertion sort and
+ * merges them under the TimSort stack invariants.  Merges first skip the
+ * prefix and suffix that are already in place, then use galloping to move
+ * whole blocks when one side keeps winning, and only ever buffer the shorter
+ * of the two runs (``min(left, right)`` elements).  Sorted, reversed and
+ * nearly sorted inputs finish in close to linear time.  If the scratch buffer
+ * cannot be grown, merges fall back to a slower in-place rotation merge.
+ *
+ * @param data Pointer to the array to sort.
+ * @param size Number of elements in ``data``.
+ * @param element_size Size in bytes of each element.
+ * @param compare Comparator defining the order.
+ * @signature void ac_tim_sort(void *data, size_t size, size_t element_size,
+ *                             ac_compare_fn compare)
+ */
+void ac_tim_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+/**
+ * @brief Multi-threaded stable merge sort.
+ *
+ * The input is split into a power-of-two number of chunks (at least 8192
+ * elements each) that are sorted concurrently; neighbouring runs are then
+ * merged level by level, with every merge cut into equal output slices by a
+ * co-ranked (merge-path) search so that even the final merge is shared by all
+ * threads.  Ties resolve exactly as in ``ac_merge_sort``, so the output is
+ * byte-for-byte identical to the serial stable sort for any thread count.
+ * Small inputs, ``threads == 1`` and allocation failures fall back to
+ * ``ac_merge_sort``.
+ *
+ * @param data Pointer to the array to sort.
+ * @param size Number of elements in ``data``.
+ * @param element_size Size in bytes of each element.
+ * @param compare Comparator defining the order; must be thread-safe.
+ * @param threads Maximum worker threads including the caller; ``0`` uses
+ *        every hardware thread.
+ * @signature void ac_merge_sort_parallel(void *data, size_t size,
+ *                                        size_t element_size,
+ *                                        ac_compare_fn compare,
+ *                                        size_t threads)
+ */
+void ac_merge_sort_parallel(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t threads
+);
+
 /**
  * @brief Merge two sorted ``double`` ranges into a destination buffer.
  *
@@ -181,10 +317,12 @@ void ac_merge_double_arrays(
 );
 
 /**
- * @brief Convenience merge-sort wrapper for ``double`` arrays.
+ * @brief Stable merge sort specialized for ``double`` arrays.
  *
  * Mirrors the common ``merge_sort`` numeric usage in
- * ``Algorithms_Python/merge_sort.py``.
+ * ``Algorithms_Python/merge_sort.py``.  Generated by
+ * ``AC_DEFINE_SORT_KERNELS`` (see ``typed_sort.h``): values are moved directly
+ * and compared with an inlined ``<``.
  *
  * @param data ``double`` array to sort in ascending order.
  * @param size Number of elements in ``data``.
@@ -193,7 +331,15 @@ void ac_merge_double_arrays(
 void ac_merge_sort_double(double *data, size_t size);
 
 /**
- * @brief In-place quick sort with recursive partitioning.
+ * @brief In-place introsort (quick sort with a heap-sort safety net).
+ *
+ * Pivots are chosen by median-of-three (Tukey's ninther on larger ranges) and
+ * each range is split three ways so keys equal to the pivot are settled in one
+ * pass.  The smaller side recurses while the larger side is looped on, short
+ * ranges are finished by insertion sort, and heap sort takes over once the
+ * recursion depth exceeds ``2 * log2(size)``.  Running time is therefore
+ * ``O(n log n)`` and stack usage ``O(log n)`` even for sorted, reversed or
+ * all-equal inputs.  The sort is not stable.
  *
  * @signature void ac_quick_sort(void *data, size_t size, size_t element_size,
  *                               ac_compare_fn compare)
@@ -206,10 +352,40 @@ void ac_quick_sort(
 );
 
 /**
- * @brief Convenience quick-sort wrapper for ``double`` arrays.
+ * @brief Multi-threaded unstable samplesort.
+ *
+ * An oversampled, sorted random sample selects up to 256 splitters that are
+ * stored as an implicit search tree.  Blocks of the input are classified
+ * concurrently by walking that tree without data-dependent branches, scattered
+ * once into per-bucket windows of a scratch buffer, and every bucket is then
+ * sorted independently with ``ac_quick_sort``.  Each element is moved only
+ * twice regardless of the thread count.  Inputs below 65536 elements,
+ * ``threads == 1`` and allocation failures fall back to ``ac_quick_sort``.
+ *
+ * @param data Pointer to the array to sort.
+ * @param size Number of elements in ``data``.
+ * @param element_size Size in bytes of each element.
+ * @param compare Comparator defining the order; must be thread-safe.
+ * @param threads Maximum worker threads including the caller; ``0`` uses
+ *        every hardware thread.
+ * @signature void ac_sample_sort(void *data, size_t size, size_t element_size,
+ *                                ac_compare_fn compare, size_t threads)
+ */
+void ac_sample_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t threads
+);
+
+/**
+ * @brief Introsort specialized for ``double`` arrays.
  *
  * Mirrors the common ``quick_sort`` usage pattern in
- * ``Algorithms_Python/quick_sort.py`` for numeric lists.
+ * ``Algorithms_Python/quick_sort.py`` for numeric lists.  Generated by
+ * ``AC_DEFINE_SORT_KERNELS`` (see ``typed_sort.h``) with the same policy as
+ * ``ac_quick_sort`` but an inlined ``<`` comparison.
  *
  * @param data ``double`` array to sort in ascending order.
  * @param size Number of elements in ``data``.
@@ -314,14 +490,16 @@ int ac_partition_small_double(
 );
 
 /**
- * @brief Heap sort implemented via the documented ``ac_heap`` container.
+ * @brief In-place heap sort.
  *
- * The helper mirrors the Python ``heap_sort`` routine: all elements are first
- * inserted into a min-heap and then extracted in ascending order back into the
- * original buffer. The comparator defines the ordering and must return a
- * negative value when the first argument is "less" than the second. When
- * inputs are invalid the function becomes a no-op, matching the defensive style
- * used across the translated sorting helpers.
+ * The Python ``heap_sort`` routine pushes every element into a min-heap and
+ * pops them back out in ascending order.  This version builds a max-heap
+ * directly inside ``data`` and swaps each maximum behind the shrinking heap,
+ * so no copy of the input is made; only elements wider than 256 bytes need a
+ * heap-allocated scratch slot.  The comparator defines the ordering and must
+ * return a negative value when the first argument is "less" than the second.
+ * When inputs are invalid the function becomes a no-op, matching the defensive
+ * style used across the translated sorting helpers.
  *
  * @param data Pointer to the array to sort; must not be ``NULL``.
  * @param size Number of elements contained in ``data``.
@@ -340,6 +518,8 @@ void ac_heap_sort(
 /**
  * @brief Counting sort specialised for integer arrays within known bounds.
  *
+ * Single-threaded ``ac_counting_sort_int_parallel``.
+ *
  * @param data Array of integers to sort in ascending order.
  * @param size Number of elements in ``data``.
  * @param min_value Minimum value expected in ``data``.
@@ -349,11 +529,43 @@ void ac_heap_sort(
  */
 void ac_counting_sort_int(int *data, size_t size, int min_value, int max_value);
 
+/**
+ * @brief Multi-threaded counting sort for integers within known bounds.
+ *
+ * Ranges of up to 2048 values are counted into four interleaved 32-bit
+ * sub-histograms, so long runs of one key do not serialise on a single
+ * counter.  Inputs of at least 262144 elements are counted in blocks with one
+ * histogram per block, the histograms are summed, and the output is written
+ * as one fill per distinct value, split across threads by output position.
+ * Ranges wider than both 2048 values and twice ``size`` are sorted with
+ * ``ac_digit_sort_opt_int`` instead, as are inputs whose histogram cannot be
+ * allocated.  Every value in ``data`` must lie within the bounds; swapped
+ * bounds are accepted.
+ *
+ * @param data Array of integers to sort in ascending order.
+ * @param size Number of elements in ``data``.
+ * @param min_value Minimum value expected in ``data``.
+ * @param max_value Maximum value expected in ``data``.
+ * @param threads Maximum worker threads including the caller; ``0`` uses
+ *        every hardware thread.
+ * @signature void ac_counting_sort_int_parallel(int *data, size_t size,
+ *                                               int min_value, int max_value,
+ *                                               size_t threads)
+ */
+void ac_counting_sort_int_parallel(
+    int *data,
+    size_t size,
+    int min_value,
+    int max_value,
+    size_t threads
+);
+
 /**
  * @brief Counting sort that infers min/max bounds from the input array.
  *
  * Mirrors ``Algorithms_Python/count_sort.py`` where bounds are computed from
- * the data before counting frequencies.
+ * the data before counting frequencies.  The bounds are then handed to
+ * ``ac_counting_sort_int_parallel`` with every hardware thread.
  *
  * @param data Array of integers to sort in ascending order.
  * @param size Number of elements in ``data``.
@@ -364,8 +576,11 @@ void ac_count_sort_int_auto(int *data, size_t size);
 /**
  * @brief Optimized radix-style digit sort for signed integer arrays.
  *
- * Mirrors ``digit_sort_opt`` from ``Algorithms_Python/digit_sort.py`` using
- * bucketed stable passes over each digit place.
+ * Mirrors ``digit_sort_opt`` from ``Algorithms_Python/digit_sort.py``.  Where
+ * ``int`` is 32 bits wide the call is served by ``ac_radix_sort_int32``, whose
+ * 11-bit shift-extracted digits replace the per-element division and modulo;
+ * ``base`` is then only validated.  Other platforms keep the bucketed
+ * decimal-style passes of ``ac_digit_sort_int``.
  *
  * @param data Array of integers to sort in ascending order.
  * @param size Number of elements in ``data``.
@@ -388,6 +603,77 @@ void ac_digit_sort_opt_int(int *data, size_t size, int base);
  */
 void ac_digit_sort_int(int *data, size_t size, int base);
 
+/**
+ * @brief LSD radix sort for ``uint32_t`` arrays.
+ *
+ * Keys are split into three 11-bit digits extracted with shifts.  A single
+ * read pass builds the histograms of every digit, digits shared by all keys
+ * are skipped, and the remaining passes scatter back and forth between
+ * ``data`` and one scratch buffer of ``size`` elements.  The sort is stable,
+ * runs in ``O(n)`` time, and leaves ``data`` untouched when the scratch buffer
+ * cannot be allocated.
+ *
+ * @param data Array to sort in ascending order.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_radix_sort_uint32(uint32_t *data, size_t size)
+ */
+void ac_radix_sort_uint32(uint32_t *data, size_t size);
+
+/**
+ * @brief LSD radix sort for ``int32_t`` arrays.
+ *
+ * Same engine as ``ac_radix_sort_uint32``; the sign bit is flipped while
+ * extracting digits so negative values order before positive ones.
+ *
+ * @param data Array to sort in ascending order.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_radix_sort_int32(int32_t *data, size_t size)
+ */
+void ac_radix_sort_int32(int32_t *data, size_t size);
+
+/**
+ * @brief LSD radix sort for IEEE-754 ``float`` arrays.
+ *
+ * Values are ordered by their bit patterns mapped to a total order:
+ * ``-NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN``.  Unlike a ``<``
+ * comparator this places ``-0.0`` before ``+0.0`` and gives NaNs a
+ * deterministic position at either end.
+ *
+ * @param data Array to sort in ascending order.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_radix_sort_float(float *data, size_t size)
+ */
+void ac_radix_sort_float(float *data, size_t size);
+
+/**
+ * @brief LSD radix sort for ``uint64_t`` arrays using six 11-bit digits.
+ *
+ * @param data Array to sort in ascending order.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_radix_sort_uint64(uint64_t *data, size_t size)
+ */
+void ac_radix_sort_uint64(uint64_t *data, size_t size);
+
+/**
+ * @brief LSD radix sort for ``int64_t`` arrays using six 11-bit digits.
+ *
+ * @param data Array to sort in ascending order.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_radix_sort_int64(int64_t *data, size_t size)
+ */
+void ac_radix_sort_int64(int64_t *data, size_t size);
+
+/**
+ * @brief LSD radix sort for IEEE-754 ``double`` arrays.
+ *
+ * Uses the same total order as ``ac_radix_sort_float``.
+ *
+ * @param data Array to sort in ascending order.
+ * @param size Number of elements in ``data``.
+ * @signature void ac_radix_sort_double(double *data, size_t size)
+ */
+void ac_radix_sort_double(double *data, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,6 +2,7 @@
 #define ALGORITHMS_C_ALGORITHMS_SPLIT_FIND_H
 
 #include <stddef.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -10,12 +11,13 @@ extern "C" {
 /**
  * @brief Select the element that would appear at a given index after sorting.
  *
- * The helper mirrors the Python ``split_find`` routine: it walks the array
- * using a randomized pivot and partial partitioning so that only the necessary
- * region is explored.  The function never fully sorts the data, which keeps it
- * a lightweight building block when you only need the k-th order statistic.
- * Invalid inputs are rejected defensively to keep undefined behaviour out of
- * the educational translation.
+ * The helper mirrors the Python ``split_find`` routine: it partially
+ * partitions the array so that only the region containing ``index`` is
+ * explored.  The work is delegated to ``ac_nth_element``, so values are
+ * compared exactly, no global random state is used and the running time is
+ * linear even in the worst case.  On return ``array`` is partitioned around
+ * ``index``.  Invalid inputs are rejected defensively to keep undefined
+ * behaviour out of the educational translation.
  *
  * @param array Pointer to the buffer of ``double`` values to inspect; must not
  *     be ``NULL``.
@@ -31,6 +33,44 @@ extern "C" {
  */
 int ac_split_find(double *array, size_t size, size_t index, double *out_value);
 
+/**
+ * @brief Workspace bytes needed by ``ac_split_find_ws`` for ``size`` values.
+ *
+ * Includes the slack needed to align the copy; returns ``SIZE_MAX`` on
+ * overflow.
+ *
+ * @signature size_t ac_split_find_workspace_bytes(size_t size)
+ */
+size_t ac_split_find_workspace_bytes(size_t size);
+
+/**
+ * @brief Select the ``index``-th smallest value without modifying ``array``.
+ *
+ * ``ac_split_find`` partitions the caller's buffer in place, so callers that
+ * need to keep their data intact would have to allocate a copy first.  This
+ * variant copies the values into ``workspace`` and partitions the copy there;
+ * it never calls the allocator.
+ *
+ * @param workspace Scratch memory of at least
+ *     ``ac_split_find_workspace_bytes(size)`` bytes.
+ * @param array Values to inspect; left unchanged.
+ * @param size Number of values in ``array``.
+ * @param index Zero-based rank to retrieve.
+ * @param out_value Receives the selected value.
+ * @return ``0`` on success, ``-EINVAL`` for ``NULL`` pointers or an
+ *     out-of-range ``index``, or ``-ENOSPC`` when the workspace is too small.
+ * @signature int ac_split_find_ws(ac_sort_workspace *workspace,
+ *                                 const double *array, size_t size,
+ *                                 size_t index, double *out_value)
+ */
+int ac_split_find_ws(
+    ac_sort_workspace *workspace,
+    const double *array,
+    size_t size,
+    size_t index,
+    double *out_value
+);
+
 #ifdef __cplusplus
 }
 #endif
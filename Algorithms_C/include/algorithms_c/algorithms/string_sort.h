@@ -0,0 +1,81 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_STRING_SORT_H
+#define ALGORITHMS_C_ALGORITHMS_STRING_SORT_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file string_sort.h
+ * @brief Byte-wise lexicographic sorting of string arrays.
+ *
+ * Sorting ``char *`` pointers with a ``strcmp`` comparator re-reads the
+ * common prefix of two strings on every comparison, which dominates when keys
+ * share long prefixes (URLs, paths, log keys).  The sorts below look at every
+ * byte position at most a few times instead:
+ *
+ * - Multikey quicksort (Bentley and Sedgewick) partitions on one byte at a
+ *   time into less / equal / greater parts and only advances to the next byte
+ *   inside the equal part.
+ * - Large inputs first go through MSD radix passes.  Each pass gathers the
+ *   current byte of every string into a side array once, then counts and
+ *   distributes from that array, so the strings themselves are touched once
+ *   per pass in sequential order.  Buckets below a threshold are finished by
+ *   the multikey quicksort.
+ *
+ * Bytes compare as ``unsigned char`` and a string sorts before any string it
+ * is a proper prefix of, i.e. the order of ``strcmp`` or of ``memcmp``
+ * followed by length.  The sorts are not stable, which is only observable for
+ * ``ac_string_view`` entries with equal contents at different addresses.
+ * Only the pointers move; string bytes are never written.
+ */
+
+/**
+ * @struct ac_string_view
+ * @brief ``size`` bytes starting at ``data``, not necessarily NUL-terminated.
+ *
+ * ``data`` may be ``NULL`` when ``size`` is zero.  Embedded NUL bytes are
+ * ordinary bytes.
+ */
+typedef struct {
+    const char *data;
+    size_t size;
+} ac_string_view;
+
+/**
+ * @brief Sort NUL-terminated strings in ascending ``strcmp`` order.
+ *
+ * Falls back to the allocation-free multikey quicksort when the radix
+ * scratch (``size`` pointers and ``size`` 16-bit keys) cannot be allocated,
+ * so the result does not depend on memory availability.
+ *
+ * @param strs Array of ``size`` non-``NULL`` string pointers, reordered in
+ *        place.
+ * @param size Number of strings.
+ * @return ``0`` on success or ``-EINVAL`` when ``strs`` is ``NULL`` with a
+ *         non-zero ``size``.
+ * @signature int ac_sort_strings(const char **strs, size_t size)
+ */
+int ac_sort_strings(const char **strs, size_t size);
+
+/**
+ * @brief Length-aware variant of ``ac_sort_strings``.
+ *
+ * Strings are compared as byte sequences of the given lengths, so they may
+ * contain NUL bytes and need not be terminated.
+ *
+ * @param strs Array of ``size`` views, reordered in place.
+ * @param size Number of views.
+ * @return ``0`` on success or ``-EINVAL`` when ``strs`` is ``NULL`` with a
+ *         non-zero ``size``.
+ * @signature int ac_sort_string_views(ac_string_view *strs, size_t size)
+ */
+int ac_sort_string_views(ac_string_view *strs, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef ALGORITHMS_C_ALGORITHMS_TYPED_SORT_H
+#define ALGORITHMS_C_ALGORITHMS_TYPED_SORT_H
+
+#include <stddef.h>
+#include "algorithms_c/algorithms/sort_kernels.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file typed_sort.h
+ * @brief Type-specialized sort kernels and the ``ac_sort`` front-end.
+ *
+ * The kernels below are generated by ``AC_DEFINE_SORT_KERNELS`` for every
+ * standard integer and floating-point type.  Each one follows the same naming
+ * scheme ``ac_<algorithm>_sort_<suffix>(type *data, size_t size)`` and sorts
+ * ascending with the built-in ``<``:
+ *
+ * | suffix   | element type           |
+ * |----------|------------------------|
+ * | ``int``    | ``int``                |
+ * | ``uint``   | ``unsigned int``       |
+ * | ``long``   | ``long``               |
+ * | ``ulong``  | ``unsigned long``      |
+ * | ``llong``  | ``long long``          |
+ * | ``ullong`` | ``unsigned long long`` |
+ * | ``float``  | ``float``              |
+ * | ``double`` | ``double``             |
+ *
+ * Fixed-width aliases such as ``int32_t`` or ``uint64_t`` resolve to one of
+ * these types.  The ``void *`` helpers from ``sorting.h`` remain the entry
+ * points for records and any type not listed here.
+ */
+
+AC_DECLARE_SORT_KERNELS(int, int);
+AC_DECLARE_SORT_KERNELS(uint, unsigned int);
+AC_DECLARE_SORT_KERNELS(long, long);
+AC_DECLARE_SORT_KERNELS(ulong, unsigned long);
+AC_DECLARE_SORT_KERNELS(llong, long long);
+AC_DECLARE_SORT_KERNELS(ullong, unsigned long long);
+AC_DECLARE_SORT_KERNELS(float, float);
+AC_DECLARE_SORT_KERNELS(double, double);
+
+#ifndef __cplusplus
+
+/**
+ * @brief Sort a typed array with the matching introsort kernel.
+ *
+ * Dispatches on the pointer type at compile time, so
+ * ``ac_sort(values, count)`` on an ``unsigned long long *`` calls
+ * ``ac_quick_sort_ullong``.  Passing an unsupported pointer type is a compile
+ * error; use ``ac_quick_sort`` with a comparator instead.
+ *
+ * @signature void ac_sort(type *data, size_t size)
+ */
+#define ac_sort(data, size)                         \
+    _Generic(                                       \
+        (data),                                     \
+        int *: ac_quick_sort_int,                   \
+        unsigned int *: ac_quick_sort_uint,         \
+        long *: ac_quick_sort_long,                 \
+        unsigned long *: ac_quick_sort_ulong,       \
+        long long *: ac_quick_sort_llong,           \
+        unsigned long long *: ac_quick_sort_ullong, \
+        float *: ac_quick_sort_float,               \
+        double *: ac_quick_sort_double              \
+    )((data), (size))
+
+/**
+ * @brief Stable counterpart of ``ac_sort`` backed by the merge kernels.
+ *
+ * @signature void ac_stable_sort(type *data, size_t size)
+ */
+#define ac_stable_sort(data, size)                  \
+    _Generic(                                       \
+        (data),                                     \
+        int *: ac_merge_sort_int,                   \
+        unsigned int *: ac_merge_sort_uint,         \
+        long *: ac_merge_sort_long,                 \
+        unsigned long *: ac_merge_sort_ulong,       \
+        long long *: ac_merge_sort_llong,           \
+        unsigned long long *: ac_merge_sort_ullong, \
+        float *: ac_merge_sort_float,               \
+        double *: ac_merge_sort_double              \
+    )((data), (size))
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
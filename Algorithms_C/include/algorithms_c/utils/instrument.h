@@ -0,0 +1,86 @@
+#ifndef ALGORITHMS_C_UTILS_INSTRUMENT_H
+#define ALGORITHMS_C_UTILS_INSTRUMENT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file instrument.h
+ * @brief Optional comparison and element-move counters.
+ *
+ * When the library is configured with ``-DAC_ENABLE_INSTRUMENTATION=ON`` the
+ * comparison sorts of ``sorting.h``, ``ac_binary_search``,
+ * ``ac_lower_bound``, ``ac_upper_bound`` and the ``ac_heap`` operations count
+ * every ``ac_compare_fn`` invocation and every element they copy.  A copy of
+ * ``k`` elements counts ``k`` moves, so a swap through a scratch buffer
+ * counts three.
+ *
+ * The counters are per thread.  Work that ``ac_merge_sort_parallel`` or
+ * ``ac_sample_sort`` hands to ``ac_parallel_for`` workers is counted on those
+ * workers and added to the caller's counters when the batch completes, so
+ * the caller's snapshot covers the whole sort.
+ *
+ * Without the option the counting macros expand to the plain call and to
+ * nothing, and the snapshot always reports zeros.
+ */
+
+/** Counts accumulated by the calling thread since its last reset. */
+typedef struct {
+    uint64_t comparisons;
+    uint64_t moves;
+} ac_instrument_counters;
+
+/**
+ * @brief Report whether the library was built with instrumentation.
+ *
+ * @return ``1`` when the counters are live, ``0`` when they are compiled out.
+ * @signature int ac_instrument_enabled(void)
+ */
+int ac_instrument_enabled(void);
+
+/**
+ * @brief Copy the calling thread's counters into ``counters``.
+ *
+ * @param counters Destination; ignored when ``NULL``.
+ * @signature void ac_instrument_snapshot(ac_instrument_counters *counters)
+ */
+void ac_instrument_snapshot(ac_instrument_counters *counters);
+
+/**
+ * @brief Zero the calling thread's counters.
+ *
+ * @signature void ac_instrument_reset(void)
+ */
+void ac_instrument_reset(void);
+
+#ifdef AC_ENABLE_INSTRUMENTATION
+
+#ifdef __cplusplus
+extern thread_local ac_instrument_counters ac_instrument_thread_counters;
+#else
+extern _Thread_local ac_instrument_counters ac_instrument_thread_counters;
+#endif
+
+/** Call ``compare(lhs, rhs)`` and count the comparison. */
+#define AC_COMPARE(compare, lhs, rhs)                                         \
+    (++ac_instrument_thread_counters.comparisons, (compare)(lhs, rhs))
+
+/** Count ``count`` element moves. */
+#define AC_COUNT_MOVES(count)                                                 \
+    ((void)(ac_instrument_thread_counters.moves += (uint64_t)(count)))
+
+#else
+
+#define AC_COMPARE(compare, lhs, rhs) ((compare)(lhs, rhs))
+#define AC_COUNT_MOVES(count) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
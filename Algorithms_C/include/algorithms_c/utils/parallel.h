@@ -0,0 +1,68 @@
+#ifndef ALGORITHMS_C_UTILS_PARALLEL_H
+#define ALGORITHMS_C_UTILS_PARALLEL_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file parallel.h
+ * @brief Minimal fork-join task pool shared by the parallel algorithms.
+ *
+ * The pool is deliberately small: a batch of ``task_count`` independent tasks
+ * is executed by up to ``threads`` workers (the calling thread included) that
+ * repeatedly claim the next unclaimed task index.  Algorithms express their
+ * phases (sort chunks, merge pairs, classify blocks, ...) as such batches and
+ * rely on the implicit barrier at the end of each call.
+ *
+ * When the library is built without POSIX threads, or when worker creation
+ * fails, the remaining tasks simply run on the calling thread, so callers
+ * never need a separate serial code path for correctness.
+ */
+
+/**
+ * @brief Callback executed once per task index.
+ *
+ * @param context Caller-provided state shared by every task of the batch.
+ * @param task_index Index in ``[0, task_count)`` identifying the task.
+ */
+typedef void (*ac_parallel_task_fn)(void *context, size_t task_index);
+
+/**
+ * @brief Report how many hardware threads are available to this process.
+ *
+ * @return Number of online processors, or ``1`` when it cannot be determined
+ *         or threading support is compiled out.
+ * @signature size_t ac_parallel_hardware_threads(void)
+ */
+size_t ac_parallel_hardware_threads(void);
+
+/**
+ * @brief Run ``task(context, i)`` for every ``i`` in ``[0, task_count)``.
+ *
+ * Returns after every task has completed.  Tasks may run concurrently and in
+ * any order, so they must only touch disjoint state.  ``threads == 0`` selects
+ * ``ac_parallel_hardware_threads()``.
+ *
+ * @param task_count Number of tasks in the batch.
+ * @param threads Maximum number of threads to use, including the caller.
+ * @param task Callback executed for each task index; must not be ``NULL``.
+ * @param context Opaque pointer forwarded to ``task``.
+ * @return ``0`` on success or ``-EINVAL`` when ``task`` is ``NULL``.
+ * @signature int ac_parallel_for(size_t task_count, size_t threads,
+ *                                ac_parallel_task_fn task, void *context)
+ */
+int ac_parallel_for(
+    size_t task_count,
+    size_t threads,
+    ac_parallel_task_fn task,
+    void *context
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
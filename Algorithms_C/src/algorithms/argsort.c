@@ -0,0 +1,312 @@
+#include "algorithms_c/algorithms/argsort.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Ranges at or below this size are finished by insertion sort. */
+#define AC_ARGSORT_INSERTION_THRESHOLD 16U
+
+/** Ranges above this size use the ninther instead of median-of-three. */
+#define AC_ARGSORT_NINTHER_THRESHOLD 128U
+
+/** Records up to this width are staged on the stack while cycling. */
+#define AC_ARGSORT_STACK_SCRATCH 256U
+
+typedef struct {
+    const unsigned char *data;
+    size_t element_size;
+    ac_compare_fn compare;
+    int stable;
+} ac_argsort_context;
+
+static int index_less(const ac_argsort_context *context, size_t a, size_t b) {
+    int order = context->compare(
+        context->data + (a * context->element_size),
+        context->data + (b * context->element_size)
+    );
+    if (order != 0 || !context->stable) {
+        return order < 0;
+    }
+    // Ties fall back to input order, which makes every index distinct.
+    return a < b;
+}
+
+static void insertion_sort_indices(
+    const ac_argsort_context *context,
+    size_t *perm,
+    size_t size
+) {
+    for (size_t i = 1; i < size; ++i) {
+        size_t current = perm[i];
+        size_t j = i;
+        while (j > 0 && index_less(context, current, perm[j - 1U])) {
+            perm[j] = perm[j - 1U];
+            --j;
+        }
+        perm[j] = current;
+    }
+}
+
+static void sift_down_indices(
+    const ac_argsort_context *context,
+    size_t *perm,
+    size_t root,
+    size_t size
+) {
+    size_t value = perm[root];
+    for (;;) {
+        size_t child = (2U * root) + 1U;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1U < size &&
+            index_less(context, perm[child], perm[child + 1U])) {
+            ++child;
+        }
+        if (!index_less(context, value, perm[child])) {
+            break;
+        }
+        perm[root] = perm[child];
+        root = child;
+    }
+    perm[root] = value;
+}
+
+static void heap_sort_indices(
+    const ac_argsort_context *context,
+    size_t *perm,
+    size_t size
+) {
+    for (size_t root = size / 2U; root > 0; --root) {
+        sift_down_indices(context, perm, root - 1U, size);
+    }
+    for (size_t end = size; end > 1U; --end) {
+        size_t top = perm[0];
+        perm[0] = perm[end - 1U];
+        perm[end - 1U] = top;
+        sift_down_indices(context, perm, 0U, end - 1U);
+    }
+}
+
+static size_t median_of_three(
+    const ac_argsort_context *context,
+    const size_t *perm,
+    size_t a,
+    size_t b,
+    size_t c
+) {
+    if (index_less(context, perm[a], perm[b])) {
+        if (index_less(context, perm[b], perm[c])) {
+            return b;
+        }
+        return index_less(context, perm[a], perm[c]) ? c : a;
+    }
+    if (index_less(context, perm[a], perm[c])) {
+        return a;
+    }
+    return index_less(context, perm[b], perm[c]) ? c : b;
+}
+
+static size_t choose_pivot(
+    const ac_argsort_context *context,
+    const size_t *perm,
+    size_t size
+) {
+    size_t last = size - 1U;
+    size_t mid = size / 2U;
+    if (size <= AC_ARGSORT_NINTHER_THRESHOLD) {
+        return median_of_three(context, perm, 0U, mid, last);
+    }
+    size_t step = size / 8U;
+    return median_of_three(
+        context, perm, median_of_three(context, perm, 0U, step, 2U * step),
+        median_of_three(context, perm, mid - step, mid, mid + step),
+        median_of_three(
+            context, perm, last - (2U * step), last - step, last
+        )
+    );
+}
+
+static void introsort_indices(
+    const ac_argsort_context *context,
+    size_t *perm,
+    size_t size,
+    size_t depth_limit
+) {
+    while (size > AC_ARGSORT_INSERTION_THRESHOLD) {
+        if (depth_limit == 0) {
+            heap_sort_indices(context, perm, size);
+            return;
+        }
+        --depth_limit;
+
+        size_t chosen = choose_pivot(context, perm, size);
+        size_t pivot = perm[chosen];
+        perm[chosen] = perm[0];
+        perm[0] = pivot;
+
+        // Hoare partition: both scans stop on keys equal to the pivot, so
+        // runs of duplicates are split evenly instead of degrading.
+        size_t i = 0;
+        size_t j = size;
+        for (;;) {
+            do {
+                ++i;
+            } while (i < size && index_less(context, perm[i], pivot));
+            do {
+                --j;
+            } while (index_less(context, pivot, perm[j]));
+            if (i >= j) {
+                break;
+            }
+            size_t tmp = perm[i];
+            perm[i] = perm[j];
+            perm[j] = tmp;
+        }
+        perm[0] = perm[j];
+        perm[j] = pivot;
+
+        size_t *upper = perm + j + 1U;
+        size_t upper_size = size - j - 1U;
+        if (j < upper_size) {
+            introsort_indices(context, perm, j, depth_limit);
+            perm = upper;
+            size = upper_size;
+        } else {
+            introsort_indices(context, upper, upper_size, depth_limit);
+            size = j;
+        }
+    }
+    insertion_sort_indices(context, perm, size);
+}
+
+static int argsort_impl(
+    const void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t *out_perm,
+    int stable
+) {
+    if (size == 0) {
+        return 0;
+    }
+    if (data == NULL || compare == NULL || element_size == 0 ||
+        out_perm == NULL) {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        out_perm[i] = i;
+    }
+
+    ac_argsort_context context;
+    context.data = (const unsigned char *)data;
+    context.element_size = element_size;
+    context.compare = compare;
+    context.stable = stable;
+
+    size_t depth_limit = 0;
+    for (size_t n = size; n > 1U; n >>= 1U) {
+        depth_limit += 2U;
+    }
+    introsort_indices(&context, out_perm, size, depth_limit);
+    return 0;
+}
+
+int ac_argsort(
+    const void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t *out_perm
+) {
+    return argsort_impl(data, size, element_size, compare, out_perm, 0);
+}
+
+int ac_stable_argsort(
+    const void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t *out_perm
+) {
+    return argsort_impl(data, size, element_size, compare, out_perm, 1);
+}
+
+int ac_apply_permutation(
+    void *data,
+    size_t size,
+    size_t element_size,
+    const size_t *perm
+) {
+    if (size == 0) {
+        return 0;
+    }
+    if (data == NULL || perm == NULL || element_size == 0) {
+        return -EINVAL;
+    }
+
+    size_t word_bits = sizeof(unsigned long) * CHAR_BIT;
+    size_t words = (size + word_bits - 1U) / word_bits;
+    unsigned long *visited =
+        (unsigned long *)calloc(words, sizeof(unsigned long));
+    if (visited == NULL) {
+        return -ENOMEM;
+    }
+
+    // Reject anything that is not a permutation before touching ``data``.
+    for (size_t i = 0; i < size; ++i) {
+        size_t target = perm[i];
+        unsigned long bit = 1UL << (target % word_bits);
+        if (target >= size || (visited[target / word_bits] & bit) != 0) {
+            free(visited);
+            return -EINVAL;
+        }
+        visited[target / word_bits] |= bit;
+    }
+    memset(visited, 0, words * sizeof(unsigned long));
+
+    unsigned char stack_scratch[AC_ARGSORT_STACK_SCRATCH];
+    unsigned char *scratch = stack_scratch;
+    if (element_size > sizeof(stack_scratch)) {
+        scratch = (unsigned char *)malloc(element_size);
+        if (scratch == NULL) {
+            free(visited);
+            return -ENOMEM;
+        }
+    }
+
+    unsigned char *bytes = (unsigned char *)data;
+    for (size_t start = 0; start < size; ++start) {
+        unsigned long bit = 1UL << (start % word_bits);
+        if ((visited[start / word_bits] & bit) != 0 || perm[start] == start) {
+            continue;
+        }
+
+        // Walk the cycle start <- perm[start] <- perm[perm[start]] ...,
+        // pulling each record into the slot that wants it.
+        memcpy(scratch, bytes + (start * element_size), element_size);
+        size_t slot = start;
+        for (;;) {
+            visited[slot / word_bits] |= 1UL << (slot % word_bits);
+            size_t source = perm[slot];
+            if (source == start) {
+                memcpy(bytes + (slot * element_size), scratch, element_size);
+                break;
+            }
+            memcpy(
+                bytes + (slot * element_size), bytes + (source * element_size),
+                element_size
+            );
+            slot = source;
+        }
+    }
+
+    if (scratch != stack_scratch) {
+        free(scratch);
+    }
+    free(visited);
+    return 0;
+}
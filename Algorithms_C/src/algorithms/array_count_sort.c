@@ -1,81 +1,235 @@
 #include "algorithms_c/algorithms/array_count_sort.h"
-#include <assert.h>
+#include <errno.h>
 #include <limits.h>
 #include <stddef.h>
-#include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/argsort.h"
 
-// Function to find the maximum and minimum values in a 2D array
-// based on a specific key index
-static void
-find_min_max(int **arr, size_t rows, size_t key, int *min, int *max) {
-    *min = INT_MAX;
-    *max = INT_MIN;
+/*
+ * Row sorting never moves rows while ordering them.  The permutation of row
+ * indices is sorted one key column at a time, from the least significant key
+ * to the most significant one.  For each column the keys are gathered once in
+ * permutation order and the (key, index) pairs are put through stable LSD
+ * counting passes of at most 11 bits over ``key - min``, so a column whose
+ * keys span at most 2048 values takes a single counting pass.  The rows are
+ * moved once, after the last column.
+ */
+
+/** Widest digit of one counting pass. */
+#define AC_ROW_SORT_DIGIT_BITS 11U
+
+#define AC_ROW_SORT_BUCKETS (1U << AC_ROW_SORT_DIGIT_BITS)
+
+typedef struct {
+    size_t rows;
+    /** Row index of every output position, and its scatter target. */
+    size_t *perm;
+    size_t *perm_next;
+    /** Key of every output position for the current column. */
+    unsigned *keys;
+    unsigned *keys_next;
+    size_t counts[AC_ROW_SORT_BUCKETS];
+} ac_row_sort_state;
+
+/** Map ``value`` to an unsigned key with the same order. */
+static unsigned row_key(int value, unsigned flags) {
+    unsigned key = (unsigned)value - (unsigned)INT_MIN;
+    if ((flags & AC_ROW_SORT_NULLS_LAST) != 0U) {
+        // ``INT_MIN`` wraps around to the largest key.
+        key -= 1U;
+    }
+    return key;
+}
+
+static int row_sort_init(ac_row_sort_state *state, size_t rows) {
+    state->rows = rows;
+    state->perm = NULL;
+    state->perm_next = NULL;
+    state->keys = NULL;
+    state->keys_next = NULL;
+    if (rows > SIZE_MAX / sizeof(size_t)) {
+        return -ENOMEM;
+    }
+    state->perm = (size_t *)malloc(rows * sizeof(size_t));
+    state->perm_next = (size_t *)malloc(rows * sizeof(size_t));
+    state->keys = (unsigned *)malloc(rows * sizeof(unsigned));
+    state->keys_next = (unsigned *)malloc(rows * sizeof(unsigned));
+    if (state->perm == NULL || state->perm_next == NULL ||
+        state->keys == NULL || state->keys_next == NULL) {
+        return -ENOMEM;
+    }
     for (size_t i = 0; i < rows; ++i) {
-        if (arr[i][key] != INT_MIN) {
-            if (arr[i][key] < *min) {
-                *min = arr[i][key];
-            }
-            if (arr[i][key] > *max) {
-                *max = arr[i][key];
-            }
+        state->perm[i] = i;
+    }
+    return 0;
+}
+
+static void row_sort_destroy(ac_row_sort_state *state) {
+    free(state->perm);
+    free(state->perm_next);
+    free(state->keys);
+    free(state->keys_next);
+}
+
+/** Stably reorder ``perm`` by the keys gathered into ``keys``. */
+static void sort_by_keys(ac_row_sort_state *state) {
+    size_t rows = state->rows;
+    unsigned low = state->keys[0];
+    unsigned high = state->keys[0];
+    for (size_t i = 1; i < rows; ++i) {
+        unsigned key = state->keys[i];
+        if (key < low) {
+            low = key;
         }
+        if (key > high) {
+            high = key;
+        }
+    }
+    unsigned span = high - low;
+    unsigned bits = 0;
+    while (bits < sizeof(unsigned) * CHAR_BIT && (span >> bits) != 0U) {
+        ++bits;
+    }
+    if (bits == 0) {
+        return;
+    }
+    unsigned passes = (bits + AC_ROW_SORT_DIGIT_BITS - 1U) /
+                      AC_ROW_SORT_DIGIT_BITS;
+    unsigned width = (bits + passes - 1U) / passes;
+    unsigned mask = (1U << width) - 1U;
+    size_t buckets = (size_t)mask + 1U;
+
+    for (unsigned pass = 0; pass < passes; ++pass) {
+        unsigned shift = pass * width;
+        size_t *counts = state->counts;
+        memset(counts, 0, buckets * sizeof(size_t));
+        for (size_t i = 0; i < rows; ++i) {
+            ++counts[((state->keys[i] - low) >> shift) & mask];
+        }
+        if (counts[((state->keys[0] - low) >> shift) & mask] == rows) {
+            // Every key shares this digit.
+            continue;
+        }
+        size_t total = 0;
+        for (size_t bucket = 0; bucket < buckets; ++bucket) {
+            size_t count = counts[bucket];
+            counts[bucket] = total;
+            total += count;
+        }
+
+        for (size_t i = 0; i < rows; ++i) {
+            unsigned key = state->keys[i];
+            size_t target = counts[((key - low) >> shift) & mask]++;
+            state->keys_next[target] = key;
+            state->perm_next[target] = state->perm[i];
+        }
+        unsigned *keys = state->keys;
+        state->keys = state->keys_next;
+        state->keys_next = keys;
+        size_t *perm = state->perm;
+        state->perm = state->perm_next;
+        state->perm_next = perm;
     }
 }
 
-// Function to perform Counting Sort on a 2D array
-// based on a specific key index
-void ac_array_count_sort(int **arr, size_t rows, size_t cols, size_t key) {
-    // Initialize and calculate min and max in the array
-    int min;
-    int max;
-    find_min_max(arr, rows, key, &min, &max);
-
-    // Initialize range of the array's elements
-    size_t range = (size_t)(max - min + 2);
-
-    // Initialize arrays for counting and for storing the result
-    size_t *count = (size_t *)calloc(range, sizeof(size_t));
-    int **result = (int **)malloc(rows * sizeof(int *));
-
-    // Count occurrences of each key
-    for (size_t i = 0; i < rows; i++) {
-        result[i] = (int *)calloc(cols, sizeof(int));
-        if (arr[i][key] != INT_MIN) {
-            count[arr[i][key] - min]++;
-        } else {
-            count[range - 1]++;
+int ac_row_sort_int(
+    int *table,
+    size_t rows,
+    size_t cols,
+    size_t stride,
+    const size_t *keys,
+    size_t key_count,
+    unsigned flags
+) {
+    if (keys == NULL && key_count != 0) {
+        return -EINVAL;
+    }
+    if (rows == 0 || key_count == 0) {
+        return 0;
+    }
+    if (table == NULL || cols == 0 || stride < cols) {
+        return -EINVAL;
+    }
+    for (size_t k = 0; k < key_count; ++k) {
+        if (keys[k] >= cols) {
+            return -EINVAL;
         }
     }
+    if (rows < 2U) {
+        return 0;
+    }
 
-    // Calculate cumulative count
-    for (size_t i = 1; i < range; i++) {
-        count[i] += count[i - 1];
+    ac_row_sort_state state;
+    int status = row_sort_init(&state, rows);
+    for (size_t k = key_count; status == 0 && k-- > 0;) {
+        const int *column = table + keys[k];
+        for (size_t i = 0; i < rows; ++i) {
+            state.keys[i] = row_key(column[state.perm[i] * stride], flags);
+        }
+        sort_by_keys(&state);
     }
 
-    // Build sorted array
-    for (size_t index = rows; index > 0; index--) {
-        size_t i = index - 1;
-        if (arr[i][key] != INT_MIN) {
-            size_t position = --count[arr[i][key] - min];
-            for (size_t j = 0; j < cols; j++) {
-                result[position][j] = arr[i][j];
+    if (status == 0) {
+        // Gather the rows into a packed copy, then copy them back; in place
+        // through ``ac_apply_permutation`` if the copy cannot be allocated.
+        int *sorted = rows > SIZE_MAX / sizeof(int) / cols
+                          ? NULL
+                          : (int *)malloc(rows * cols * sizeof(int));
+        if (sorted != NULL) {
+            for (size_t i = 0; i < rows; ++i) {
+                memcpy(
+                    sorted + (i * cols), table + (state.perm[i] * stride),
+                    cols * sizeof(int)
+                );
             }
-        } else {
-            size_t position = --count[range - 1];
-            for (size_t j = 0; j < cols; j++) {
-                if (position < rows) {
-                    result[position][j] = arr[i][j];
-                }
+            for (size_t i = 0; i < rows; ++i) {
+                memcpy(
+                    table + (i * stride), sorted + (i * cols),
+                    cols * sizeof(int)
+                );
             }
+            free(sorted);
+        } else if (stride == cols) {
+            status = ac_apply_permutation(
+                table, rows, cols * sizeof(int), state.perm
+            );
+        } else {
+            status = -ENOMEM;
         }
     }
-    for (size_t i = 0; i < rows; i++) {
-        for (size_t j = 0; j < cols; j++) {
-            arr[i][j] = result[i][j];
-        }
-        free(result[i]);
+    row_sort_destroy(&state);
+    return status;
+}
+
+void ac_array_count_sort(int **arr, size_t rows, size_t cols, size_t key) {
+    if (arr == NULL || rows < 2U || key >= cols ||
+        rows > SIZE_MAX / sizeof(int) / cols) {
+        return;
+    }
+
+    ac_row_sort_state state;
+    int status = row_sort_init(&state, rows);
+    int *sorted = (int *)malloc(rows * cols * sizeof(int));
+    if (status != 0 || sorted == NULL) {
+        free(sorted);
+        row_sort_destroy(&state);
+        return;
+    }
+
+    for (size_t i = 0; i < rows; ++i) {
+        state.keys[i] = row_key(arr[i][key], AC_ROW_SORT_NULLS_LAST);
+    }
+    sort_by_keys(&state);
+
+    // One contiguous copy of the table instead of one allocation per row.
+    for (size_t i = 0; i < rows; ++i) {
+        memcpy(sorted + (i * cols), arr[state.perm[i]], cols * sizeof(int));
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        memcpy(arr[i], sorted + (i * cols), cols * sizeof(int));
     }
-    free(result);
-    free(count);
+    free(sorted);
+    row_sort_destroy(&state);
 }
@@ -1,5 +1,6 @@
 #include "algorithms_c/algorithms/binary_search.h"
 #include <stddef.h>
+#include "algorithms_c/utils/instrument.h"
 
 int ac_compare_int(const void *lhs, const void *rhs) {
     const int left = *(const int *)lhs;
@@ -32,7 +33,7 @@ ptrdiff_t ac_binary_search(
         size_t mid = left + ((right - left) / 2);
         const unsigned char *base =
             (const unsigned char *)data + (mid * element_size);
-        int cmp = compare(base, target);
+        int cmp = AC_COMPARE(compare, base, target);
         if (cmp == 0) {
             return (ptrdiff_t)mid;
         }
@@ -65,7 +66,7 @@ size_t ac_lower_bound(
         size_t mid = left + ((right - left) / 2);
         const unsigned char *base =
             (const unsigned char *)data + (mid * element_size);
-        if (compare(base, target) < 0) {
+        if (AC_COMPARE(compare, base, target) < 0) {
             left = mid + 1;
         } else {
             right = mid;
@@ -93,7 +94,7 @@ size_t ac_upper_bound(
         size_t mid = left + ((right - left) / 2);
         const unsigned char *base =
             (const unsigned char *)data + (mid * element_size);
-        if (compare(base, target) <= 0) {
+        if (AC_COMPARE(compare, base, target) <= 0) {
             left = mid + 1;
         } else {
             right = mid;
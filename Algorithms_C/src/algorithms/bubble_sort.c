@@ -1,7 +1,42 @@
+#include <errno.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+
+static void bubble_sort_with_buffer(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *scratch
+) {
+    // After each outer pass, the largest element in the remaining unsorted
+    // prefix is guaranteed to settle at position `pass_end - 1`.
+    for (size_t pass_end = size; pass_end > 1; --pass_end) {
+        bool swapped = false;
+
+        for (size_t i = 1; i < pass_end; ++i) {
+            unsigned char *lhs = array + ((i - 1U) * element_size);
+            unsigned char *rhs = array + (i * element_size);
+            if (AC_COMPARE(compare, lhs, rhs) <= 0) {
+                continue;
+            }
+
+            memcpy(scratch, lhs, element_size);
+            memcpy(lhs, rhs, element_size);
+            memcpy(rhs, scratch, element_size);
+            AC_COUNT_MOVES(3U);
+            swapped = true;
+        }
+
+        if (!swapped) {
+            break;
+        }
+    }
+}
 
 /**
  * @brief Sort contiguous storage using the classic bubble-sort pass strategy.
@@ -26,34 +61,41 @@ void ac_bubble_sort(
         return;
     }
 
-    unsigned char *array = (unsigned char *)data;
     unsigned char *scratch = (unsigned char *)malloc(element_size);
     if (scratch == NULL) {
         return;
     }
 
-    // After each outer pass, the largest element in the remaining unsorted
-    // prefix is guaranteed to settle at position `pass_end - 1`.
-    for (size_t pass_end = size; pass_end > 1; --pass_end) {
-        bool swapped = false;
-
-        for (size_t i = 1; i < pass_end; ++i) {
-            unsigned char *lhs = array + ((i - 1U) * element_size);
-            unsigned char *rhs = array + (i * element_size);
-            if (compare(lhs, rhs) <= 0) {
-                continue;
-            }
+    bubble_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, scratch
+    );
+    free(scratch);
+}
 
-            memcpy(scratch, lhs, element_size);
-            memcpy(lhs, rhs, element_size);
-            memcpy(rhs, scratch, element_size);
-            swapped = true;
-        }
+int ac_bubble_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
 
-        if (!swapped) {
-            break;
-        }
+    unsigned char *scratch = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (scratch == NULL) {
+        return -ENOSPC;
     }
 
-    free(scratch);
+    bubble_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, scratch
+    );
+    return 0;
 }
@@ -1,36 +1,18 @@
+#include <errno.h>
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
 
-/**
- * @brief Sort contiguous storage using comb sort with a shrink factor.
- *
- * Source file translated in this step:
- * ``Algorithms_Python/algorithms/sorting/comb_sort.py``.
- *
- * Comb sort improves bubble sort by comparing elements at a configurable gap
- * distance and shrinking that gap on each pass. Once the gap reaches one, the
- * algorithm behaves like a final bubble-sort sweep to finish local inversions.
- * The commonly used shrink factor 1.3 is retained for readability and parity
- * with educational references.
- */
-void ac_comb_sort(
-    void *data,
+static void comb_sort_with_buffer(
+    unsigned char *array,
     size_t size,
     size_t element_size,
-    ac_compare_fn compare
+    ac_compare_fn compare,
+    unsigned char *scratch
 ) {
-    if (data == NULL || compare == NULL || element_size == 0 || size < 2) {
-        return;
-    }
-
-    unsigned char *array = (unsigned char *)data;
-    unsigned char *scratch = (unsigned char *)malloc(element_size);
-    if (scratch == NULL) {
-        return;
-    }
-
     const double shrink_factor = 1.3;
     size_t gap = size;
     bool swapped = true;
@@ -49,16 +31,76 @@ void ac_comb_sort(
             unsigned char *lhs = array + (i * element_size);
             unsigned char *rhs = array + ((i + gap) * element_size);
 
-            if (compare(lhs, rhs) <= 0) {
+            if (AC_COMPARE(compare, lhs, rhs) <= 0) {
                 continue;
             }
 
             memcpy(scratch, lhs, element_size);
             memcpy(lhs, rhs, element_size);
             memcpy(rhs, scratch, element_size);
+            AC_COUNT_MOVES(3U);
             swapped = true;
         }
     }
+}
 
+/**
+ * @brief Sort contiguous storage using comb sort with a shrink factor.
+ *
+ * Source file translated in this step:
+ * ``Algorithms_Python/algorithms/sorting/comb_sort.py``.
+ *
+ * Comb sort improves bubble sort by comparing elements at a configurable gap
+ * distance and shrinking that gap on each pass. Once the gap reaches one, the
+ * algorithm behaves like a final bubble-sort sweep to finish local inversions.
+ * The commonly used shrink factor 1.3 is retained for readability and parity
+ * with educational references.
+ */
+void ac_comb_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (data == NULL || compare == NULL || element_size == 0 || size < 2) {
+        return;
+    }
+
+    unsigned char *scratch = (unsigned char *)malloc(element_size);
+    if (scratch == NULL) {
+        return;
+    }
+
+    comb_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, scratch
+    );
     free(scratch);
 }
+
+int ac_comb_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+
+    unsigned char *scratch = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (scratch == NULL) {
+        return -ENOSPC;
+    }
+
+    comb_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, scratch
+    );
+    return 0;
+}
@@ -1,41 +1,286 @@
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/parallel.h"
 
-void ac_counting_sort_int(
-    int *data,
+/*
+ * Counting engine shared by the counting sorts.
+ *
+ * 1. Ranges up to ``AC_COUNT_SORT_SUB_RANGE`` values are counted into four
+ *    interleaved 32-bit sub-histograms (element ``i`` bumps histogram
+ *    ``i % 4``), so runs of equal keys update four different counters instead
+ *    of waiting on the previous increment of one.  The four histograms fit in
+ *    L1 together and are folded into the totals every
+ *    ``AC_COUNT_SORT_CHUNK`` elements, before a 32-bit counter can wrap.
+ *    Wider ranges count straight into one ``size_t`` histogram.
+ * 2. Large inputs are cut into blocks that are counted concurrently into
+ *    per-block histograms; the histograms are then summed slice by slice.
+ * 3. The output is written as one fill per distinct value.  In the parallel
+ *    path the value range is split into slices of similar output size, each
+ *    filling its own window.
+ *
+ * Ranges that are both wider than ``AC_COUNT_SORT_SUB_RANGE`` and more than
+ * twice the input size would spend more time on the histogram than on the
+ * data, so they are handed to the radix sort instead.
+ */
+
+/** Ranges up to this many values use the interleaved sub-histograms. */
+#define AC_COUNT_SORT_SUB_RANGE 2048U
+
+/** Number of interleaved sub-histograms. */
+#define AC_COUNT_SORT_SUB_HISTOGRAMS 4U
+
+/** Elements counted into the 32-bit sub-histograms between folds. */
+#define AC_COUNT_SORT_CHUNK ((size_t)1U << 30)
+
+/** Inputs below this size are counted by the calling thread alone. */
+#define AC_COUNT_SORT_PARALLEL_MIN 262144U
+
+/** Minimum number of elements counted by one block task. */
+#define AC_COUNT_SORT_BLOCK 65536U
+
+typedef struct {
+    const int *data;
+    int *out;
+    size_t size;
+    int min_value;
+    size_t range;
+    size_t block_size;
+    size_t block_count;
+    /** ``block_count * range`` per-block counts, block-major. */
+    size_t *block_counts;
+    /** Totals per value. */
+    size_t *counts;
+    /** ``block_count + 1`` value boundaries of the fill slices. */
+    size_t *slice_bounds;
+    /** Output index of the first value of every fill slice. */
+    size_t *slice_starts;
+} ac_count_sort_state;
+
+static size_t value_slot(int value, int min_value) {
+    return (size_t)((unsigned)value - (unsigned)min_value);
+}
+
+/** Add the counts of ``size`` elements to ``counts``. */
+static void count_values(
+    const int *data,
     size_t size,
     int min_value,
-    int max_value
+    size_t range,
+    size_t *counts
 ) {
-    if (data == NULL || size == 0) {
+    uint32_t *sub = NULL;
+    if (range <= AC_COUNT_SORT_SUB_RANGE) {
+        sub = (uint32_t *)calloc(
+            AC_COUNT_SORT_SUB_HISTOGRAMS * range, sizeof(uint32_t)
+        );
+    }
+    if (sub == NULL) {
+        for (size_t i = 0; i < size; ++i) {
+            ++counts[value_slot(data[i], min_value)];
+        }
         return;
     }
+    uint32_t *sub0 = sub;
+    uint32_t *sub1 = sub0 + range;
+    uint32_t *sub2 = sub1 + range;
+    uint32_t *sub3 = sub2 + range;
+    while (size != 0) {
+        size_t chunk = size < AC_COUNT_SORT_CHUNK ? size : AC_COUNT_SORT_CHUNK;
+        size_t i = 0;
+        for (; i + 4U <= chunk; i += 4U) {
+            ++sub0[value_slot(data[i], min_value)];
+            ++sub1[value_slot(data[i + 1U], min_value)];
+            ++sub2[value_slot(data[i + 2U], min_value)];
+            ++sub3[value_slot(data[i + 3U], min_value)];
+        }
+        for (; i < chunk; ++i) {
+            ++sub0[value_slot(data[i], min_value)];
+        }
+        for (size_t value = 0; value < range; ++value) {
+            counts[value] += (size_t)sub0[value] + sub1[value] + sub2[value] +
+                             sub3[value];
+        }
+        memset(sub, 0, AC_COUNT_SORT_SUB_HISTOGRAMS * range * sizeof(uint32_t));
+        data += chunk;
+        size -= chunk;
+    }
+    free(sub);
+}
+
+/** Write ``counts[v]`` copies of every value ``v`` in ``[first, last)``. */
+static void fill_values(
+    int *out,
+    const size_t *counts,
+    size_t first,
+    size_t last,
+    int min_value
+) {
+    for (size_t slot = first; slot < last; ++slot) {
+        int value = (int)((unsigned)min_value + (unsigned)slot);
+        size_t count = counts[slot];
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = value;
+        }
+        out += count;
+    }
+}
+
+static void count_block(void *context, size_t block) {
+    ac_count_sort_state *state = (ac_count_sort_state *)context;
+    size_t begin = block * state->block_size;
+    size_t end = begin + state->block_size;
+    if (end > state->size) {
+        end = state->size;
+    }
+    count_values(
+        state->data + begin, end - begin, state->min_value, state->range,
+        state->block_counts + (block * state->range)
+    );
+}
+
+/** Sum the per-block counts of value slice ``slice``. */
+static void sum_slice(void *context, size_t slice) {
+    ac_count_sort_state *state = (ac_count_sort_state *)context;
+    size_t width = (state->range + state->block_count - 1U) /
+                   state->block_count;
+    size_t first = slice * width;
+    size_t last = first + width < state->range ? first + width : state->range;
+    for (size_t value = first; value < last; ++value) {
+        size_t total = 0;
+        for (size_t block = 0; block < state->block_count; ++block) {
+            total += state->block_counts[(block * state->range) + value];
+        }
+        state->counts[value] = total;
+    }
+}
 
+static void fill_slice(void *context, size_t slice) {
+    ac_count_sort_state *state = (ac_count_sort_state *)context;
+    fill_values(
+        state->out + state->slice_starts[slice], state->counts,
+        state->slice_bounds[slice], state->slice_bounds[slice + 1U],
+        state->min_value
+    );
+}
+
+/** Count ``state->data`` with one histogram per block; ``0`` on failure. */
+static int count_parallel(ac_count_sort_state *state, size_t threads) {
+    state->block_counts = (size_t *)calloc(
+        state->block_count * state->range, sizeof(size_t)
+    );
+    state->slice_bounds =
+        (size_t *)malloc((state->block_count + 1U) * sizeof(size_t));
+    state->slice_starts =
+        (size_t *)malloc(state->block_count * sizeof(size_t));
+    if (state->block_counts == NULL || state->slice_bounds == NULL ||
+        state->slice_starts == NULL) {
+        free(state->block_counts);
+        free(state->slice_bounds);
+        free(state->slice_starts);
+        return 0;
+    }
+
+    ac_parallel_for(state->block_count, threads, count_block, state);
+    ac_parallel_for(state->block_count, threads, sum_slice, state);
+    free(state->block_counts);
+
+    // Cut the value range where the running output size passes each share.
+    size_t share = (state->size + state->block_count - 1U) /
+                   state->block_count;
+    size_t slice = 0;
+    size_t position = 0;
+    state->slice_bounds[0] = 0;
+    state->slice_starts[0] = 0;
+    for (size_t value = 0; value < state->range; ++value) {
+        position += state->counts[value];
+        if (position >= share * (slice + 1U) &&
+            slice + 1U < state->block_count) {
+            ++slice;
+            state->slice_bounds[slice] = value + 1U;
+            state->slice_starts[slice] = position;
+        }
+    }
+    for (size_t rest = slice + 1U; rest <= state->block_count; ++rest) {
+        state->slice_bounds[rest] = state->range;
+        if (rest < state->block_count) {
+            state->slice_starts[rest] = state->size;
+        }
+    }
+
+    ac_parallel_for(state->block_count, threads, fill_slice, state);
+    free(state->slice_bounds);
+    free(state->slice_starts);
+    return 1;
+}
+
+void ac_counting_sort_int_parallel(
+    int *data,
+    size_t size,
+    int min_value,
+    int max_value,
+    size_t threads
+) {
+    if (data == NULL || size < 2U) {
+        return;
+    }
     if (min_value > max_value) {
         int tmp = min_value;
         min_value = max_value;
         max_value = tmp;
     }
 
-    size_t range = (size_t)(max_value - min_value + 1);
-    size_t *counts = (size_t *)calloc(range, sizeof(size_t));
-    if (counts == NULL) {
+    uint64_t wide_range =
+        (uint64_t)((unsigned)max_value - (unsigned)min_value) + 1U;
+    if (wide_range > AC_COUNT_SORT_SUB_RANGE && wide_range / 2U > size) {
+        ac_digit_sort_opt_int(data, size, 10);
         return;
     }
 
-    for (size_t i = 0; i < size; ++i) {
-        counts[data[i] - min_value]++;
-    }
+    ac_count_sort_state state;
+    state.data = data;
+    state.out = data;
+    state.size = size;
+    state.min_value = min_value;
+    state.range = (size_t)wide_range;
 
-    size_t index = 0;
-    for (size_t value = 0; value < range; ++value) {
-        for (size_t repeat = 0; repeat < counts[value]; ++repeat) {
-            data[index++] = (int)(value + min_value);
+    if (threads == 0) {
+        threads = ac_parallel_hardware_threads();
+    }
+    state.block_count = 1U;
+    if (threads >= 2U && size >= AC_COUNT_SORT_PARALLEL_MIN) {
+        state.block_count = threads;
+        if (state.block_count > size / AC_COUNT_SORT_BLOCK) {
+            state.block_count = size / AC_COUNT_SORT_BLOCK;
+        }
+        // Keep the per-block histograms no larger than the input.
+        while (state.block_count > 1U &&
+               state.block_count * state.range > size) {
+            --state.block_count;
         }
     }
+    state.block_size = (size + state.block_count - 1U) / state.block_count;
 
-    free(counts);
+    state.counts = (size_t *)calloc(state.range, sizeof(size_t));
+    if (state.counts == NULL) {
+        ac_digit_sort_opt_int(data, size, 10);
+        return;
+    }
+    if (state.block_count < 2U || !count_parallel(&state, threads)) {
+        count_values(data, size, min_value, state.range, state.counts);
+        fill_values(data, state.counts, 0, state.range, min_value);
+    }
+    free(state.counts);
+}
+
+void ac_counting_sort_int(
+    int *data,
+    size_t size,
+    int min_value,
+    int max_value
+) {
+    ac_counting_sort_int_parallel(data, size, min_value, max_value, 1U);
 }
 
 void ac_count_sort_int_auto(int *data, size_t size) {
@@ -54,5 +299,5 @@ void ac_count_sort_int_auto(int *data, size_t size) {
         }
     }
 
-    ac_counting_sort_int(data, size, min_value, max_value);
+    ac_counting_sort_int_parallel(data, size, min_value, max_value, 0U);
 }
@@ -1,4 +1,5 @@
 #include "algorithms_c/algorithms/damerau_levenshtein.h"
+#include <errno.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -9,62 +10,134 @@ static size_t min3(size_t a, size_t b, size_t c) {
     return m < c ? m : c;
 }
 
-int ac_damerau_levenshtein_distance(const char *lhs, const char *rhs) {
-    if (lhs == NULL || rhs == NULL) {
-        return -1;
+/**
+ * Optimal-string-alignment distance using three rolling rows of ``cols``
+ * cells each: the transposition rule only looks two rows back.
+ */
+static size_t distance_with_rows(
+    const char *lhs,
+    size_t lhs_len,
+    const char *rhs,
+    size_t rhs_len,
+    size_t *rows
+) {
+    size_t cols = rhs_len + 1;
+    size_t *before = rows;
+    size_t *previous = rows + cols;
+    size_t *current = rows + (2U * cols);
+
+    for (size_t j = 0; j < cols; ++j) {
+        previous[j] = j;
     }
 
-    size_t lhs_len = strlen(lhs);
-    size_t rhs_len = strlen(rhs);
+    for (size_t i = 1; i <= lhs_len; ++i) {
+        current[0] = i;
+        for (size_t j = 1; j < cols; ++j) {
+            size_t cost = lhs[i - 1] == rhs[j - 1] ? 0U : 1U;
+            current[j] = min3(
+                previous[j] + 1U, current[j - 1] + 1U, previous[j - 1] + cost
+            );
 
-    if (lhs_len > SIZE_MAX - 1 || rhs_len > SIZE_MAX - 1) {
-        return -1;
+            if (i > 1 && j > 1 && lhs[i - 1] == rhs[j - 2] &&
+                lhs[i - 2] == rhs[j - 1]) {
+                size_t transposition = before[j - 2] + 1U;
+                if (transposition < current[j]) {
+                    current[j] = transposition;
+                }
+            }
+        }
+
+        size_t *recycled = before;
+        before = previous;
+        previous = current;
+        current = recycled;
     }
 
-    size_t rows = lhs_len + 1;
-    size_t cols = rhs_len + 1;
+    return previous[rhs_len];
+}
+
+/**
+ * Measure both strings and order them so the shorter one indexes the
+ * columns; the distance is symmetric.  Returns ``0`` when the row buffer size
+ * overflows.
+ */
+static int prepare_operands(
+    const char **lhs,
+    size_t *lhs_len,
+    const char **rhs,
+    size_t *rhs_len
+) {
+    *lhs_len = strlen(*lhs);
+    *rhs_len = strlen(*rhs);
+    if (*rhs_len > *lhs_len) {
+        const char *text = *lhs;
+        size_t length = *lhs_len;
+        *lhs = *rhs;
+        *lhs_len = *rhs_len;
+        *rhs = text;
+        *rhs_len = length;
+    }
+    return *rhs_len < (SIZE_MAX / (3U * sizeof(size_t))) - 1U;
+}
+
+int ac_damerau_levenshtein_distance(const char *lhs, const char *rhs) {
+    if (lhs == NULL || rhs == NULL) {
+        return -1;
+    }
 
-    if (rows > SIZE_MAX / cols || rows * cols > SIZE_MAX / sizeof(size_t)) {
+    size_t lhs_len;
+    size_t rhs_len;
+    if (!prepare_operands(&lhs, &lhs_len, &rhs, &rhs_len)) {
         return -1;
     }
 
-    size_t cell_count = rows * cols;
-    size_t *dp = (size_t *)malloc(cell_count * sizeof(size_t));
-    if (dp == NULL) {
+    size_t *rows = (size_t *)malloc(3U * (rhs_len + 1) * sizeof(size_t));
+    if (rows == NULL) {
         return -1;
     }
 
-#define DP(i, j) dp[((i) * cols) + (j)]
+    size_t distance = distance_with_rows(lhs, lhs_len, rhs, rhs_len, rows);
+    free(rows);
 
-    for (size_t i = 0; i < rows; ++i) {
-        DP(i, 0) = i;
+    if (distance > (size_t)INT32_MAX) {
+        return -1;
     }
-    for (size_t j = 0; j < cols; ++j) {
-        DP(0, j) = j;
+    return (int)distance;
+}
+
+size_t ac_damerau_levenshtein_workspace_bytes(size_t lhs_len, size_t rhs_len) {
+    size_t shorter = lhs_len < rhs_len ? lhs_len : rhs_len;
+    if (shorter >= (SIZE_MAX / (3U * sizeof(size_t))) - 1U) {
+        return SIZE_MAX;
     }
+    return (3U * (shorter + 1) * sizeof(size_t)) + _Alignof(size_t) - 1U;
+}
 
-    for (size_t i = 1; i < rows; ++i) {
-        for (size_t j = 1; j < cols; ++j) {
-            size_t cost = lhs[i - 1] == rhs[j - 1] ? 0U : 1U;
-            DP(i, j) = min3(
-                DP(i - 1, j) + 1U, DP(i, j - 1) + 1U, DP(i - 1, j - 1) + cost
-            );
+int ac_damerau_levenshtein_distance_ws(
+    ac_sort_workspace *workspace,
+    const char *lhs,
+    const char *rhs
+) {
+    if (workspace == NULL || lhs == NULL || rhs == NULL) {
+        return -EINVAL;
+    }
 
-            if (i > 1 && j > 1 && lhs[i - 1] == rhs[j - 2] &&
-                lhs[i - 2] == rhs[j - 1]) {
-                size_t transposition = DP(i - 2, j - 2) + 1U;
-                if (transposition < DP(i, j)) {
-                    DP(i, j) = transposition;
-                }
-            }
-        }
+    size_t lhs_len;
+    size_t rhs_len;
+    if (!prepare_operands(&lhs, &lhs_len, &rhs, &rhs_len)) {
+        return -ENOSPC;
     }
 
-    size_t distance = DP(lhs_len, rhs_len);
-    free(dp);
+    size_t *rows = (size_t *)ac_sort_workspace_reserve(
+        workspace, 3U * (rhs_len + 1), sizeof(size_t), _Alignof(size_t)
+    );
+    if (rows == NULL) {
+        return -ENOSPC;
+    }
 
+    size_t distance = distance_with_rows(lhs, lhs_len, rhs, rhs_len, rows);
     if (distance > (size_t)INT32_MAX) {
-        return -1;
+        return -ERANGE;
     }
     return (int)distance;
 }
@@ -0,0 +1,661 @@
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+
+#include "algorithms_c/algorithms/external_sort.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "algorithms_c/algorithms/kway_merge.h"
+#include "algorithms_c/algorithms/sort_workspace.h"
+
+#ifdef AC_HAVE_PTHREADS
+#include <pthread.h>
+#endif
+
+/** Buffers of at least this many bytes are aligned to (and sized in) it. */
+#define AC_EXTERNAL_ALIGNMENT 4096U
+
+/** Read buffers are not shrunk below this size to raise the fan-in. */
+#define AC_EXTERNAL_MIN_BLOCK 4096U
+
+/** Upper bound on runs merged at once; more would only deepen the tree. */
+#define AC_EXTERNAL_MAX_FAN_IN 1024U
+
+typedef struct {
+    /** Byte offset of the run in its file. */
+    uint64_t offset;
+    /** Number of records in the run. */
+    uint64_t count;
+} ac_external_run;
+
+/**
+ * Two-buffer reader over one run.  The merge consumes ``buffer[active]``
+ * while the other buffer is refilled; ``pending`` is set while a refill is
+ * queued or in progress, and only the filling side touches the inactive
+ * buffer, ``next_offset``, ``unread`` and ``status`` during that time.
+ */
+typedef struct {
+    int fd;
+    size_t element_size;
+    size_t capacity;
+    unsigned char *buffer[2];
+    size_t filled[2];
+    int active;
+    int fill_target;
+    off_t next_offset;
+    uint64_t unread;
+    int pending;
+    int status;
+} ac_run_reader;
+
+/** Background thread serving refill requests in FIFO order. */
+typedef struct {
+    int running;
+#ifdef AC_HAVE_PTHREADS
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    pthread_t thread;
+    int stop;
+    ac_run_reader **queue;
+    size_t queue_capacity;
+    size_t head;
+    size_t count;
+#endif
+} ac_prefetcher;
+
+/** Context of ``reader_refill``: the readers of one merge and their thread. */
+typedef struct {
+    ac_run_reader *readers;
+    ac_prefetcher *prefetcher;
+} ac_run_merge;
+
+static int read_fully(
+    int fd,
+    void *buffer,
+    size_t bytes,
+    off_t offset,
+    size_t *out_read
+) {
+    unsigned char *bytes_out = (unsigned char *)buffer;
+    size_t done = 0;
+    while (done < bytes) {
+        ssize_t got = offset < 0
+                          ? read(fd, bytes_out + done, bytes - done)
+                          : pread(
+                                fd, bytes_out + done, bytes - done,
+                                offset + (off_t)done
+                            );
+        if (got < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -errno;
+        }
+        if (got == 0) {
+            break;
+        }
+        done += (size_t)got;
+    }
+    *out_read = done;
+    return 0;
+}
+
+static int write_fully(int fd, const void *buffer, size_t bytes, off_t offset) {
+    const unsigned char *bytes_in = (const unsigned char *)buffer;
+    size_t done = 0;
+    while (done < bytes) {
+        ssize_t put =
+            pwrite(fd, bytes_in + done, bytes - done, offset + (off_t)done);
+        if (put < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -errno;
+        }
+        if (put == 0) {
+            return -EIO;
+        }
+        done += (size_t)put;
+    }
+    return 0;
+}
+
+/** Create an anonymous file in ``$TMPDIR`` that disappears when closed. */
+static int open_temp_file(int *out_fd) {
+    static const char kTemplate[] = "/ac_external_sort_XXXXXX";
+    const char *directory = getenv("TMPDIR");
+    if (directory == NULL || directory[0] == '\0') {
+        directory = "/tmp";
+    }
+
+    size_t length = strlen(directory);
+    char *path = (char *)malloc(length + sizeof(kTemplate));
+    if (path == NULL) {
+        return -ENOMEM;
+    }
+    memcpy(path, directory, length);
+    memcpy(path + length, kTemplate, sizeof(kTemplate));
+
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        int status = -errno;
+        free(path);
+        return status;
+    }
+    unlink(path);
+    free(path);
+    *out_fd = fd;
+    return 0;
+}
+
+/** Largest multiple of ``element_size`` (and of a page, when possible). */
+static size_t block_bytes(size_t share, size_t element_size) {
+    if (share >= AC_EXTERNAL_ALIGNMENT) {
+        share -= share % AC_EXTERNAL_ALIGNMENT;
+    }
+    return share - (share % element_size);
+}
+
+static size_t aligned_stride(size_t bytes) {
+    if (bytes < AC_EXTERNAL_ALIGNMENT) {
+        return bytes;
+    }
+    return (bytes + AC_EXTERNAL_ALIGNMENT - 1U) &
+           ~(size_t)(AC_EXTERNAL_ALIGNMENT - 1U);
+}
+
+static void *allocate_block(size_t bytes) {
+    if (bytes >= AC_EXTERNAL_ALIGNMENT) {
+        return aligned_alloc(AC_EXTERNAL_ALIGNMENT, aligned_stride(bytes));
+    }
+    return malloc(bytes);
+}
+
+static void fill_buffer(ac_run_reader *reader) {
+    int target = reader->fill_target;
+    uint64_t records = reader->unread < reader->capacity
+                           ? reader->unread
+                           : (uint64_t)reader->capacity;
+    size_t bytes = (size_t)records * reader->element_size;
+    size_t got = 0;
+    int status = read_fully(
+        reader->fd, reader->buffer[target], bytes, reader->next_offset, &got
+    );
+    if (status == 0 && got != bytes) {
+        status = -EIO;
+    }
+    reader->filled[target] = status == 0 ? (size_t)records : 0U;
+    reader->next_offset += (off_t)bytes;
+    reader->unread -= records;
+    if (status != 0) {
+        reader->status = status;
+    }
+}
+
+#ifdef AC_HAVE_PTHREADS
+
+static void *prefetch_main(void *arg) {
+    ac_prefetcher *prefetcher = (ac_prefetcher *)arg;
+    pthread_mutex_lock(&prefetcher->lock);
+    for (;;) {
+        while (prefetcher->count == 0 && !prefetcher->stop) {
+            pthread_cond_wait(&prefetcher->changed, &prefetcher->lock);
+        }
+        if (prefetcher->count == 0) {
+            break;
+        }
+        ac_run_reader *reader = prefetcher->queue[prefetcher->head];
+        prefetcher->head = (prefetcher->head + 1U) % prefetcher->queue_capacity;
+        --prefetcher->count;
+        pthread_mutex_unlock(&prefetcher->lock);
+
+        fill_buffer(reader);
+
+        pthread_mutex_lock(&prefetcher->lock);
+        reader->pending = 0;
+        pthread_cond_broadcast(&prefetcher->changed);
+    }
+    pthread_mutex_unlock(&prefetcher->lock);
+    return NULL;
+}
+
+#endif
+
+/**
+ * Start the prefetch thread for up to ``readers`` runs.  Failure is not an
+ * error: refills then happen synchronously.
+ */
+static void prefetcher_start(
+    ac_prefetcher *prefetcher,
+    ac_run_reader **queue,
+    size_t readers
+) {
+    prefetcher->running = 0;
+#ifdef AC_HAVE_PTHREADS
+    prefetcher->stop = 0;
+    prefetcher->queue = queue;
+    prefetcher->queue_capacity = readers;
+    prefetcher->head = 0;
+    prefetcher->count = 0;
+    if (pthread_mutex_init(&prefetcher->lock, NULL) != 0) {
+        return;
+    }
+    if (pthread_cond_init(&prefetcher->changed, NULL) != 0) {
+        pthread_mutex_destroy(&prefetcher->lock);
+        return;
+    }
+    if (pthread_create(
+            &prefetcher->thread, NULL, prefetch_main, prefetcher
+        ) != 0) {
+        pthread_cond_destroy(&prefetcher->changed);
+        pthread_mutex_destroy(&prefetcher->lock);
+        return;
+    }
+    prefetcher->running = 1;
+#else
+    (void)queue;
+    (void)readers;
+#endif
+}
+
+/** Finish queued refills and join the thread. */
+static void prefetcher_stop(ac_prefetcher *prefetcher) {
+#ifdef AC_HAVE_PTHREADS
+    if (!prefetcher->running) {
+        return;
+    }
+    pthread_mutex_lock(&prefetcher->lock);
+    prefetcher->stop = 1;
+    pthread_cond_broadcast(&prefetcher->changed);
+    pthread_mutex_unlock(&prefetcher->lock);
+    pthread_join(prefetcher->thread, NULL);
+    pthread_cond_destroy(&prefetcher->changed);
+    pthread_mutex_destroy(&prefetcher->lock);
+    prefetcher->running = 0;
+#else
+    (void)prefetcher;
+#endif
+}
+
+/** Refill the inactive buffer of ``reader``, in the background if possible. */
+static void request_refill(ac_prefetcher *prefetcher, ac_run_reader *reader) {
+    reader->fill_target = 1 - reader->active;
+#ifdef AC_HAVE_PTHREADS
+    if (prefetcher->running) {
+        pthread_mutex_lock(&prefetcher->lock);
+        reader->pending = 1;
+        size_t tail = (prefetcher->head + prefetcher->count) %
+                      prefetcher->queue_capacity;
+        prefetcher->queue[tail] = reader;
+        ++prefetcher->count;
+        pthread_cond_broadcast(&prefetcher->changed);
+        pthread_mutex_unlock(&prefetcher->lock);
+        return;
+    }
+#else
+    (void)prefetcher;
+#endif
+    fill_buffer(reader);
+}
+
+static void wait_for_refill(ac_prefetcher *prefetcher, ac_run_reader *reader) {
+#ifdef AC_HAVE_PTHREADS
+    if (prefetcher->running) {
+        pthread_mutex_lock(&prefetcher->lock);
+        while (reader->pending) {
+            pthread_cond_wait(&prefetcher->changed, &prefetcher->lock);
+        }
+        pthread_mutex_unlock(&prefetcher->lock);
+    }
+#else
+    (void)prefetcher;
+    (void)reader;
+#endif
+}
+
+/**
+ * Hand the next buffer of run ``input`` to the merge cursor: wait for its
+ * refill, switch buffers and queue the refill of the one just drained.
+ */
+static int reader_refill(void *context, size_t input, ac_merge_span *span) {
+    ac_run_merge *merge = (ac_run_merge *)context;
+    ac_run_reader *reader = &merge->readers[input];
+
+    wait_for_refill(merge->prefetcher, reader);
+    if (reader->status != 0) {
+        return reader->status;
+    }
+    reader->filled[reader->active] = 0;
+    reader->active = 1 - reader->active;
+    if (reader->filled[reader->active] != 0 && reader->unread != 0) {
+        request_refill(merge->prefetcher, reader);
+    }
+    span->data = reader->buffer[reader->active];
+    span->size = reader->filled[reader->active];
+    return 0;
+}
+
+typedef struct {
+    size_t element_size;
+    ac_compare_fn compare;
+    /** Readers and their buffers for up to ``fan_in`` runs. */
+    size_t fan_in;
+    ac_run_reader *readers;
+    ac_run_reader **queue;
+    unsigned char *arena;
+    size_t block;
+    size_t stride;
+} ac_external_merger;
+
+/** Merge ``count`` runs of ``src_fd`` into ``dst_fd`` at ``dst_offset``. */
+static int merge_runs(
+    ac_external_merger *merger,
+    int src_fd,
+    const ac_external_run *runs,
+    size_t count,
+    int dst_fd,
+    uint64_t dst_offset
+) {
+    size_t element_size = merger->element_size;
+    ac_prefetcher prefetcher;
+    prefetcher_start(&prefetcher, merger->queue, count);
+
+    int status = 0;
+    for (size_t i = 0; i < count && status == 0; ++i) {
+        ac_run_reader *reader = &merger->readers[i];
+        reader->fd = src_fd;
+        reader->element_size = element_size;
+        reader->capacity = merger->block / element_size;
+        reader->buffer[0] = merger->arena + ((2U * i) * merger->stride);
+        reader->buffer[1] = reader->buffer[0] + merger->stride;
+        reader->filled[0] = 0;
+        reader->filled[1] = 0;
+        // The cursor's first refill switches to buffer 0.
+        reader->active = 1;
+        reader->fill_target = 0;
+        reader->next_offset = (off_t)runs[i].offset;
+        reader->unread = runs[i].count;
+        reader->pending = 0;
+        reader->status = 0;
+
+        fill_buffer(reader);
+        status = reader->status;
+    }
+
+    ac_run_merge merge = {merger->readers, &prefetcher};
+    ac_kway_cursor cursor;
+    if (status == 0) {
+        status = ac_kway_cursor_init_refill(
+            &cursor, count, element_size, merger->compare, reader_refill,
+            &merge
+        );
+    }
+    if (status == 0) {
+        unsigned char *output =
+            merger->arena + ((2U * count) * merger->stride);
+        size_t output_capacity = merger->block / element_size;
+        off_t output_offset = (off_t)dst_offset;
+        size_t output_fill = output_capacity;
+        while (status == 0 && output_fill == output_capacity) {
+            status = ac_kway_cursor_next(
+                &cursor, output, output_capacity, &output_fill
+            );
+            if (status == 0 && output_fill != 0) {
+                status = write_fully(
+                    dst_fd, output, output_fill * element_size, output_offset
+                );
+                output_offset += (off_t)(output_fill * element_size);
+            }
+        }
+        ac_kway_cursor_destroy(&cursor);
+    }
+
+    prefetcher_stop(&prefetcher);
+    return status;
+}
+
+/** Sort chunks of the input into runs; see the stage list in the header. */
+static int generate_runs(
+    int in_fd,
+    const char *out_path,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t memory_budget,
+    int *run_fd,
+    ac_external_run **out_runs,
+    size_t *out_run_count,
+    int *out_done
+) {
+    size_t chunk_bytes = block_bytes((memory_budget / 3U) * 2U, element_size);
+    size_t workspace_bytes = memory_budget - aligned_stride(chunk_bytes);
+    unsigned char *chunk = (unsigned char *)allocate_block(chunk_bytes);
+    ac_sort_workspace workspace;
+    int status = ac_sort_workspace_init(&workspace, workspace_bytes);
+    if (chunk == NULL || status != 0) {
+        free(chunk);
+        ac_sort_workspace_destroy(&workspace);
+        return -ENOMEM;
+    }
+
+    ac_external_run *runs = NULL;
+    size_t run_count = 0;
+    size_t run_capacity = 0;
+    uint64_t run_offset = 0;
+    for (;;) {
+        size_t got = 0;
+        status = read_fully(in_fd, chunk, chunk_bytes, -1, &got);
+        if (status != 0) {
+            break;
+        }
+        if (got % element_size != 0) {
+            status = -EINVAL;
+            break;
+        }
+        if (got == 0 && run_count != 0) {
+            break;
+        }
+
+        size_t records = got / element_size;
+        status = ac_tim_sort_ws(
+            &workspace, chunk, records, element_size, compare
+        );
+        if (status != 0) {
+            break;
+        }
+
+        if (run_count == 0 && got < chunk_bytes) {
+            // Everything fit in one chunk: skip the temporary files.
+            int out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+            if (out_fd < 0) {
+                status = -errno;
+                break;
+            }
+            status = write_fully(out_fd, chunk, got, 0);
+            if (close(out_fd) != 0 && status == 0) {
+                status = -errno;
+            }
+            *out_done = 1;
+            break;
+        }
+
+        if (run_count == run_capacity) {
+            size_t capacity = run_capacity == 0 ? 16U : run_capacity * 2U;
+            ac_external_run *grown = (ac_external_run *)realloc(
+                runs, capacity * sizeof(ac_external_run)
+            );
+            if (grown == NULL) {
+                status = -ENOMEM;
+                break;
+            }
+            runs = grown;
+            run_capacity = capacity;
+        }
+        if (*run_fd < 0) {
+            status = open_temp_file(run_fd);
+            if (status != 0) {
+                break;
+            }
+        }
+        status = write_fully(*run_fd, chunk, got, (off_t)run_offset);
+        if (status != 0) {
+            break;
+        }
+        runs[run_count].offset = run_offset;
+        runs[run_count].count = records;
+        ++run_count;
+        run_offset += got;
+
+        if (got < chunk_bytes) {
+            break;
+        }
+    }
+
+    free(chunk);
+    ac_sort_workspace_destroy(&workspace);
+    *out_runs = runs;
+    *out_run_count = run_count;
+    return status;
+}
+
+/** Merge ``runs`` (in ``*run_fd``) down to ``out_path``. */
+static int merge_all_runs(
+    ac_external_merger *merger,
+    const char *out_path,
+    int *run_fd,
+    int *spare_fd,
+    ac_external_run *runs,
+    size_t run_count
+) {
+    int status = 0;
+    size_t fan_in = merger->fan_in;
+    while (run_count > fan_in) {
+        if (*spare_fd < 0) {
+            status = open_temp_file(spare_fd);
+        } else if (ftruncate(*spare_fd, 0) != 0) {
+            status = -errno;
+        }
+        if (status != 0) {
+            return status;
+        }
+
+        size_t merged_count = 0;
+        uint64_t offset = 0;
+        for (size_t first = 0; first < run_count; first += fan_in) {
+            size_t group = run_count - first < fan_in ? run_count - first
+                                                       : fan_in;
+            uint64_t records = 0;
+            for (size_t i = 0; i < group; ++i) {
+                records += runs[first + i].count;
+            }
+            status = merge_runs(
+                merger, *run_fd, runs + first, group, *spare_fd, offset
+            );
+            if (status != 0) {
+                return status;
+            }
+            // ``merged_count <= first``, so the group was already consumed.
+            runs[merged_count].offset = offset;
+            runs[merged_count].count = records;
+            ++merged_count;
+            offset += records * merger->element_size;
+        }
+
+        run_count = merged_count;
+        int swap = *run_fd;
+        *run_fd = *spare_fd;
+        *spare_fd = swap;
+    }
+
+    int out_fd = open(out_path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if (out_fd < 0) {
+        return -errno;
+    }
+    status = merge_runs(merger, *run_fd, runs, run_count, out_fd, 0);
+    if (close(out_fd) != 0 && status == 0) {
+        status = -errno;
+    }
+    return status;
+}
+
+int ac_external_sort(
+    const char *in_path,
+    const char *out_path,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t memory_budget
+) {
+    if (in_path == NULL || out_path == NULL || compare == NULL ||
+        element_size == 0 || memory_budget / 6U < element_size) {
+        return -EINVAL;
+    }
+
+    int in_fd = open(in_path, O_RDONLY);
+    if (in_fd < 0) {
+        return -errno;
+    }
+
+    int run_fd = -1;
+    int spare_fd = -1;
+    ac_external_run *runs = NULL;
+    size_t run_count = 0;
+    int done = 0;
+    int status = generate_runs(
+        in_fd, out_path, element_size, compare, memory_budget, &run_fd, &runs,
+        &run_count, &done
+    );
+    close(in_fd);
+
+    if (status == 0 && !done) {
+        // Each merged run needs two blocks and the output one more.
+        size_t min_block = element_size > AC_EXTERNAL_MIN_BLOCK
+                               ? element_size
+                               : AC_EXTERNAL_MIN_BLOCK;
+        size_t fan_in = ((memory_budget / min_block) - 1U) / 2U;
+        if (memory_budget / min_block < 5U) {
+            fan_in = 2U;
+        }
+        if (fan_in > AC_EXTERNAL_MAX_FAN_IN) {
+            fan_in = AC_EXTERNAL_MAX_FAN_IN;
+        }
+
+        ac_external_merger merger;
+        merger.element_size = element_size;
+        merger.compare = compare;
+        merger.fan_in = fan_in;
+        merger.block =
+            block_bytes(memory_budget / ((2U * fan_in) + 1U), element_size);
+        merger.stride = aligned_stride(merger.block);
+        merger.arena = (unsigned char *)allocate_block(
+            merger.stride * ((2U * fan_in) + 1U)
+        );
+        merger.readers =
+            (ac_run_reader *)malloc(fan_in * sizeof(ac_run_reader));
+        merger.queue =
+            (ac_run_reader **)malloc(fan_in * sizeof(ac_run_reader *));
+
+        if (merger.arena == NULL || merger.readers == NULL ||
+            merger.queue == NULL) {
+            status = -ENOMEM;
+        } else {
+            status = merge_all_runs(
+                &merger, out_path, &run_fd, &spare_fd, runs, run_count
+            );
+        }
+        free(merger.arena);
+        free(merger.readers);
+        free(merger.queue);
+    }
+
+    if (run_fd >= 0) {
+        close(run_fd);
+    }
+    if (spare_fd >= 0) {
+        close(spare_fd);
+    }
+    free(runs);
+    return status;
+}
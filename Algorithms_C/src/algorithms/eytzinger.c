@@ -0,0 +1,241 @@
+#include "algorithms_c/algorithms/eytzinger.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/utils/instrument.h"
+
+/*
+ * Node ``k`` of the implicit tree sits at depth ``floor(log2 k)``.  With
+ * ``size`` nodes the tree has ``levels = floor(log2 size) + 1`` levels and
+ * only the last one is partially filled, from the left.  Both the build and
+ * the queries need the in-order rank of a node, i.e. its position in the
+ * sorted table:
+ *
+ * - in the perfect tree of ``levels`` levels, node ``k`` at depth ``d`` has
+ *   rank ``(2 (k - 2^d) + 1) 2^(levels - 1 - d) - 1``;
+ * - the last-level slot ``j`` of that perfect tree has rank ``2j``, and the
+ *   slots from ``j = last`` (the number of real last-level nodes) on are
+ *   missing, so every missing slot with a smaller perfect rank shifts the
+ *   real rank down by one.
+ *
+ * A query walks ``k = 2k + (node k < target)`` until it falls off the tree.
+ * The last node where the walk went left is the answer; it is recovered by
+ * dropping the trailing right turns (one bits) and the final left turn.
+ */
+
+/** Nodes start on a cache-line boundary so blocks of descendants align. */
+#define AC_EYTZINGER_ALIGNMENT 64U
+
+/** Levels between a node and the descendants prefetched for it. */
+#define AC_EYTZINGER_PREFETCH_LEVELS 4U
+
+/**
+ * Nodes allocated past the last one, so that a prefetch of a block of
+ * descendants never points outside the allocation.
+ */
+#define AC_EYTZINGER_PADDING 16U
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AC_EYTZINGER_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define AC_EYTZINGER_PREFETCH(address) ((void)(address))
+#endif
+
+/** ``floor(log2 value)`` for a non-zero ``value``. */
+static unsigned floor_log2(size_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)(sizeof(unsigned long long) * CHAR_BIT) - 1U -
+           (unsigned)__builtin_clzll((unsigned long long)value);
+#else
+    unsigned log = 0;
+    while (value > 1U) {
+        value >>= 1U;
+        ++log;
+    }
+    return log;
+#endif
+}
+
+/** Position in the sorted table of node ``k`` of a ``size``-node tree. */
+static size_t inorder_rank(size_t k, size_t size) {
+    unsigned levels = floor_log2(size) + 1U;
+    unsigned depth = floor_log2(k);
+    size_t first_of_depth = (size_t)1U << depth;
+    size_t perfect = ((((k - first_of_depth) * 2U) + 1U)
+                      << (levels - 1U - depth)) -
+                     1U;
+    size_t last = size - (((size_t)1U << (levels - 1U)) - 1U);
+    size_t slots_before = (perfect + 1U) / 2U;
+    return slots_before > last ? perfect - (slots_before - last) : perfect;
+}
+
+/** Rank of the answer once the walk has left the tree at ``k``. */
+static size_t rank_after_walk(size_t k, size_t size) {
+    while ((k & 1U) != 0U) {
+        k >>= 1U;
+    }
+    k >>= 1U;
+    return k == 0 ? size : inorder_rank(k, size);
+}
+
+/** Node whose descendants four levels down are prefetched at node ``k``. */
+static size_t prefetch_node(size_t k, size_t size) {
+    size_t ahead = k << AC_EYTZINGER_PREFETCH_LEVELS;
+    return ahead <= size ? ahead : 0U;
+}
+
+static int compare_double_values(const void *lhs, const void *rhs) {
+    double left = *(const double *)lhs;
+    double right = *(const double *)rhs;
+    return (left > right) - (left < right);
+}
+
+int ac_eytzinger_init(
+    ac_eytzinger_index *index,
+    const void *sorted,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (index == NULL || element_size == 0 || compare == NULL ||
+        (sorted == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    size_t max_nodes = (SIZE_MAX - AC_EYTZINGER_ALIGNMENT) / element_size;
+    if (max_nodes <= AC_EYTZINGER_PADDING ||
+        size >= max_nodes - AC_EYTZINGER_PADDING) {
+        return -ENOMEM;
+    }
+    void *memory = malloc(
+        ((size + 1U + AC_EYTZINGER_PADDING) * element_size) +
+        AC_EYTZINGER_ALIGNMENT - 1U
+    );
+    if (memory == NULL) {
+        return -ENOMEM;
+    }
+
+    uintptr_t address = (uintptr_t)memory;
+    address = (address + AC_EYTZINGER_ALIGNMENT - 1U) &
+              ~(uintptr_t)(AC_EYTZINGER_ALIGNMENT - 1U);
+    unsigned char *nodes = (unsigned char *)address;
+    const unsigned char *source = (const unsigned char *)sorted;
+    for (size_t k = 1; k <= size; ++k) {
+        memcpy(
+            nodes + (k * element_size),
+            source + (inorder_rank(k, size) * element_size), element_size
+        );
+    }
+    AC_COUNT_MOVES(size);
+
+    index->nodes = nodes;
+    index->memory = memory;
+    index->size = size;
+    index->element_size = element_size;
+    index->compare = compare;
+    return 0;
+}
+
+int ac_eytzinger_init_int(
+    ac_eytzinger_index *index,
+    const int *sorted,
+    size_t size
+) {
+    return ac_eytzinger_init(index, sorted, size, sizeof(int), ac_compare_int);
+}
+
+int ac_eytzinger_init_double(
+    ac_eytzinger_index *index,
+    const double *sorted,
+    size_t size
+) {
+    return ac_eytzinger_init(
+        index, sorted, size, sizeof(double), compare_double_values
+    );
+}
+
+void ac_eytzinger_destroy(ac_eytzinger_index *index) {
+    if (index == NULL) {
+        return;
+    }
+    free(index->memory);
+    index->nodes = NULL;
+    index->memory = NULL;
+    index->size = 0;
+}
+
+size_t ac_eytzinger_lower_bound(
+    const ac_eytzinger_index *index,
+    const void *target
+) {
+    if (index == NULL) {
+        return 0;
+    }
+    size_t size = index->size;
+    if (target == NULL || index->compare == NULL) {
+        return size;
+    }
+
+    const unsigned char *nodes = index->nodes;
+    size_t element_size = index->element_size;
+    ac_compare_fn compare = index->compare;
+    size_t k = 1;
+    while (k <= size) {
+        AC_EYTZINGER_PREFETCH(
+            nodes + (prefetch_node(k, size) * element_size)
+        );
+        k = (2U * k) +
+            (size_t)(AC_COMPARE(compare, nodes + (k * element_size), target) <
+                     0);
+    }
+    return rank_after_walk(k, size);
+}
+
+size_t ac_eytzinger_lower_bound_int(
+    const ac_eytzinger_index *index,
+    int target
+) {
+    if (index == NULL) {
+        return 0;
+    }
+    size_t size = index->size;
+    // ``ac_compare_int`` also orders wider records by their leading int.
+    if (index->compare != ac_compare_int ||
+        index->element_size != sizeof(int)) {
+        return size;
+    }
+
+    const int *nodes = (const int *)(const void *)index->nodes;
+    size_t k = 1;
+    while (k <= size) {
+        AC_EYTZINGER_PREFETCH(nodes + prefetch_node(k, size));
+        k = (2U * k) + (size_t)(nodes[k] < target);
+    }
+    return rank_after_walk(k, size);
+}
+
+size_t ac_eytzinger_lower_bound_double(
+    const ac_eytzinger_index *index,
+    double target
+) {
+    if (index == NULL) {
+        return 0;
+    }
+    size_t size = index->size;
+    if (index->compare != compare_double_values ||
+        index->element_size != sizeof(double)) {
+        return size;
+    }
+
+    const double *nodes = (const double *)(const void *)index->nodes;
+    size_t k = 1;
+    while (k <= size) {
+        // Sixteen doubles span two cache lines.
+        size_t ahead = prefetch_node(k, size);
+        AC_EYTZINGER_PREFETCH(nodes + ahead);
+        AC_EYTZINGER_PREFETCH(nodes + ahead + 8U);
+        k = (2U * k) + (size_t)(nodes[k] < target);
+    }
+    return rank_after_walk(k, size);
+}
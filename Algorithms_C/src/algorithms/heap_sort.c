@@ -1,7 +1,121 @@
 #include <errno.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
-#include "algorithms_c/structures/heap.h"
+#include "algorithms_c/utils/instrument.h"
+
+/** Elements up to this size are staged on the stack during sift-down. */
+#define AC_HEAP_SORT_STACK_SCRATCH 256U
+
+/**
+ * Restore the max-heap property below ``root`` by moving the hole left by the
+ * saved root value down and dropping the value in once no child is larger.
+ */
+static void sift_down(
+    unsigned char *array,
+    size_t root,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *scratch
+) {
+    memcpy(scratch, array + (root * element_size), element_size);
+    AC_COUNT_MOVES(1U);
+    for (;;) {
+        size_t child = (2U * root) + 1U;
+        if (child >= size) {
+            break;
+        }
+        unsigned char *child_ptr = array + (child * element_size);
+        if (child + 1U < size &&
+            AC_COMPARE(compare, child_ptr, child_ptr + element_size) < 0) {
+            ++child;
+            child_ptr += element_size;
+        }
+        if (AC_COMPARE(compare, scratch, child_ptr) >= 0) {
+            break;
+        }
+        memcpy(array + (root * element_size), child_ptr, element_size);
+        AC_COUNT_MOVES(1U);
+        root = child;
+    }
+    memcpy(array + (root * element_size), scratch, element_size);
+    AC_COUNT_MOVES(1U);
+}
+
+/**
+ * Bottom-up sift-down of the hole at slot zero (Wegener): the hole first walks
+ * to a leaf along the larger children, one comparison per level, and the
+ * value in ``scratch`` then climbs back up to its place.  Values reinserted
+ * while sorting come from the bottom of the heap and nearly always belong
+ * near a leaf, so the climb is short and the sort-down phase needs about
+ * ``n log2 n`` comparisons instead of ``2 n log2 n``.
+ */
+static void sift_down_from_leaf(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    const unsigned char *scratch
+) {
+    size_t hole = 0;
+    for (;;) {
+        size_t child = (2U * hole) + 1U;
+        if (child >= size) {
+            break;
+        }
+        unsigned char *child_ptr = array + (child * element_size);
+        if (child + 1U < size &&
+            AC_COMPARE(compare, child_ptr, child_ptr + element_size) < 0) {
+            ++child;
+            child_ptr += element_size;
+        }
+        memcpy(array + (hole * element_size), child_ptr, element_size);
+        AC_COUNT_MOVES(1U);
+        hole = child;
+    }
+    while (hole > 0) {
+        size_t parent = (hole - 1U) / 2U;
+        unsigned char *parent_ptr = array + (parent * element_size);
+        if (AC_COMPARE(compare, scratch, parent_ptr) <= 0) {
+            break;
+        }
+        memcpy(array + (hole * element_size), parent_ptr, element_size);
+        AC_COUNT_MOVES(1U);
+        hole = parent;
+    }
+    memcpy(array + (hole * element_size), scratch, element_size);
+    AC_COUNT_MOVES(1U);
+}
+
+/**
+ * In-place heap sort: build a max-heap with Floyd's method, then repeatedly
+ * move the maximum behind the shrinking heap and refill slot zero from the
+ * leaves.  ``scratch`` holds one element.
+ */
+static void heap_sort_with_buffer(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *scratch
+) {
+    for (size_t root = size / 2U; root > 0; --root) {
+        sift_down(array, root - 1U, size, element_size, compare, scratch);
+    }
+
+    for (size_t end = size - 1U; end > 0; --end) {
+        unsigned char *last = array + (end * element_size);
+        // The old last element waits in ``scratch`` while the maximum takes
+        // its slot, leaving a hole at the root.
+        memcpy(scratch, last, element_size);
+        memcpy(last, array, element_size);
+        AC_COUNT_MOVES(2U);
+        sift_down_from_leaf(array, end, element_size, compare, scratch);
+    }
+}
 
 void ac_heap_sort(
     void *data,
@@ -11,29 +125,52 @@ void ac_heap_sort(
 ) {
     /* Defensive programming: mirror Python's expectation that inputs are valid.
      */
-    if (data == NULL || element_size == 0 || compare == NULL || size == 0) {
-        return;
-    }
-
-    ac_heap heap;
-    if (ac_heap_with_capacity(&heap, element_size, size, compare) != 0) {
+    if (data == NULL || element_size == 0 || compare == NULL || size < 2U) {
         return;
     }
 
-    unsigned char *bytes = (unsigned char *)data;
-    size_t index = 0U;
-    for (index = 0U; index < size; ++index) {
-        if (ac_heap_push(&heap, bytes + (index * element_size)) != 0) {
-            ac_heap_destroy(&heap);
+    unsigned char stack_scratch[AC_HEAP_SORT_STACK_SCRATCH];
+    unsigned char *scratch = stack_scratch;
+    if (element_size > sizeof(stack_scratch)) {
+        scratch = (unsigned char *)malloc(element_size);
+        if (scratch == NULL) {
             return;
         }
     }
 
-    for (index = 0U; index < size; ++index) {
-        if (ac_heap_pop(&heap, bytes + (index * element_size)) != 0) {
-            break;
-        }
+    heap_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, scratch
+    );
+
+    if (scratch != stack_scratch) {
+        free(scratch);
+    }
+}
+
+int ac_heap_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+
+    unsigned char *scratch = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (scratch == NULL) {
+        return -ENOSPC;
     }
 
-    ac_heap_destroy(&heap);
+    heap_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, scratch
+    );
+    return 0;
 }
@@ -0,0 +1,366 @@
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+
+/*
+ * Stable merge sort in O(1) extra memory.
+ *
+ * 1. Blocks of ``AC_INPLACE_MERGE_BLOCK`` elements are sorted by binary
+ *    insertion.
+ * 2. Blocks are merged bottom-up.  Runs that are already in order cost one
+ *    comparison.  When the shorter run of a merge fits in the scratch buffer
+ *    it is merged through the buffer in linear time.  Otherwise the merge
+ *    splits into two smaller merges around one rotation (SymMerge, Kim and
+ *    Kutzner 2004), which needs O(log n) comparisons per element and no
+ *    memory at all.
+ *
+ * The scratch buffer is a fixed ``AC_INPLACE_MERGE_CACHE_BYTES`` array on the
+ * stack, or a larger caller-supplied buffer.  Rotations also go through it:
+ * in one pass when the shorter side fits, otherwise by swapping equal blocks
+ * (Gries-Mills) a buffer at a time until it does, so elements wider than the
+ * buffer are still handled.
+ */
+
+/** Size of the stack buffer used when the caller supplies none. */
+#define AC_INPLACE_MERGE_CACHE_BYTES 4096U
+
+/** Elements per insertion-sorted block before merging starts. */
+#define AC_INPLACE_MERGE_BLOCK 32U
+
+typedef struct {
+    unsigned char *array;
+    size_t element_size;
+    ac_compare_fn compare;
+    unsigned char *buffer;
+    size_t buffer_bytes;
+    /** Whole elements that fit in ``buffer``. */
+    size_t buffer_elements;
+} ac_inplace_merge_state;
+
+static unsigned char *element_at(
+    const ac_inplace_merge_state *state,
+    size_t index
+) {
+    return state->array + (index * state->element_size);
+}
+
+static int less(
+    const ac_inplace_merge_state *state,
+    size_t lhs,
+    size_t rhs
+) {
+    return AC_COMPARE(
+               state->compare, element_at(state, lhs), element_at(state, rhs)
+           ) < 0;
+}
+
+/** Swap the ``count`` elements at ``a`` with the disjoint ones at ``b``. */
+static void swap_ranges(
+    const ac_inplace_merge_state *state,
+    size_t a,
+    size_t b,
+    size_t count
+) {
+    unsigned char *lhs = element_at(state, a);
+    unsigned char *rhs = element_at(state, b);
+    size_t bytes = count * state->element_size;
+    while (bytes != 0) {
+        size_t chunk =
+            bytes < state->buffer_bytes ? bytes : state->buffer_bytes;
+        memcpy(state->buffer, lhs, chunk);
+        memcpy(lhs, rhs, chunk);
+        memcpy(rhs, state->buffer, chunk);
+        lhs += chunk;
+        rhs += chunk;
+        bytes -= chunk;
+    }
+    AC_COUNT_MOVES(3U * count);
+}
+
+/** Exchange ``[first, middle)`` and ``[middle, last)``. */
+static void rotate(
+    const ac_inplace_merge_state *state,
+    size_t first,
+    size_t middle,
+    size_t last
+) {
+    if (first == middle || middle == last) {
+        return;
+    }
+    size_t element_size = state->element_size;
+    size_t left = middle - first;
+    size_t right = last - middle;
+    // Swap the shorter side into its final place until it fits the buffer.
+    while (left > state->buffer_elements && right > state->buffer_elements) {
+        if (left <= right) {
+            swap_ranges(state, first, middle, left);
+            first = middle;
+            middle += left;
+            right -= left;
+        } else {
+            swap_ranges(state, middle - right, middle, right);
+            last = middle;
+            middle -= right;
+            left -= right;
+        }
+        if (left == 0 || right == 0) {
+            return;
+        }
+    }
+    // One side now fits; move the shorter of those through the buffer.
+    if (left <= right || right > state->buffer_elements) {
+        memcpy(state->buffer, element_at(state, first), left * element_size);
+        memmove(
+            element_at(state, first), element_at(state, middle),
+            right * element_size
+        );
+        memcpy(
+            element_at(state, first + right), state->buffer,
+            left * element_size
+        );
+        AC_COUNT_MOVES((2U * left) + right);
+    } else {
+        memcpy(state->buffer, element_at(state, middle), right * element_size);
+        memmove(
+            element_at(state, first + right), element_at(state, first),
+            left * element_size
+        );
+        memcpy(element_at(state, first), state->buffer, right * element_size);
+        AC_COUNT_MOVES(left + (2U * right));
+    }
+}
+
+static void insertion_sort_block(
+    const ac_inplace_merge_state *state,
+    size_t first,
+    size_t last
+) {
+    for (size_t i = first + 1U; i < last; ++i) {
+        if (!less(state, i, i - 1U)) {
+            continue;
+        }
+        // Upper bound of element ``i`` in ``[first, i - 1)``.
+        size_t low = first;
+        size_t high = i - 1U;
+        while (low < high) {
+            size_t mid = low + ((high - low) / 2U);
+            if (less(state, i, mid)) {
+                high = mid;
+            } else {
+                low = mid + 1U;
+            }
+        }
+        rotate(state, low, i, i + 1U);
+    }
+}
+
+/** Merge ``[first, middle)`` into ``[middle, last)`` through the buffer. */
+static void merge_low(
+    const ac_inplace_merge_state *state,
+    size_t first,
+    size_t middle,
+    size_t last
+) {
+    size_t element_size = state->element_size;
+    size_t left_length = middle - first;
+    memcpy(state->buffer, element_at(state, first), left_length * element_size);
+    AC_COUNT_MOVES((2U * left_length) + (last - middle));
+
+    const unsigned char *left = state->buffer;
+    const unsigned char *left_end = left + (left_length * element_size);
+    size_t right = middle;
+    unsigned char *dest = element_at(state, first);
+    while (left < left_end && right < last) {
+        const unsigned char *right_ptr = element_at(state, right);
+        if (AC_COMPARE(state->compare, right_ptr, left) < 0) {
+            memcpy(dest, right_ptr, element_size);
+            ++right;
+        } else {
+            memcpy(dest, left, element_size);
+            left += element_size;
+        }
+        dest += element_size;
+    }
+    // Whatever is left of the right run is already in place.
+    memcpy(dest, left, (size_t)(left_end - left));
+}
+
+/** Merge ``[middle, last)`` into ``[first, middle)`` from the back. */
+static void merge_high(
+    const ac_inplace_merge_state *state,
+    size_t first,
+    size_t middle,
+    size_t last
+) {
+    size_t element_size = state->element_size;
+    size_t right_length = last - middle;
+    memcpy(
+        state->buffer, element_at(state, middle), right_length * element_size
+    );
+    AC_COUNT_MOVES((middle - first) + (2U * right_length));
+
+    size_t right = right_length;
+    size_t left = middle - first;
+    size_t dest = last;
+    while (right > 0 && left > 0) {
+        const unsigned char *right_ptr =
+            state->buffer + ((right - 1U) * element_size);
+        const unsigned char *left_ptr = element_at(state, first + left - 1U);
+        --dest;
+        if (AC_COMPARE(state->compare, right_ptr, left_ptr) < 0) {
+            memcpy(element_at(state, dest), left_ptr, element_size);
+            --left;
+        } else {
+            memcpy(element_at(state, dest), right_ptr, element_size);
+            --right;
+        }
+    }
+    // Whatever is left of the left run is already in place.
+    memcpy(element_at(state, first), state->buffer, right * element_size);
+}
+
+/** Stable merge of the sorted runs ``[first, middle)``, ``[middle, last)``. */
+static void merge_runs(
+    const ac_inplace_merge_state *state,
+    size_t first,
+    size_t middle,
+    size_t last
+) {
+    if (first == middle || middle == last ||
+        !less(state, middle, middle - 1U)) {
+        return;
+    }
+    size_t left_length = middle - first;
+    size_t right_length = last - middle;
+    if (left_length == 1U) {
+        // Lower bound of element ``first`` in ``[middle + 1, last)``.
+        size_t low = middle + 1U;
+        size_t high = last;
+        while (low < high) {
+            size_t mid = low + ((high - low) / 2U);
+            if (less(state, mid, first)) {
+                low = mid + 1U;
+            } else {
+                high = mid;
+            }
+        }
+        rotate(state, first, middle, low);
+        return;
+    }
+    if (right_length == 1U) {
+        // Upper bound of element ``middle`` in ``[first, middle - 1)``.
+        size_t low = first;
+        size_t high = middle - 1U;
+        while (low < high) {
+            size_t mid = low + ((high - low) / 2U);
+            if (less(state, middle, mid)) {
+                high = mid;
+            } else {
+                low = mid + 1U;
+            }
+        }
+        rotate(state, low, middle, last);
+        return;
+    }
+    if (left_length <= right_length && left_length <= state->buffer_elements) {
+        merge_low(state, first, middle, last);
+        return;
+    }
+    if (right_length <= state->buffer_elements) {
+        merge_high(state, first, middle, last);
+        return;
+    }
+
+    // SymMerge: find the split ``start`` such that rotating
+    // ``[start, middle)`` past ``[middle, end)`` leaves two independent
+    // merges on either side of ``half``.
+    size_t half = first + ((last - first) / 2U);
+    size_t pivot_sum = half + middle;
+    size_t start;
+    size_t bound;
+    if (middle > half) {
+        start = pivot_sum - last;
+        bound = half;
+    } else {
+        start = first;
+        bound = middle;
+    }
+    size_t mirror = pivot_sum - 1U;
+    while (start < bound) {
+        size_t probe = start + ((bound - start) / 2U);
+        if (!less(state, mirror - probe, probe)) {
+            start = probe + 1U;
+        } else {
+            bound = probe;
+        }
+    }
+    size_t end = pivot_sum - start;
+    rotate(state, start, middle, end);
+    merge_runs(state, first, start, half);
+    merge_runs(state, half, end, last);
+}
+
+static void inplace_merge_sort(ac_inplace_merge_state *state, size_t size) {
+    for (size_t first = 0; first < size; first += AC_INPLACE_MERGE_BLOCK) {
+        size_t last = size - first < AC_INPLACE_MERGE_BLOCK
+                          ? size
+                          : first + AC_INPLACE_MERGE_BLOCK;
+        insertion_sort_block(state, first, last);
+    }
+    for (size_t width = AC_INPLACE_MERGE_BLOCK; width < size; width *= 2U) {
+        for (size_t first = 0; first < size && size - first > width;
+             first += 2U * width) {
+            size_t middle = first + width;
+            size_t last = size - middle < width ? size : middle + width;
+            merge_runs(state, first, middle, last);
+        }
+        if (width > size / 2U) {
+            break;
+        }
+    }
+}
+
+int ac_inplace_merge_sort_buffered(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    void *buffer,
+    size_t buffer_bytes
+) {
+    if (compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0) || (buffer == NULL && buffer_bytes != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+
+    unsigned char cache[AC_INPLACE_MERGE_CACHE_BYTES];
+    ac_inplace_merge_state state;
+    state.array = (unsigned char *)data;
+    state.element_size = element_size;
+    state.compare = compare;
+    state.buffer = cache;
+    state.buffer_bytes = sizeof(cache);
+    if (buffer_bytes > sizeof(cache)) {
+        state.buffer = (unsigned char *)buffer;
+        state.buffer_bytes = buffer_bytes;
+    }
+    state.buffer_elements = state.buffer_bytes / element_size;
+    inplace_merge_sort(&state, size);
+    return 0;
+}
+
+void ac_inplace_merge_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    (void)ac_inplace_merge_sort_buffered(
+        data, size, element_size, compare, NULL, 0U
+    );
+}
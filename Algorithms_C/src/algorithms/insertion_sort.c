@@ -1,6 +1,77 @@
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+
+/** Elements up to this width are staged on the stack by binary insertion. */
+#define AC_INSERTION_SORT_STACK_SCRATCH 256U
+
+static void insertion_sort_with_buffer(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *buffer
+) {
+    for (size_t i = 1; i < size; ++i) {
+        memcpy(buffer, array + (i * element_size), element_size);
+        AC_COUNT_MOVES(1U);
+        size_t j = i;
+        while (j > 0) {
+            unsigned char *prev = array + ((j - 1) * element_size);
+            if (AC_COMPARE(compare, prev, buffer) <= 0) {
+                break;
+            }
+            memcpy(array + (j * element_size), prev, element_size);
+            AC_COUNT_MOVES(1U);
+            --j;
+        }
+        memcpy(array + (j * element_size), buffer, element_size);
+        AC_COUNT_MOVES(1U);
+    }
+}
+
+/*
+ * Binary insertion: an element already in order with its predecessor costs
+ * one comparison and no moves.  Otherwise the slot is found by an upper-bound
+ * search over the sorted prefix, so equal elements keep their order, and the
+ * tail is shifted by a single ``memmove``.
+ */
+static void binary_insertion_sort_with_buffer(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *buffer
+) {
+    for (size_t i = 1; i < size; ++i) {
+        unsigned char *current = array + (i * element_size);
+        if (AC_COMPARE(compare, current - element_size, current) <= 0) {
+            continue;
+        }
+
+        // ``array[i - 1]`` is known to be greater, so search ``[0, i - 1)``.
+        size_t low = 0;
+        size_t high = i - 1U;
+        while (low < high) {
+            size_t mid = low + ((high - low) / 2U);
+            const unsigned char *probe = array + (mid * element_size);
+            if (AC_COMPARE(compare, probe, current) <= 0) {
+                low = mid + 1U;
+            } else {
+                high = mid;
+            }
+        }
+
+        unsigned char *slot = array + (low * element_size);
+        memcpy(buffer, current, element_size);
+        memmove(slot + element_size, slot, (i - low) * element_size);
+        memcpy(slot, buffer, element_size);
+        AC_COUNT_MOVES((i - low) + 2U);
+    }
+}
 
 void ac_insertion_sort(
     void *data,
@@ -12,27 +83,98 @@ void ac_insertion_sort(
         return;
     }
 
-    unsigned char *array = (unsigned char *)data;
     unsigned char *buffer = (unsigned char *)malloc(element_size);
     if (buffer == NULL) {
         return;
     }
 
-    for (size_t i = 1; i < size; ++i) {
-        memcpy(buffer, array + (i * element_size), element_size);
-        size_t j = i;
-        while (j > 0) {
-            unsigned char *prev = array + ((j - 1) * element_size);
-            if (compare(prev, buffer) <= 0) {
-                break;
-            }
-            memcpy(array + (j * element_size), prev, element_size);
-            --j;
+    insertion_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    free(buffer);
+}
+
+int ac_insertion_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+
+    unsigned char *buffer = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (buffer == NULL) {
+        return -ENOSPC;
+    }
+
+    insertion_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    return 0;
+}
+
+void ac_binary_insertion_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (data == NULL || compare == NULL || element_size == 0 || size < 2U) {
+        return;
+    }
+
+    unsigned char stack_buffer[AC_INSERTION_SORT_STACK_SCRATCH];
+    unsigned char *buffer = stack_buffer;
+    if (element_size > sizeof(stack_buffer)) {
+        buffer = (unsigned char *)malloc(element_size);
+        if (buffer == NULL) {
+            return;
         }
-        memcpy(array + (j * element_size), buffer, element_size);
     }
 
-    free(buffer);
+    binary_insertion_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    if (buffer != stack_buffer) {
+        free(buffer);
+    }
+}
+
+int ac_binary_insertion_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+
+    unsigned char *buffer = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (buffer == NULL) {
+        return -ENOSPC;
+    }
+
+    binary_insertion_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    return 0;
 }
 
 size_t ac_bin_search_double(
@@ -64,26 +206,10 @@ void ac_insertion_sort_opt_double(double *data, size_t size) {
     for (size_t i = 1; i < size; ++i) {
         double current = data[i];
         size_t position = ac_bin_search_double(data, current, 0U, i);
-
-        for (size_t j = i; j > position; --j) {
-            data[j] = data[j - 1U];
-        }
+        memmove(
+            data + position + 1U, data + position,
+            (i - position) * sizeof(double)
+        );
         data[position] = current;
     }
 }
-
-void ac_insertion_sort_double(double *data, size_t size) {
-    if (data == NULL || size < 2U) {
-        return;
-    }
-
-    for (size_t i = 0; i < size; ++i) {
-        size_t k = i;
-        while (k > 0U && data[k - 1U] > data[k]) {
-            double tmp = data[k - 1U];
-            data[k - 1U] = data[k];
-            data[k] = tmp;
-            --k;
-        }
-    }
-}
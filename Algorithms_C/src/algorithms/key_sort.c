@@ -0,0 +1,238 @@
+#include "algorithms_c/algorithms/key_sort.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/argsort.h"
+
+/** Digits are 11 bits wide, as in the radix engine of ``radix_sort.c``. */
+#define AC_KEY_SORT_DIGIT_BITS 11U
+#define AC_KEY_SORT_BUCKETS (1U << AC_KEY_SORT_DIGIT_BITS)
+#define AC_KEY_SORT_DIGIT_MASK (AC_KEY_SORT_BUCKETS - 1U)
+
+/** Inputs at or below this size sort their pairs by insertion. */
+#define AC_KEY_SORT_SMALL_SIZE 64U
+
+#define AC_KEY_SORT_FLAGS (AC_SORT_BY_KEY_DESCENDING | AC_SORT_BY_KEY_STABLE)
+
+typedef struct {
+    uint64_t key;
+    size_t index;
+} ac_key_pair;
+
+/** Width of a ``type`` key in bytes, or ``0`` for an unknown type. */
+static size_t key_width(ac_key_type type) {
+    switch (type) {
+    case AC_KEY_INT8:
+    case AC_KEY_UINT8:
+        return 1U;
+    case AC_KEY_INT16:
+    case AC_KEY_UINT16:
+        return 2U;
+    case AC_KEY_INT32:
+    case AC_KEY_UINT32:
+    case AC_KEY_FLOAT:
+        return 4U;
+    case AC_KEY_INT64:
+    case AC_KEY_UINT64:
+    case AC_KEY_DOUBLE:
+        return 8U;
+    }
+    return 0U;
+}
+
+/** Load the key at ``field`` as an unsigned value with the ascending order. */
+static uint64_t load_key(const unsigned char *field, ac_key_type type) {
+    switch (type) {
+    case AC_KEY_INT8:
+    case AC_KEY_UINT8: {
+        uint8_t value;
+        memcpy(&value, field, sizeof(value));
+        return type == AC_KEY_INT8 ? (uint64_t)(value ^ 0x80U) : value;
+    }
+    case AC_KEY_INT16:
+    case AC_KEY_UINT16: {
+        uint16_t value;
+        memcpy(&value, field, sizeof(value));
+        return type == AC_KEY_INT16 ? (uint64_t)(value ^ 0x8000U) : value;
+    }
+    case AC_KEY_INT32:
+    case AC_KEY_UINT32: {
+        uint32_t value;
+        memcpy(&value, field, sizeof(value));
+        return type == AC_KEY_INT32 ? (uint64_t)(value ^ UINT32_C(0x80000000))
+                                    : value;
+    }
+    case AC_KEY_FLOAT: {
+        uint32_t bits;
+        memcpy(&bits, field, sizeof(bits));
+        uint32_t sign = bits >> 31U;
+        return bits ^ ((UINT32_C(0) - sign) | UINT32_C(0x80000000));
+    }
+    case AC_KEY_INT64:
+    case AC_KEY_UINT64: {
+        uint64_t value;
+        memcpy(&value, field, sizeof(value));
+        return type == AC_KEY_INT64 ? value ^ UINT64_C(0x8000000000000000)
+                                    : value;
+    }
+    case AC_KEY_DOUBLE: {
+        uint64_t bits;
+        memcpy(&bits, field, sizeof(bits));
+        uint64_t sign = bits >> 63U;
+        return bits ^ ((UINT64_C(0) - sign) | UINT64_C(0x8000000000000000));
+    }
+    }
+    return 0U;
+}
+
+static void insertion_sort_pairs(ac_key_pair *pairs, size_t size) {
+    for (size_t i = 1; i < size; ++i) {
+        ac_key_pair pair = pairs[i];
+        size_t j = i;
+        while (j > 0 && pairs[j - 1U].key > pair.key) {
+            pairs[j] = pairs[j - 1U];
+            --j;
+        }
+        pairs[j] = pair;
+    }
+}
+
+/**
+ * Stable LSD radix sort of ``pairs`` over the low ``bits`` key bits,
+ * ping-ponging with ``scratch``.  Returns the buffer holding the result, or
+ * ``NULL`` if the histograms cannot be allocated.
+ */
+static ac_key_pair *radix_sort_pairs(
+    ac_key_pair *pairs,
+    ac_key_pair *scratch,
+    size_t size,
+    unsigned bits
+) {
+    unsigned passes =
+        (bits + AC_KEY_SORT_DIGIT_BITS - 1U) / AC_KEY_SORT_DIGIT_BITS;
+    size_t *counts =
+        (size_t *)calloc((size_t)passes * AC_KEY_SORT_BUCKETS, sizeof(size_t));
+    if (counts == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        uint64_t key = pairs[i].key;
+        for (unsigned pass = 0; pass < passes; ++pass) {
+            counts[(pass * AC_KEY_SORT_BUCKETS) +
+                   (size_t)((key >> (pass * AC_KEY_SORT_DIGIT_BITS)) &
+                            AC_KEY_SORT_DIGIT_MASK)]++;
+        }
+    }
+
+    ac_key_pair *src = pairs;
+    ac_key_pair *dst = scratch;
+    for (unsigned pass = 0; pass < passes; ++pass) {
+        size_t *offsets = counts + (pass * AC_KEY_SORT_BUCKETS);
+        unsigned shift = pass * AC_KEY_SORT_DIGIT_BITS;
+        if (offsets[(src[0].key >> shift) & AC_KEY_SORT_DIGIT_MASK] == size) {
+            // Every key shares this digit.
+            continue;
+        }
+        size_t total = 0;
+        for (size_t bucket = 0; bucket < AC_KEY_SORT_BUCKETS; ++bucket) {
+            size_t count = offsets[bucket];
+            offsets[bucket] = total;
+            total += count;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            size_t digit =
+                (size_t)((src[i].key >> shift) & AC_KEY_SORT_DIGIT_MASK);
+            dst[offsets[digit]++] = src[i];
+        }
+        ac_key_pair *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    free(counts);
+    return src;
+}
+
+int ac_sort_by_key(
+    void *data,
+    size_t size,
+    size_t element_size,
+    size_t key_offset,
+    ac_key_type key_type,
+    unsigned flags
+) {
+    size_t width = key_width(key_type);
+    if ((data == NULL && size != 0) || element_size == 0 || width == 0 ||
+        key_offset > element_size || element_size - key_offset < width ||
+        (flags & ~AC_KEY_SORT_FLAGS) != 0U) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+    if (size > SIZE_MAX / sizeof(ac_key_pair)) {
+        return -ENOMEM;
+    }
+
+    ac_key_pair *pairs = (ac_key_pair *)malloc(size * sizeof(ac_key_pair));
+    ac_key_pair *scratch = (ac_key_pair *)malloc(size * sizeof(ac_key_pair));
+    if (pairs == NULL || scratch == NULL) {
+        free(pairs);
+        free(scratch);
+        return -ENOMEM;
+    }
+
+    unsigned bits = (unsigned)(width * 8U);
+    uint64_t descending = 0U;
+    if ((flags & AC_SORT_BY_KEY_DESCENDING) != 0U) {
+        descending = bits == 64U ? UINT64_MAX : (UINT64_C(1) << bits) - 1U;
+    }
+    unsigned char *base = (unsigned char *)data;
+    for (size_t i = 0; i < size; ++i) {
+        pairs[i].key =
+            load_key(base + (i * element_size) + key_offset, key_type) ^
+            descending;
+        pairs[i].index = i;
+    }
+
+    ac_key_pair *sorted = pairs;
+    ac_key_pair *spare = scratch;
+    if (size <= AC_KEY_SORT_SMALL_SIZE) {
+        insertion_sort_pairs(pairs, size);
+    } else {
+        sorted = radix_sort_pairs(pairs, scratch, size, bits);
+        if (sorted == NULL) {
+            free(pairs);
+            free(scratch);
+            return -ENOMEM;
+        }
+        spare = sorted == pairs ? scratch : pairs;
+    }
+
+    // Move every record once into a packed copy, then copy it back; in place
+    // through ``ac_apply_permutation`` if the copy cannot be allocated.
+    int status = 0;
+    unsigned char *records = size > SIZE_MAX / element_size
+                                 ? NULL
+                                 : (unsigned char *)malloc(size * element_size);
+    if (records != NULL) {
+        for (size_t i = 0; i < size; ++i) {
+            memcpy(
+                records + (i * element_size),
+                base + (sorted[i].index * element_size), element_size
+            );
+        }
+        memcpy(base, records, size * element_size);
+        free(records);
+    } else {
+        // ``spare`` holds ``size`` pairs, so it has room for the indices.
+        size_t *perm = (size_t *)(void *)spare;
+        for (size_t i = 0; i < size; ++i) {
+            perm[i] = sorted[i].index;
+        }
+        status = ac_apply_permutation(data, size, element_size, perm);
+    }
+    free(pairs);
+    free(scratch);
+    return status;
+}
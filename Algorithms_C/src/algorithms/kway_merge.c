@@ -0,0 +1,400 @@
+#include "algorithms_c/algorithms/kway_merge.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Loser tree layout shared by every merge below: for ``count`` inputs the
+ * tree is a complete binary tree whose leaves are nodes ``count`` to
+ * ``2 * count - 1`` (leaf ``i`` is node ``count + i``).  ``tree[1]`` to
+ * ``tree[count - 1]`` hold the loser of the match played at that internal
+ * node and ``tree[0]`` holds the overall winner.  An exhausted input loses
+ * every match, and ties go to the lower input index, which keeps the merge
+ * stable.
+ */
+
+/** Merges of up to this many inputs keep their tree on the stack. */
+#define AC_KWAY_STACK_INPUTS 64U
+
+static int validate_spans(const ac_merge_span *inputs, size_t count) {
+    if (inputs == NULL && count != 0) {
+        return 0;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (inputs[i].data == NULL && inputs[i].size != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int leaf_beats(const ac_kway_cursor *cursor, size_t a, size_t b) {
+    if (cursor->head[a] == cursor->end[a]) {
+        return 0;
+    }
+    if (cursor->head[b] == cursor->end[b]) {
+        return 1;
+    }
+    int order = cursor->compare(cursor->head[a], cursor->head[b]);
+    return order < 0 || (order == 0 && a < b);
+}
+
+static size_t build_tree(ac_kway_cursor *cursor, size_t node) {
+    if (node >= cursor->count) {
+        return node - cursor->count;
+    }
+    size_t left = build_tree(cursor, 2U * node);
+    size_t right = build_tree(cursor, (2U * node) + 1U);
+    if (leaf_beats(cursor, left, right)) {
+        cursor->tree[node] = right;
+        return left;
+    }
+    cursor->tree[node] = left;
+    return right;
+}
+
+static void set_span(
+    ac_kway_cursor *cursor,
+    size_t input,
+    const ac_merge_span *span
+) {
+    const unsigned char *data = (const unsigned char *)span->data;
+    cursor->head[input] = data;
+    cursor->end[input] =
+        span->size == 0 ? data : data + (span->size * cursor->element_size);
+}
+
+/** Wire ``cursor`` to caller-provided arrays and load the first blocks. */
+static int cursor_start(
+    ac_kway_cursor *cursor,
+    const ac_merge_span *inputs,
+    const unsigned char **head,
+    const unsigned char **end,
+    size_t *tree
+) {
+    cursor->head = head;
+    cursor->end = end;
+    cursor->tree = tree;
+    cursor->status = 0;
+
+    for (size_t i = 0; i < cursor->count; ++i) {
+        ac_merge_span span = {NULL, 0};
+        if (inputs != NULL) {
+            span = inputs[i];
+        } else {
+            int status = cursor->refill(cursor->context, i, &span);
+            if (status != 0) {
+                cursor->status = status;
+                return status;
+            }
+        }
+        set_span(cursor, i, &span);
+    }
+    if (cursor->count != 0) {
+        cursor->tree[0] = build_tree(cursor, 1U);
+    }
+    return 0;
+}
+
+/** Emit records until ``capacity`` is reached, all inputs end or an error. */
+static size_t cursor_emit(
+    ac_kway_cursor *cursor,
+    unsigned char *out,
+    size_t capacity
+) {
+    size_t element_size = cursor->element_size;
+    size_t count = cursor->count;
+    size_t *tree = cursor->tree;
+    size_t written = 0;
+    while (written < capacity && count != 0) {
+        size_t winner = tree[0];
+        const unsigned char *record = cursor->head[winner];
+        if (record == cursor->end[winner]) {
+            break;
+        }
+        memcpy(out + (written * element_size), record, element_size);
+        ++written;
+
+        cursor->head[winner] = record + element_size;
+        if (cursor->head[winner] == cursor->end[winner] &&
+            cursor->refill != NULL) {
+            ac_merge_span span = {NULL, 0};
+            int status = cursor->refill(cursor->context, winner, &span);
+            if (status != 0) {
+                cursor->status = status;
+                break;
+            }
+            set_span(cursor, winner, &span);
+        }
+
+        // Replay the winner's path against the stored losers.
+        for (size_t node = (winner + count) / 2U; node > 0; node /= 2U) {
+            if (leaf_beats(cursor, tree[node], winner)) {
+                size_t loser = winner;
+                winner = tree[node];
+                tree[node] = loser;
+            }
+        }
+        tree[0] = winner;
+    }
+    return written;
+}
+
+static int cursor_init(
+    ac_kway_cursor *cursor,
+    const ac_merge_span *inputs,
+    size_t count,
+    size_t element_size,
+    ac_compare_fn compare,
+    ac_kway_refill_fn refill,
+    void *context
+) {
+    cursor->count = count;
+    cursor->element_size = element_size;
+    cursor->compare = compare;
+    cursor->refill = refill;
+    cursor->context = context;
+    cursor->head = NULL;
+
+    if (count == 0) {
+        return cursor_start(cursor, inputs, NULL, NULL, NULL);
+    }
+    size_t per_input = (2U * sizeof(unsigned char *)) + sizeof(size_t);
+    if (count > SIZE_MAX / per_input) {
+        return -ENOMEM;
+    }
+    // One block: the pointer arrays first, so the tree stays aligned.
+    const unsigned char **block =
+        (const unsigned char **)malloc(count * per_input);
+    if (block == NULL) {
+        return -ENOMEM;
+    }
+    int status = cursor_start(
+        cursor, inputs, block, block + count, (size_t *)(block + (2U * count))
+    );
+    if (status != 0) {
+        free(block);
+        cursor->head = NULL;
+    }
+    return status;
+}
+
+int ac_kway_cursor_init(
+    ac_kway_cursor *cursor,
+    const ac_merge_span *inputs,
+    size_t count,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (cursor == NULL || !validate_spans(inputs, count) || compare == NULL ||
+        element_size == 0) {
+        return -EINVAL;
+    }
+    return cursor_init(
+        cursor, inputs, count, element_size, compare, NULL, NULL
+    );
+}
+
+int ac_kway_cursor_init_refill(
+    ac_kway_cursor *cursor,
+    size_t count,
+    size_t element_size,
+    ac_compare_fn compare,
+    ac_kway_refill_fn refill,
+    void *context
+) {
+    if (cursor == NULL || compare == NULL || refill == NULL ||
+        element_size == 0) {
+        return -EINVAL;
+    }
+    return cursor_init(
+        cursor, NULL, count, element_size, compare, refill, context
+    );
+}
+
+int ac_kway_cursor_next(
+    ac_kway_cursor *cursor,
+    void *out,
+    size_t capacity,
+    size_t *out_count
+) {
+    if (out_count != NULL) {
+        *out_count = 0;
+    }
+    if (cursor == NULL || out_count == NULL || (out == NULL && capacity != 0)) {
+        return -EINVAL;
+    }
+    if (cursor->status != 0) {
+        return cursor->status;
+    }
+    *out_count = cursor_emit(cursor, (unsigned char *)out, capacity);
+    return cursor->status;
+}
+
+void ac_kway_cursor_destroy(ac_kway_cursor *cursor) {
+    if (cursor == NULL) {
+        return;
+    }
+    free((void *)cursor->head);
+    cursor->head = NULL;
+    cursor->end = NULL;
+    cursor->tree = NULL;
+    cursor->count = 0;
+}
+
+int ac_kway_merge(
+    const ac_merge_span *inputs,
+    size_t count,
+    size_t element_size,
+    ac_compare_fn compare,
+    void *out
+) {
+    if (!validate_spans(inputs, count) || compare == NULL ||
+        element_size == 0) {
+        return -EINVAL;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += inputs[i].size;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    if (out == NULL) {
+        return -EINVAL;
+    }
+    if (count == 1U) {
+        memcpy(out, inputs[0].data, total * element_size);
+        return 0;
+    }
+
+    ac_kway_cursor cursor;
+    cursor.count = count;
+    cursor.element_size = element_size;
+    cursor.compare = compare;
+    cursor.refill = NULL;
+    cursor.context = NULL;
+    if (count <= AC_KWAY_STACK_INPUTS) {
+        const unsigned char *head[AC_KWAY_STACK_INPUTS];
+        const unsigned char *end[AC_KWAY_STACK_INPUTS];
+        size_t tree[AC_KWAY_STACK_INPUTS];
+        cursor_start(&cursor, inputs, head, end, tree);
+        cursor_emit(&cursor, (unsigned char *)out, total);
+        return 0;
+    }
+
+    int status = cursor_init(
+        &cursor, inputs, count, element_size, compare, NULL, NULL
+    );
+    if (status != 0) {
+        return status;
+    }
+    cursor_emit(&cursor, (unsigned char *)out, total);
+    ac_kway_cursor_destroy(&cursor);
+    return 0;
+}
+
+/*
+ * Typed merges: the same tree with the records compared inline.  The merge
+ * runs for exactly ``total`` steps, so the winner is never an exhausted
+ * input.
+ */
+#define AC_KWAY_DEFINE_TYPED(suffix, type)                                     \
+    static int typed_beats_##suffix(                                           \
+        const type *const *head, const type *const *end, size_t a, size_t b    \
+    ) {                                                                        \
+        if (head[a] == end[a]) {                                               \
+            return 0;                                                          \
+        }                                                                      \
+        if (head[b] == end[b]) {                                               \
+            return 1;                                                          \
+        }                                                                      \
+        if (*head[a] < *head[b]) {                                             \
+            return 1;                                                          \
+        }                                                                      \
+        return a < b && !(*head[b] < *head[a]);                                \
+    }                                                                          \
+                                                                               \
+    static size_t typed_build_##suffix(                                        \
+        const type *const *head, const type *const *end, size_t *tree,         \
+        size_t count, size_t node                                              \
+    ) {                                                                        \
+        if (node >= count) {                                                   \
+            return node - count;                                               \
+        }                                                                      \
+        size_t left =                                                          \
+            typed_build_##suffix(head, end, tree, count, 2U * node);           \
+        size_t right =                                                         \
+            typed_build_##suffix(head, end, tree, count, (2U * node) + 1U);    \
+        if (typed_beats_##suffix(head, end, left, right)) {                    \
+            tree[node] = right;                                                \
+            return left;                                                       \
+        }                                                                      \
+        tree[node] = left;                                                     \
+        return right;                                                          \
+    }                                                                          \
+                                                                               \
+    int ac_kway_merge_##suffix(                                                \
+        const ac_merge_span *inputs, size_t count, type *out                   \
+    ) {                                                                        \
+        if (!validate_spans(inputs, count)) {                                  \
+            return -EINVAL;                                                    \
+        }                                                                      \
+        size_t total = 0;                                                      \
+        for (size_t i = 0; i < count; ++i) {                                   \
+            total += inputs[i].size;                                           \
+        }                                                                      \
+        if (total == 0) {                                                      \
+            return 0;                                                          \
+        }                                                                      \
+        if (out == NULL) {                                                     \
+            return -EINVAL;                                                    \
+        }                                                                      \
+                                                                               \
+        const type *stack_head[AC_KWAY_STACK_INPUTS];                          \
+        const type *stack_end[AC_KWAY_STACK_INPUTS];                           \
+        size_t stack_tree[AC_KWAY_STACK_INPUTS];                               \
+        const type **head = stack_head;                                        \
+        const type **end = stack_end;                                          \
+        size_t *tree = stack_tree;                                             \
+        void *block = NULL;                                                    \
+        if (count > AC_KWAY_STACK_INPUTS) {                                    \
+            size_t per_input = (2U * sizeof(type *)) + sizeof(size_t);         \
+            if (count > SIZE_MAX / per_input) {                                \
+                return -ENOMEM;                                                \
+            }                                                                  \
+            block = malloc(count * per_input);                                 \
+            if (block == NULL) {                                               \
+                return -ENOMEM;                                                \
+            }                                                                  \
+            head = (const type **)block;                                       \
+            end = head + count;                                                \
+            tree = (size_t *)(end + count);                                    \
+        }                                                                      \
+                                                                               \
+        for (size_t i = 0; i < count; ++i) {                                   \
+            head[i] = (const type *)inputs[i].data;                            \
+            end[i] = head[i] + inputs[i].size;                                 \
+        }                                                                      \
+        tree[0] = typed_build_##suffix(head, end, tree, count, 1U);            \
+        for (size_t n = 0; n < total; ++n) {                                   \
+            size_t winner = tree[0];                                           \
+            out[n] = *head[winner]++;                                          \
+            for (size_t node = (winner + count) / 2U; node > 0;                \
+                 node /= 2U) {                                                 \
+                if (typed_beats_##suffix(head, end, tree[node], winner)) {     \
+                    size_t loser = winner;                                     \
+                    winner = tree[node];                                       \
+                    tree[node] = loser;                                        \
+                }                                                              \
+            }                                                                  \
+            tree[0] = winner;                                                  \
+        }                                                                      \
+                                                                               \
+        free(block);                                                           \
+        return 0;                                                              \
+    }
+
+AC_KWAY_DEFINE_TYPED(int, int)
+AC_KWAY_DEFINE_TYPED(double, double)
@@ -1,6 +1,9 @@
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
 
 static void merge(
     unsigned char *array,
@@ -18,7 +21,7 @@ static void merge(
     while (i < mid && j < right) {
         const unsigned char *left_elem = array + (i * element_size);
         const unsigned char *right_elem = array + (j * element_size);
-        if (compare(left_elem, right_elem) <= 0) {
+        if (AC_COMPARE(compare, left_elem, right_elem) <= 0) {
             memcpy(buffer + (k * element_size), left_elem, element_size);
             ++i;
         } else {
@@ -52,6 +55,8 @@ static void merge(
             element_size
         );
     }
+    // Every element goes out to ``buffer`` and back.
+    AC_COUNT_MOVES(2U * (right - left));
 }
 
 static void merge_sort_recursive(
@@ -85,6 +90,8 @@ void ac_merge_sort(
     unsigned char *array = (unsigned char *)data;
     unsigned char *buffer = (unsigned char *)malloc(size * element_size);
     if (buffer == NULL) {
+        // Still sort, stably, without the buffer.
+        ac_inplace_merge_sort(data, size, element_size, compare);
         return;
     }
 
@@ -92,6 +99,34 @@ void ac_merge_sort(
     free(buffer);
 }
 
+int ac_merge_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+
+    unsigned char *buffer = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, size, element_size, 1U
+    );
+    if (buffer == NULL) {
+        return -ENOSPC;
+    }
+
+    merge_sort_recursive(
+        (unsigned char *)data, buffer, 0, size, element_size, compare
+    );
+    return 0;
+}
+
 void ac_merge_double_arrays(
     double *out,
     const double *left,
@@ -123,19 +158,3 @@ void ac_merge_double_arrays(
         out[k++] = right[j++];
     }
 }
-
-static int ac_compare_double_local_merge(const void *lhs, const void *rhs) {
-    const double left = *(const double *)lhs;
-    const double right = *(const double *)rhs;
-    if (left < right) {
-        return -1;
-    }
-    if (left > right) {
-        return 1;
-    }
-    return 0;
-}
-
-void ac_merge_sort_double(double *data, size_t size) {
-    ac_merge_sort(data, size, sizeof(double), ac_compare_double_local_merge);
-}
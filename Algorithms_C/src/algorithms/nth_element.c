@@ -0,0 +1,433 @@
+#include "algorithms_c/algorithms/nth_element.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Selection engine behind ``ac_nth_element``.
+ *
+ * Floyd-Rivest selection partitions around a pivot that is itself the answer
+ * of a recursive selection on a window of about ``n^(2/3)`` records centred
+ * on the expected position of ``nth``.  The window is sized so that, with
+ * high probability, the final record of rank ``nth`` lies between the window
+ * bounds, so each round discards almost everything except a small
+ * neighbourhood of the target.  The sampling is deterministic: it looks at
+ * the records that happen to sit inside the window.
+ *
+ * Inputs crafted against that choice cannot push the running time past linear
+ * because every partitioning round spends one unit of a ``2 * log2(n)``
+ * budget; once it is gone, the remaining range is finished by the classic
+ * median-of-medians selection with groups of five and a three-way partition,
+ * which discards at least 30% of the range per round.
+ */
+
+/** Ranges with at most this many records are finished by insertion sort. */
+#define AC_SELECT_INSERTION_THRESHOLD 16U
+
+/** Ranges larger than this are narrowed with a recursive sample first. */
+#define AC_SELECT_SAMPLE_THRESHOLD 600U
+
+/** Records up to this width are staged on the stack. */
+#define AC_SELECT_STACK_SCRATCH 256U
+
+typedef struct {
+    unsigned char *array;
+    size_t element_size;
+    ac_compare_fn compare;
+    /** Copy of the current partitioning pivot. */
+    unsigned char *pivot;
+    /** Temporary slot for swaps and insertion. */
+    unsigned char *hold;
+} ac_select_state;
+
+static unsigned char *record_at(const ac_select_state *state, size_t index) {
+    return state->array + (index * state->element_size);
+}
+
+static int compare_at(const ac_select_state *state, size_t a, size_t b) {
+    return state->compare(record_at(state, a), record_at(state, b));
+}
+
+static int compare_to_pivot(const ac_select_state *state, size_t index) {
+    return state->compare(record_at(state, index), state->pivot);
+}
+
+static void swap_at(const ac_select_state *state, size_t a, size_t b) {
+    if (a == b) {
+        return;
+    }
+    size_t element_size = state->element_size;
+    memcpy(state->hold, record_at(state, a), element_size);
+    memcpy(record_at(state, a), record_at(state, b), element_size);
+    memcpy(record_at(state, b), state->hold, element_size);
+}
+
+/** Sort the inclusive range ``[left, right]``. */
+static void insertion_sort_range(
+    const ac_select_state *state,
+    size_t left,
+    size_t right
+) {
+    size_t element_size = state->element_size;
+    for (size_t i = left + 1U; i <= right; ++i) {
+        if (compare_at(state, i - 1U, i) <= 0) {
+            continue;
+        }
+        memcpy(state->hold, record_at(state, i), element_size);
+        size_t j = i;
+        do {
+            memcpy(
+                record_at(state, j), record_at(state, j - 1U), element_size
+            );
+            --j;
+        } while (j > left &&
+                 state->compare(record_at(state, j - 1U), state->hold) > 0);
+        memcpy(record_at(state, j), state->hold, element_size);
+    }
+}
+
+/** ``floor(sqrt(value))`` without libm. */
+static size_t integer_sqrt(size_t value) {
+    size_t root = 0;
+    size_t bit = (size_t)1 << ((sizeof(size_t) * 8U) - 2U);
+    while (bit > value) {
+        bit >>= 2U;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1U) + bit;
+        } else {
+            root >>= 1U;
+        }
+        bit >>= 2U;
+    }
+    return root;
+}
+
+/** ``floor(cbrt(value))`` without libm. */
+static size_t integer_cbrt(size_t value) {
+    size_t low = 0;
+    size_t high = (size_t)1 << ((sizeof(size_t) * 8U) / 3U + 1U);
+    while (low < high) {
+        size_t mid = low + ((high - low + 1U) / 2U);
+        if (mid <= value / mid / mid) {
+            low = mid;
+        } else {
+            high = mid - 1U;
+        }
+    }
+    return low;
+}
+
+static size_t floor_log2(size_t value) {
+    size_t log = 0;
+    while (value > 1U) {
+        value >>= 1U;
+        ++log;
+    }
+    return log;
+}
+
+/**
+ * Median-of-medians selection on the inclusive range ``[left, right]``;
+ * linear in the worst case.
+ */
+static void median_of_medians_select(
+    const ac_select_state *state,
+    size_t left,
+    size_t right,
+    size_t k
+) {
+    for (;;) {
+        size_t count = right - left + 1U;
+        if (count <= AC_SELECT_INSERTION_THRESHOLD) {
+            insertion_sort_range(state, left, right);
+            return;
+        }
+
+        // Gather the median of every full group of five at the front.
+        size_t groups = count / 5U;
+        for (size_t g = 0; g < groups; ++g) {
+            size_t first = left + (5U * g);
+            insertion_sort_range(state, first, first + 4U);
+            swap_at(state, left + g, first + 2U);
+        }
+        size_t median = left + (groups / 2U);
+        median_of_medians_select(state, left, left + groups - 1U, median);
+        memcpy(state->pivot, record_at(state, median), state->element_size);
+
+        // Three-way partition: [left, lt) < pivot, [lt, gt) == pivot,
+        // [gt, right] > pivot.
+        size_t lt = left;
+        size_t i = left;
+        size_t gt = right + 1U;
+        while (i < gt) {
+            int order = compare_to_pivot(state, i);
+            if (order < 0) {
+                swap_at(state, lt, i);
+                ++lt;
+                ++i;
+            } else if (order > 0) {
+                --gt;
+                swap_at(state, i, gt);
+            } else {
+                ++i;
+            }
+        }
+
+        if (k < lt) {
+            right = lt - 1U;
+        } else if (k >= gt) {
+            left = gt;
+        } else {
+            return;
+        }
+    }
+}
+
+/** Floyd-Rivest selection on the inclusive range ``[left, right]``. */
+static void floyd_rivest_select(
+    const ac_select_state *state,
+    size_t left,
+    size_t right,
+    size_t k,
+    size_t depth_limit
+) {
+    while (right > left) {
+        if (right - left < AC_SELECT_INSERTION_THRESHOLD) {
+            insertion_sort_range(state, left, right);
+            return;
+        }
+        if (depth_limit == 0) {
+            median_of_medians_select(state, left, right, k);
+            return;
+        }
+        --depth_limit;
+
+        if (right - left > AC_SELECT_SAMPLE_THRESHOLD) {
+            // Window of s ~ n^(2/3) / 2 records, shifted by about
+            // sqrt(ln(n) * s) / 2 towards the centre of the range.
+            size_t n = right - left + 1U;
+            size_t rank = k - left + 1U;
+            size_t cube = integer_cbrt(n);
+            double s = 0.5 * (double)cube * (double)cube;
+            double ln_n = 0.6931471805599453 * (double)floor_log2(n);
+            double spread = 0.5 * (double)integer_sqrt((size_t)(
+                                      ln_n * s * ((double)n - s) / (double)n
+                                  ));
+            if (rank < n / 2U) {
+                spread = -spread;
+            }
+            double low = (double)k - ((double)rank * s / (double)n) + spread;
+            double high =
+                (double)k + ((double)(n - rank) * s / (double)n) + spread;
+            size_t window_left = low > (double)left ? (size_t)low : left;
+            size_t window_right = high < (double)right ? (size_t)high : right;
+            if (window_left > k) {
+                window_left = k;
+            }
+            if (window_right < k) {
+                window_right = k;
+            }
+            floyd_rivest_select(
+                state, window_left, window_right, k, depth_limit
+            );
+        }
+
+        // Partition around the record now at ``k``.  The pivot is parked at
+        // one end so that both scans below always hit a sentinel.
+        memcpy(state->pivot, record_at(state, k), state->element_size);
+        size_t i = left;
+        size_t j = right;
+        swap_at(state, left, k);
+        if (compare_to_pivot(state, right) > 0) {
+            swap_at(state, right, left);
+        }
+        while (i < j) {
+            swap_at(state, i, j);
+            ++i;
+            --j;
+            while (compare_to_pivot(state, i) < 0) {
+                ++i;
+            }
+            while (compare_to_pivot(state, j) > 0) {
+                --j;
+            }
+        }
+        if (compare_to_pivot(state, left) == 0) {
+            swap_at(state, left, j);
+        } else {
+            ++j;
+            swap_at(state, j, right);
+        }
+
+        if (j == k) {
+            return;
+        }
+        if (j < k) {
+            left = j + 1U;
+        } else {
+            right = j - 1U;
+        }
+    }
+}
+
+int ac_nth_element(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t nth
+) {
+    if (data == NULL || compare == NULL || element_size == 0 || nth >= size) {
+        return -EINVAL;
+    }
+    if (size == 1U) {
+        return 0;
+    }
+
+    unsigned char stack_scratch[2U * AC_SELECT_STACK_SCRATCH];
+    unsigned char *scratch = stack_scratch;
+    if (element_size > AC_SELECT_STACK_SCRATCH) {
+        if (element_size > SIZE_MAX / 2U) {
+            return -ENOMEM;
+        }
+        scratch = (unsigned char *)malloc(2U * element_size);
+        if (scratch == NULL) {
+            return -ENOMEM;
+        }
+    }
+
+    ac_select_state state;
+    state.array = (unsigned char *)data;
+    state.element_size = element_size;
+    state.compare = compare;
+    state.pivot = scratch;
+    state.hold = scratch + element_size;
+
+    floyd_rivest_select(&state, 0U, size - 1U, nth, 2U * floor_log2(size));
+
+    if (scratch != stack_scratch) {
+        free(scratch);
+    }
+    return 0;
+}
+
+int ac_partial_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t k
+) {
+    if ((data == NULL && size != 0) || compare == NULL || element_size == 0) {
+        return -EINVAL;
+    }
+    if (k == 0 || size == 0) {
+        return 0;
+    }
+    if (k >= size) {
+        ac_quick_sort(data, size, element_size, compare);
+        return 0;
+    }
+
+    int status = ac_nth_element(data, size, element_size, compare, k - 1U);
+    if (status != 0) {
+        return status;
+    }
+    // data[k - 1] is already the largest of the prefix.
+    ac_quick_sort(data, k - 1U, element_size, compare);
+    return 0;
+}
+
+/**
+ * Sift the record held in ``value`` down a max-heap from ``root`` (whose slot
+ * is treated as a hole) and store it where it belongs.
+ */
+static void sift_down_value(
+    unsigned char *heap,
+    size_t root,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    const unsigned char *value
+) {
+    for (;;) {
+        size_t child = (2U * root) + 1U;
+        if (child >= size) {
+            break;
+        }
+        unsigned char *child_ptr = heap + (child * element_size);
+        if (child + 1U < size &&
+            compare(child_ptr, child_ptr + element_size) < 0) {
+            ++child;
+            child_ptr += element_size;
+        }
+        if (compare(value, child_ptr) >= 0) {
+            break;
+        }
+        memcpy(heap + (root * element_size), child_ptr, element_size);
+        root = child;
+    }
+    memcpy(heap + (root * element_size), value, element_size);
+}
+
+int ac_partial_sort_copy(
+    const void *src,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    void *dest,
+    size_t dest_size
+) {
+    if ((src == NULL && size != 0) || (dest == NULL && dest_size != 0) ||
+        compare == NULL || element_size == 0) {
+        return -EINVAL;
+    }
+    size_t kept = size < dest_size ? size : dest_size;
+    if (kept == 0) {
+        return 0;
+    }
+
+    unsigned char stack_scratch[AC_SELECT_STACK_SCRATCH];
+    unsigned char *scratch = stack_scratch;
+    if (element_size > sizeof(stack_scratch)) {
+        scratch = (unsigned char *)malloc(element_size);
+        if (scratch == NULL) {
+            return -ENOMEM;
+        }
+    }
+
+    const unsigned char *input = (const unsigned char *)src;
+    unsigned char *heap = (unsigned char *)dest;
+    memcpy(heap, input, kept * element_size);
+    for (size_t root = kept / 2U; root > 0; --root) {
+        memcpy(scratch, heap + ((root - 1U) * element_size), element_size);
+        sift_down_value(
+            heap, root - 1U, kept, element_size, compare, scratch
+        );
+    }
+
+    // heap[0] is the largest record kept so far; anything not smaller than
+    // it cannot be among the ``kept`` smallest.
+    for (size_t i = kept; i < size; ++i) {
+        const unsigned char *candidate = input + (i * element_size);
+        if (compare(candidate, heap) < 0) {
+            sift_down_value(heap, 0U, kept, element_size, compare, candidate);
+        }
+    }
+
+    for (size_t end = kept - 1U; end > 0; --end) {
+        unsigned char *last = heap + (end * element_size);
+        memcpy(scratch, last, element_size);
+        memcpy(last, heap, element_size);
+        sift_down_value(heap, 0U, end, element_size, compare, scratch);
+    }
+
+    if (scratch != stack_scratch) {
+        free(scratch);
+    }
+    return 0;
+}
@@ -0,0 +1,326 @@
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+#include "algorithms_c/utils/parallel.h"
+
+/*
+ * Parallel stable merge sort.
+ *
+ * The input is cut into a power-of-two number of chunks of at least
+ * ``AC_PARALLEL_MERGE_GRAIN`` elements.  Phase one sorts every chunk
+ * independently.  Phase two merges neighbouring runs level by level; instead
+ * of assigning one task per pair (which would leave the final merge to a
+ * single thread) every pair is cut into output slices of roughly equal size
+ * and each slice is located in both inputs with a co-rank ("merge path")
+ * binary search, so all levels expose ``threads``-way parallelism.
+ *
+ * Ties always resolve towards the left run, exactly as in ``ac_merge_sort``,
+ * so the result is byte-for-byte identical to the serial stable sort.
+ */
+
+/** Minimum number of elements handled by one chunk or merge slice. */
+#define AC_PARALLEL_MERGE_GRAIN 8192U
+
+/** Leaf runs of this size are sorted by insertion sort before merging. */
+#define AC_PARALLEL_MERGE_RUN 16U
+
+/** Merge slices created per thread at each level, for load balancing. */
+#define AC_PARALLEL_MERGE_SLICES_PER_THREAD 4U
+
+typedef struct {
+    unsigned char *array;
+    unsigned char *buffer;
+    size_t size;
+    size_t element_size;
+    ac_compare_fn compare;
+    /** Number of leaf chunks; always a power of two. */
+    size_t chunk_count;
+    /** Runs at the current level span ``2^level`` chunks. */
+    size_t level;
+    /** Source and destination of the current merge level. */
+    const unsigned char *src;
+    unsigned char *dst;
+    /** Output slice length used to split merges at the current level. */
+    size_t slice_size;
+    /** Prefix sums of slice counts per merge pair at the current level. */
+    size_t *slice_offsets;
+} ac_parallel_merge_state;
+
+static size_t chunk_bound(const ac_parallel_merge_state *state, size_t chunk) {
+    // Spread the remainder evenly so chunk sizes differ by at most one.
+    if (chunk >= state->chunk_count) {
+        return state->size;
+    }
+    size_t per_chunk = state->size / state->chunk_count;
+    size_t remainder = state->size % state->chunk_count;
+    return (chunk * per_chunk) + ((chunk * remainder) / state->chunk_count);
+}
+
+static void insertion_sort_run(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *scratch
+) {
+    for (size_t i = 1; i < size; ++i) {
+        unsigned char *current = array + (i * element_size);
+        if (AC_COMPARE(compare, current - element_size, current) <= 0) {
+            continue;
+        }
+        memcpy(scratch, current, element_size);
+        AC_COUNT_MOVES(1U);
+        size_t j = i;
+        do {
+            memcpy(
+                array + (j * element_size), array + ((j - 1U) * element_size),
+                element_size
+            );
+            AC_COUNT_MOVES(1U);
+            --j;
+        } while (j > 0 &&
+                 AC_COMPARE(
+                     compare, array + ((j - 1U) * element_size), scratch
+                 ) > 0);
+        memcpy(array + (j * element_size), scratch, element_size);
+        AC_COUNT_MOVES(1U);
+    }
+}
+
+/** Stable merge of ``left[0, left_size)`` and ``right[0, right_size)``. */
+static void merge_runs(
+    const unsigned char *left,
+    size_t left_size,
+    const unsigned char *right,
+    size_t right_size,
+    unsigned char *out,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < left_size && j < right_size) {
+        const unsigned char *l = left + (i * element_size);
+        const unsigned char *r = right + (j * element_size);
+        if (AC_COMPARE(compare, r, l) < 0) {
+            memcpy(out, r, element_size);
+            ++j;
+        } else {
+            memcpy(out, l, element_size);
+            ++i;
+        }
+        out += element_size;
+    }
+    if (i < left_size) {
+        memcpy(out, left + (i * element_size), (left_size - i) * element_size);
+        out += (left_size - i) * element_size;
+    }
+    if (j < right_size) {
+        memcpy(
+            out, right + (j * element_size), (right_size - j) * element_size
+        );
+    }
+    AC_COUNT_MOVES(left_size + right_size);
+}
+
+/**
+ * Return how many of the first ``diagonal`` outputs of the stable merge of
+ * ``left`` and ``right`` come from ``left`` (the merge-path co-rank).
+ */
+static size_t co_rank(
+    size_t diagonal,
+    const unsigned char *left,
+    size_t left_size,
+    const unsigned char *right,
+    size_t right_size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    size_t low = diagonal > right_size ? diagonal - right_size : 0U;
+    size_t high = diagonal < left_size ? diagonal : left_size;
+    while (low < high) {
+        size_t i = low + ((high - low) / 2U);
+        size_t j = diagonal - i;
+        // left[i] precedes right[j - 1] in a stable merge iff it is not
+        // greater, in which case more than ``i`` outputs come from ``left``.
+        if (AC_COMPARE(
+                compare, left + (i * element_size),
+                right + ((j - 1U) * element_size)
+            ) <= 0) {
+            low = i + 1U;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+/**
+ * Serially sort ``[begin, end)`` of the array, leaving the result in
+ * ``array`` and using the matching region of ``buffer`` as scratch.
+ */
+static void sort_chunk(void *context, size_t chunk) {
+    ac_parallel_merge_state *state = (ac_parallel_merge_state *)context;
+    size_t element_size = state->element_size;
+    size_t begin = chunk_bound(state, chunk);
+    size_t size = chunk_bound(state, chunk + 1U) - begin;
+    unsigned char *array = state->array + (begin * element_size);
+    unsigned char *buffer = state->buffer + (begin * element_size);
+
+    // The last slot of the buffer region is free while runs are being built,
+    // so it doubles as the insertion-sort scratch element.
+    for (size_t run = 0; run < size; run += AC_PARALLEL_MERGE_RUN) {
+        size_t run_size = size - run < AC_PARALLEL_MERGE_RUN
+                              ? size - run
+                              : AC_PARALLEL_MERGE_RUN;
+        insertion_sort_run(
+            array + (run * element_size), run_size, element_size,
+            state->compare, buffer + ((size - 1U) * element_size)
+        );
+    }
+
+    unsigned char *src = array;
+    unsigned char *dst = buffer;
+    for (size_t width = AC_PARALLEL_MERGE_RUN; width < size; width *= 2U) {
+        for (size_t left = 0; left < size; left += 2U * width) {
+            size_t mid = left + width < size ? left + width : size;
+            size_t right = mid + width < size ? mid + width : size;
+            merge_runs(
+                src + (left * element_size), mid - left,
+                src + (mid * element_size), right - mid,
+                dst + (left * element_size), element_size, state->compare
+            );
+        }
+        unsigned char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if (src != array) {
+        memcpy(array, src, size * element_size);
+        AC_COUNT_MOVES(size);
+    }
+}
+
+/** Merge one output slice of one run pair at the current level. */
+static void merge_slice(void *context, size_t task) {
+    ac_parallel_merge_state *state = (ac_parallel_merge_state *)context;
+    size_t element_size = state->element_size;
+    size_t span = (size_t)1U << state->level;
+
+    // Locate the pair owning this task through the slice prefix sums.
+    size_t pair = 0;
+    while (state->slice_offsets[pair + 1U] <= task) {
+        ++pair;
+    }
+    size_t slice = task - state->slice_offsets[pair];
+
+    size_t begin = chunk_bound(state, pair * 2U * span);
+    size_t mid = chunk_bound(state, (pair * 2U * span) + span);
+    size_t end = chunk_bound(state, (pair + 1U) * 2U * span);
+    const unsigned char *left = state->src + (begin * element_size);
+    const unsigned char *right = state->src + (mid * element_size);
+    size_t left_size = mid - begin;
+    size_t right_size = end - mid;
+    size_t total = end - begin;
+
+    size_t first = slice * state->slice_size;
+    size_t last = first + state->slice_size < total ? first + state->slice_size
+                                                     : total;
+    size_t i0 = co_rank(
+        first, left, left_size, right, right_size, element_size, state->compare
+    );
+    size_t i1 = co_rank(
+        last, left, left_size, right, right_size, element_size, state->compare
+    );
+    size_t j0 = first - i0;
+    size_t j1 = last - i1;
+
+    merge_runs(
+        left + (i0 * element_size), i1 - i0, right + (j0 * element_size),
+        j1 - j0, state->dst + ((begin + first) * element_size), element_size,
+        state->compare
+    );
+}
+
+void ac_merge_sort_parallel(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t threads
+) {
+    if (data == NULL || compare == NULL || element_size == 0 || size < 2U) {
+        return;
+    }
+    if (threads == 0) {
+        threads = ac_parallel_hardware_threads();
+    }
+
+    size_t chunk_count = 1U;
+    while (chunk_count < threads &&
+           size / (chunk_count * 2U) >= AC_PARALLEL_MERGE_GRAIN) {
+        chunk_count *= 2U;
+    }
+    if (chunk_count == 1U) {
+        ac_merge_sort(data, size, element_size, compare);
+        return;
+    }
+
+    unsigned char *buffer = (unsigned char *)malloc(size * element_size);
+    size_t *slice_offsets =
+        (size_t *)malloc(((chunk_count / 2U) + 1U) * sizeof(size_t));
+    if (buffer == NULL || slice_offsets == NULL) {
+        free(buffer);
+        free(slice_offsets);
+        ac_merge_sort(data, size, element_size, compare);
+        return;
+    }
+
+    ac_parallel_merge_state state;
+    state.array = (unsigned char *)data;
+    state.buffer = buffer;
+    state.size = size;
+    state.element_size = element_size;
+    state.compare = compare;
+    state.chunk_count = chunk_count;
+    state.slice_offsets = slice_offsets;
+
+    ac_parallel_for(chunk_count, threads, sort_chunk, &state);
+
+    size_t slice_size = size / (threads * AC_PARALLEL_MERGE_SLICES_PER_THREAD);
+    if (slice_size < AC_PARALLEL_MERGE_GRAIN) {
+        slice_size = AC_PARALLEL_MERGE_GRAIN;
+    }
+    state.slice_size = slice_size;
+
+    unsigned char *src = state.array;
+    unsigned char *dst = buffer;
+    for (state.level = 0; ((size_t)1U << state.level) < chunk_count;
+         ++state.level) {
+        size_t span = (size_t)1U << state.level;
+        size_t pairs = chunk_count / (2U * span);
+        slice_offsets[0] = 0;
+        for (size_t pair = 0; pair < pairs; ++pair) {
+            size_t total = chunk_bound(&state, (pair + 1U) * 2U * span) -
+                           chunk_bound(&state, pair * 2U * span);
+            slice_offsets[pair + 1U] =
+                slice_offsets[pair] + ((total + slice_size - 1U) / slice_size);
+        }
+
+        state.src = src;
+        state.dst = dst;
+        ac_parallel_for(slice_offsets[pairs], threads, merge_slice, &state);
+
+        unsigned char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != state.array) {
+        memcpy(state.array, src, size * element_size);
+        AC_COUNT_MOVES(size);
+    }
+    free(buffer);
+    free(slice_offsets);
+}
@@ -1,7 +1,39 @@
+#include <errno.h>
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+
+/*
+ * Introsort engine behind ``ac_quick_sort``.
+ *
+ * The translated Python routine pivots on the last element with a Lomuto
+ * partition and recurses on both sides, which degrades to quadratic time (and
+ * linear recursion depth) on sorted or all-equal input.  The engine below keeps
+ * the same signature but combines the classic production refinements:
+ *
+ * - pivots are chosen with median-of-three, or Tukey's ninther on larger
+ *   ranges, so sorted and reversed inputs split evenly;
+ * - partitioning is three-way (Bentley-McIlroy "fat" partition), so runs of
+ *   keys equal to the pivot are finished in a single pass;
+ * - the smaller side is sorted recursively while the larger side is handled by
+ *   the enclosing loop, bounding the stack depth by ``O(log n)``;
+ * - short ranges are finished by insertion sort;
+ * - once the recursion budget ``2 * floor(log2(n))`` is exhausted the range is
+ *   handed to the bottom-up heap sort of ``ac_heap_sort_ws``, which
+ *   guarantees ``O(n log n)`` time overall without allocating.
+ */
+
+/** Ranges at or below this size are finished by insertion sort. */
+#define AC_INTROSORT_INSERTION_THRESHOLD 16U
+
+/** Ranges above this size use the ninther instead of median-of-three. */
+#define AC_INTROSORT_NINTHER_THRESHOLD 128U
+
+/** Elements up to this width are swapped through a stack buffer. */
+#define AC_INTROSORT_STACK_SCRATCH 256U
 
 static void swap_elements(
     unsigned char *a,
@@ -15,54 +47,269 @@ static void swap_elements(
     memcpy(scratch, a, element_size);
     memcpy(a, b, element_size);
     memcpy(b, scratch, element_size);
+    AC_COUNT_MOVES(3U);
+}
+
+/** Swap ``count`` consecutive elements starting at ``a`` and ``b``. */
+static void swap_ranges(
+    unsigned char *a,
+    unsigned char *b,
+    size_t count,
+    size_t element_size,
+    unsigned char *scratch
+) {
+    for (size_t i = 0; i < count; ++i) {
+        swap_elements(
+            a + (i * element_size), b + (i * element_size), element_size,
+            scratch
+        );
+    }
 }
 
-static size_t partition(
+static void insertion_sort_range(
     unsigned char *array,
-    size_t low,
-    size_t high,
+    size_t size,
     size_t element_size,
     ac_compare_fn compare,
     unsigned char *scratch
 ) {
-    unsigned char *pivot = array + (high * element_size);
-    size_t i = low;
-
-    for (size_t j = low; j < high; ++j) {
-        unsigned char *current = array + (j * element_size);
-        if (compare(current, pivot) < 0) {
-            swap_elements(
-                array + (i * element_size), current, element_size, scratch
+    for (size_t i = 1; i < size; ++i) {
+        unsigned char *current = array + (i * element_size);
+        if (AC_COMPARE(compare, current - element_size, current) <= 0) {
+            continue;
+        }
+
+        memcpy(scratch, current, element_size);
+        AC_COUNT_MOVES(1U);
+        size_t j = i;
+        do {
+            memcpy(
+                array + (j * element_size), array + ((j - 1U) * element_size),
+                element_size
             );
-            ++i;
+            AC_COUNT_MOVES(1U);
+            --j;
+        } while (j > 0 &&
+                 AC_COMPARE(
+                     compare, array + ((j - 1U) * element_size), scratch
+                 ) > 0);
+        memcpy(array + (j * element_size), scratch, element_size);
+        AC_COUNT_MOVES(1U);
+    }
+}
+
+/**
+ * Heap sort used once the introsort depth budget runs out.  It borrows
+ * ``scratch`` through a workspace, so the fallback never allocates.
+ */
+static void heap_sort_range(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *scratch
+) {
+    ac_sort_workspace workspace;
+    ac_sort_workspace_init_buffer(&workspace, scratch, element_size);
+    ac_heap_sort_ws(&workspace, array, size, element_size, compare);
+}
+
+/** Return whichever of ``a``, ``b`` and ``c`` holds the median element. */
+static size_t median_of_three_index(
+    const unsigned char *array,
+    size_t a,
+    size_t b,
+    size_t c,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    const unsigned char *pa = array + (a * element_size);
+    const unsigned char *pb = array + (b * element_size);
+    const unsigned char *pc = array + (c * element_size);
+
+    if (AC_COMPARE(compare, pa, pb) < 0) {
+        if (AC_COMPARE(compare, pb, pc) < 0) {
+            return b;
         }
+        return AC_COMPARE(compare, pa, pc) < 0 ? c : a;
+    }
+    if (AC_COMPARE(compare, pa, pc) < 0) {
+        return a;
     }
+    return AC_COMPARE(compare, pb, pc) < 0 ? c : b;
+}
+
+static size_t choose_pivot(
+    const unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    size_t last = size - 1U;
+    size_t mid = size / 2U;
 
-    swap_elements(array + (i * element_size), pivot, element_size, scratch);
-    return i;
+    if (size <= AC_INTROSORT_NINTHER_THRESHOLD) {
+        return median_of_three_index(
+            array, 0U, mid, last, element_size, compare
+        );
+    }
+
+    // Tukey's ninther: the median of three medians-of-three sampled across the
+    // whole range resists organ-pipe and sawtooth patterns that defeat a
+    // single median-of-three.
+    size_t step = size / 8U;
+    size_t lo = median_of_three_index(
+        array, 0U, step, 2U * step, element_size, compare
+    );
+    size_t md = median_of_three_index(
+        array, mid - step, mid, mid + step, element_size, compare
+    );
+    size_t hi = median_of_three_index(
+        array, last - (2U * step), last - step, last, element_size, compare
+    );
+    return median_of_three_index(array, lo, md, hi, element_size, compare);
 }
 
-static void quick_sort_recursive(
+/*
+ * Bentley-McIlroy three-way partition of ``array[0, size)`` around the pivot
+ * stored at ``array[0]``.  On return ``[0, *out_less)`` holds elements smaller
+ * than the pivot and ``[size - *out_greater, size)`` holds larger ones; the
+ * block between them equals the pivot and is already in its final place.
+ */
+static void partition_three_way(
     unsigned char *array,
-    size_t low,
-    size_t high,
+    size_t size,
     size_t element_size,
     ac_compare_fn compare,
-    unsigned char *scratch
+    unsigned char *scratch,
+    size_t *out_less,
+    size_t *out_greater
 ) {
-    if (high <= low) {
-        return;
+    const unsigned char *pivot = array;
+    size_t a = 1U;
+    size_t b = 1U;
+    size_t c = size - 1U;
+    size_t d = size - 1U;
+
+    // Invariant: [0, a) == pivot, [a, b) < pivot, (c, d] > pivot and
+    // (d, size) == pivot.  Equal keys are parked at both ends while scanning.
+    for (;;) {
+        while (b <= c) {
+            int order = AC_COMPARE(compare, array + (b * element_size), pivot);
+            if (order > 0) {
+                break;
+            }
+            if (order == 0) {
+                swap_elements(
+                    array + (a * element_size), array + (b * element_size),
+                    element_size, scratch
+                );
+                ++a;
+            }
+            ++b;
+        }
+        while (b <= c) {
+            int order = AC_COMPARE(compare, array + (c * element_size), pivot);
+            if (order < 0) {
+                break;
+            }
+            if (order == 0) {
+                swap_elements(
+                    array + (c * element_size), array + (d * element_size),
+                    element_size, scratch
+                );
+                --d;
+            }
+            --c;
+        }
+        if (b > c) {
+            break;
+        }
+        swap_elements(
+            array + (b * element_size), array + (c * element_size),
+            element_size, scratch
+        );
+        ++b;
+        --c;
     }
 
-    size_t pivot_index =
-        partition(array, low, high, element_size, compare, scratch);
-    if (pivot_index > 0) {
-        quick_sort_recursive(
-            array, low, pivot_index - 1, element_size, compare, scratch
+    // Move both equal blocks into the middle of the range.
+    size_t less = b - a;
+    size_t greater = d - c;
+    size_t count = a < less ? a : less;
+    swap_ranges(
+        array, array + ((b - count) * element_size), count, element_size,
+        scratch
+    );
+    count = greater < (size - 1U - d) ? greater : (size - 1U - d);
+    swap_ranges(
+        array + (b * element_size), array + ((size - count) * element_size),
+        count, element_size, scratch
+    );
+
+    *out_less = less;
+    *out_greater = greater;
+}
+
+static void introsort_loop(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *scratch,
+    size_t depth_limit
+) {
+    while (size > AC_INTROSORT_INSERTION_THRESHOLD) {
+        if (depth_limit == 0) {
+            heap_sort_range(array, size, element_size, compare, scratch);
+            return;
+        }
+        --depth_limit;
+
+        size_t pivot = choose_pivot(array, size, element_size, compare);
+        swap_elements(
+            array, array + (pivot * element_size), element_size, scratch
+        );
+
+        size_t less = 0;
+        size_t greater = 0;
+        partition_three_way(
+            array, size, element_size, compare, scratch, &less, &greater
         );
+
+        unsigned char *upper = array + ((size - greater) * element_size);
+        if (less < greater) {
+            introsort_loop(
+                array, less, element_size, compare, scratch, depth_limit
+            );
+            array = upper;
+            size = greater;
+        } else {
+            introsort_loop(
+                upper, greater, element_size, compare, scratch, depth_limit
+            );
+            size = less;
+        }
+    }
+
+    insertion_sort_range(array, size, element_size, compare, scratch);
+}
+
+static void introsort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *scratch
+) {
+    size_t depth_limit = 0;
+    for (size_t n = size; n > 1U; n >>= 1U) {
+        depth_limit += 2U;
     }
-    quick_sort_recursive(
-        array, pivot_index + 1, high, element_size, compare, scratch
+
+    introsort_loop(
+        (unsigned char *)data, size, element_size, compare, scratch,
+        depth_limit
     );
 }
 
@@ -80,31 +327,46 @@ void ac_quick_sort(
         return;
     }
 
-    unsigned char *scratch = (unsigned char *)malloc(element_size);
-    if (scratch == NULL) {
-        return;
+    unsigned char stack_scratch[AC_INTROSORT_STACK_SCRATCH];
+    unsigned char *scratch = stack_scratch;
+    if (element_size > sizeof(stack_scratch)) {
+        scratch = (unsigned char *)malloc(element_size);
+        if (scratch == NULL) {
+            return;
+        }
     }
 
-    quick_sort_recursive(
-        (unsigned char *)data, 0, size - 1, element_size, compare, scratch
-    );
-    free(scratch);
+    introsort(data, size, element_size, compare, scratch);
+
+    if (scratch != stack_scratch) {
+        free(scratch);
+    }
 }
 
-static int ac_compare_double_local(const void *lhs, const void *rhs) {
-    const double left = *(const double *)lhs;
-    const double right = *(const double *)rhs;
-    if (left < right) {
-        return -1;
+int ac_quick_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
     }
-    if (left > right) {
-        return 1;
+    if (size < 2U) {
+        return 0;
+    }
+
+    unsigned char *scratch = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (scratch == NULL) {
+        return -ENOSPC;
     }
-    return 0;
-}
 
-void ac_quick_sort_double(double *data, size_t size) {
-    ac_quick_sort(data, size, sizeof(double), ac_compare_double_local);
+    introsort(data, size, element_size, compare, scratch);
+    return 0;
 }
 
 int ac_split_double_by_pivot(
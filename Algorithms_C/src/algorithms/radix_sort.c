@@ -0,0 +1,272 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/sorting.h"
+
+/*
+ * Byte-wise LSD radix engine for 32- and 64-bit keys.
+ *
+ * Every supported element type is first mapped to an unsigned key whose
+ * natural order matches the desired order of the values:
+ *
+ * - unsigned integers are used as-is;
+ * - signed integers flip the sign bit so negatives sort first;
+ * - IEEE floats flip every bit of negative values and only the sign bit of
+ *   positive ones.  This yields the total order
+ *   ``-NaN < -inf < ... < -0.0 < +0.0 < ... < +inf < +NaN``.
+ *
+ * The mapping is applied on the fly whenever a digit is extracted, so the
+ * stored values never change representation.  All digit histograms are built
+ * in one read pass, passes whose digit is shared by every key are skipped,
+ * and each remaining pass scatters between the input and a single scratch
+ * buffer (ping-pong) instead of copying back after every digit.
+ */
+
+/** Digits are 11 bits wide: three passes for 32-bit keys, six for 64-bit. */
+#define AC_RADIX_DIGIT_BITS 11U
+#define AC_RADIX_BUCKETS (1U << AC_RADIX_DIGIT_BITS)
+#define AC_RADIX_DIGIT_MASK (AC_RADIX_BUCKETS - 1U)
+#define AC_RADIX_PASSES_32 3U
+#define AC_RADIX_PASSES_64 6U
+
+/** Inputs at or below this size are finished by insertion sort on the keys. */
+#define AC_RADIX_SMALL_SIZE 64U
+
+_Static_assert(
+    sizeof(float) == sizeof(uint32_t) && sizeof(double) == sizeof(uint64_t),
+    "radix float mapping expects IEEE binary32/binary64 layouts"
+);
+
+typedef enum {
+    AC_RADIX_UNSIGNED,
+    AC_RADIX_SIGNED,
+    AC_RADIX_FLOAT,
+} ac_radix_mode;
+
+static uint32_t map_key32(uint32_t bits, ac_radix_mode mode) {
+    uint32_t sign = bits >> 31U;
+    uint32_t mask = 0U;
+    if (mode == AC_RADIX_SIGNED) {
+        mask = UINT32_C(0x80000000);
+    } else if (mode == AC_RADIX_FLOAT) {
+        mask = (UINT32_C(0) - sign) | UINT32_C(0x80000000);
+    }
+    return bits ^ mask;
+}
+
+static uint64_t map_key64(uint64_t bits, ac_radix_mode mode) {
+    uint64_t sign = bits >> 63U;
+    uint64_t mask = 0U;
+    if (mode == AC_RADIX_SIGNED) {
+        mask = UINT64_C(0x8000000000000000);
+    } else if (mode == AC_RADIX_FLOAT) {
+        mask = (UINT64_C(0) - sign) | UINT64_C(0x8000000000000000);
+    }
+    return bits ^ mask;
+}
+
+/*
+ * Values are loaded and stored through ``memcpy`` so that float and double
+ * storage can be processed as raw bits without violating aliasing rules; the
+ * compiler lowers these calls to plain moves.
+ */
+static uint32_t load32(const unsigned char *base, size_t index) {
+    uint32_t value;
+    memcpy(&value, base + (index * sizeof(value)), sizeof(value));
+    return value;
+}
+
+static void store32(unsigned char *base, size_t index, uint32_t value) {
+    memcpy(base + (index * sizeof(value)), &value, sizeof(value));
+}
+
+static uint64_t load64(const unsigned char *base, size_t index) {
+    uint64_t value;
+    memcpy(&value, base + (index * sizeof(value)), sizeof(value));
+    return value;
+}
+
+static void store64(unsigned char *base, size_t index, uint64_t value) {
+    memcpy(base + (index * sizeof(value)), &value, sizeof(value));
+}
+
+static void insertion_sort32(
+    unsigned char *data,
+    size_t size,
+    ac_radix_mode mode
+) {
+    for (size_t i = 1; i < size; ++i) {
+        uint32_t value = load32(data, i);
+        uint32_t key = map_key32(value, mode);
+        size_t j = i;
+        while (j > 0 && map_key32(load32(data, j - 1U), mode) > key) {
+            store32(data, j, load32(data, j - 1U));
+            --j;
+        }
+        store32(data, j, value);
+    }
+}
+
+static void insertion_sort64(
+    unsigned char *data,
+    size_t size,
+    ac_radix_mode mode
+) {
+    for (size_t i = 1; i < size; ++i) {
+        uint64_t value = load64(data, i);
+        uint64_t key = map_key64(value, mode);
+        size_t j = i;
+        while (j > 0 && map_key64(load64(data, j - 1U), mode) > key) {
+            store64(data, j, load64(data, j - 1U));
+            --j;
+        }
+        store64(data, j, value);
+    }
+}
+
+/**
+ * Turn per-digit counts into starting offsets.  Returns ``0`` when a single
+ * bucket holds every key, meaning the pass would not move anything.
+ */
+static int prefix_offsets(size_t *counts, size_t size) {
+    size_t total = 0;
+    for (size_t bucket = 0; bucket < AC_RADIX_BUCKETS; ++bucket) {
+        size_t count = counts[bucket];
+        if (count == size) {
+            return 0;
+        }
+        counts[bucket] = total;
+        total += count;
+    }
+    return 1;
+}
+
+static void radix_sort32(unsigned char *data, size_t size, ac_radix_mode mode) {
+    if (data == NULL || size < 2U) {
+        return;
+    }
+    if (size <= AC_RADIX_SMALL_SIZE) {
+        insertion_sort32(data, size, mode);
+        return;
+    }
+
+    size_t *counts =
+        (size_t *)calloc(AC_RADIX_PASSES_32 * AC_RADIX_BUCKETS, sizeof(size_t));
+    unsigned char *scratch = (unsigned char *)malloc(size * sizeof(uint32_t));
+    if (counts == NULL || scratch == NULL) {
+        free(counts);
+        free(scratch);
+        return;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        uint32_t key = map_key32(load32(data, i), mode);
+        for (unsigned pass = 0; pass < AC_RADIX_PASSES_32; ++pass) {
+            counts[(pass * AC_RADIX_BUCKETS) +
+                   ((key >> (pass * AC_RADIX_DIGIT_BITS)) &
+                    AC_RADIX_DIGIT_MASK)]++;
+        }
+    }
+
+    unsigned char *src = data;
+    unsigned char *dst = scratch;
+    for (unsigned pass = 0; pass < AC_RADIX_PASSES_32; ++pass) {
+        size_t *offsets = counts + (pass * AC_RADIX_BUCKETS);
+        if (!prefix_offsets(offsets, size)) {
+            continue;
+        }
+        unsigned shift = pass * AC_RADIX_DIGIT_BITS;
+        for (size_t i = 0; i < size; ++i) {
+            uint32_t value = load32(src, i);
+            uint32_t digit =
+                (map_key32(value, mode) >> shift) & AC_RADIX_DIGIT_MASK;
+            store32(dst, offsets[digit]++, value);
+        }
+        unsigned char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != data) {
+        memcpy(data, src, size * sizeof(uint32_t));
+    }
+    free(counts);
+    free(scratch);
+}
+
+static void radix_sort64(unsigned char *data, size_t size, ac_radix_mode mode) {
+    if (data == NULL || size < 2U) {
+        return;
+    }
+    if (size <= AC_RADIX_SMALL_SIZE) {
+        insertion_sort64(data, size, mode);
+        return;
+    }
+
+    size_t *counts =
+        (size_t *)calloc(AC_RADIX_PASSES_64 * AC_RADIX_BUCKETS, sizeof(size_t));
+    unsigned char *scratch = (unsigned char *)malloc(size * sizeof(uint64_t));
+    if (counts == NULL || scratch == NULL) {
+        free(counts);
+        free(scratch);
+        return;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        uint64_t key = map_key64(load64(data, i), mode);
+        for (unsigned pass = 0; pass < AC_RADIX_PASSES_64; ++pass) {
+            counts[(pass * AC_RADIX_BUCKETS) +
+                   (size_t)((key >> (pass * AC_RADIX_DIGIT_BITS)) &
+                            AC_RADIX_DIGIT_MASK)]++;
+        }
+    }
+
+    unsigned char *src = data;
+    unsigned char *dst = scratch;
+    for (unsigned pass = 0; pass < AC_RADIX_PASSES_64; ++pass) {
+        size_t *offsets = counts + (pass * AC_RADIX_BUCKETS);
+        if (!prefix_offsets(offsets, size)) {
+            continue;
+        }
+        unsigned shift = pass * AC_RADIX_DIGIT_BITS;
+        for (size_t i = 0; i < size; ++i) {
+            uint64_t value = load64(src, i);
+            size_t digit = (size_t)((map_key64(value, mode) >> shift) &
+                                    AC_RADIX_DIGIT_MASK);
+            store64(dst, offsets[digit]++, value);
+        }
+        unsigned char *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != data) {
+        memcpy(data, src, size * sizeof(uint64_t));
+    }
+    free(counts);
+    free(scratch);
+}
+
+void ac_radix_sort_uint32(uint32_t *data, size_t size) {
+    radix_sort32((unsigned char *)data, size, AC_RADIX_UNSIGNED);
+}
+
+void ac_radix_sort_int32(int32_t *data, size_t size) {
+    radix_sort32((unsigned char *)data, size, AC_RADIX_SIGNED);
+}
+
+void ac_radix_sort_float(float *data, size_t size) {
+    radix_sort32((unsigned char *)data, size, AC_RADIX_FLOAT);
+}
+
+void ac_radix_sort_uint64(uint64_t *data, size_t size) {
+    radix_sort64((unsigned char *)data, size, AC_RADIX_UNSIGNED);
+}
+
+void ac_radix_sort_int64(int64_t *data, size_t size) {
+    radix_sort64((unsigned char *)data, size, AC_RADIX_SIGNED);
+}
+
+void ac_radix_sort_double(double *data, size_t size) {
+    radix_sort64((unsigned char *)data, size, AC_RADIX_FLOAT);
+}
@@ -0,0 +1,274 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+#include "algorithms_c/utils/parallel.h"
+
+/*
+ * Parallel samplesort.
+ *
+ * 1. A deterministic pseudo-random sample of ``buckets * oversampling``
+ *    elements is sorted and every ``oversampling``-th element becomes a
+ *    splitter.  The ``buckets - 1`` splitters are stored as an implicit binary
+ *    search tree (Eytzinger layout, root at index 1).
+ * 2. The input is cut into blocks.  Each block walks every element down the
+ *    splitter tree with ``node = 2 * node + (splitter < element)``, which has
+ *    no data-dependent branch apart from the comparator itself, records the
+ *    resulting bucket id in a one-byte oracle and counts bucket sizes.
+ * 3. Exclusive prefix sums over (bucket, block) give every block a private
+ *    output window per bucket, so the scatter into the scratch buffer needs no
+ *    synchronisation and each element moves exactly once.
+ * 4. Buckets are sorted independently with ``ac_quick_sort`` and copied back.
+ *
+ * Compared to merge-based parallelism every element is moved twice in total
+ * regardless of the thread count, which is what makes the algorithm scale.
+ */
+
+/** Inputs below this size are sorted serially by ``ac_quick_sort``. */
+#define AC_SAMPLE_SORT_MIN_SIZE 65536U
+
+/** Minimum number of elements classified by one block task. */
+#define AC_SAMPLE_SORT_BLOCK 16384U
+
+/** Upper bound on the bucket count; bucket ids must fit in one byte. */
+#define AC_SAMPLE_SORT_MAX_BUCKETS 256U
+
+/** Buckets created per thread so that dynamic scheduling can balance load. */
+#define AC_SAMPLE_SORT_BUCKETS_PER_THREAD 8U
+
+/** Sample elements drawn per bucket. */
+#define AC_SAMPLE_SORT_OVERSAMPLING 32U
+
+typedef struct {
+    unsigned char *data;
+    unsigned char *buffer;
+    size_t size;
+    size_t element_size;
+    ac_compare_fn compare;
+    /** Splitters in Eytzinger order; slot 0 is unused. */
+    const unsigned char *tree;
+    unsigned log_buckets;
+    size_t bucket_count;
+    size_t block_size;
+    size_t block_count;
+    /** Bucket id of every input element. */
+    uint8_t *oracle;
+    /** ``block_count * bucket_count`` counts, later turned into offsets. */
+    size_t *offsets;
+    /** ``bucket_count + 1`` bucket boundaries in the scratch buffer. */
+    size_t *bucket_bounds;
+} ac_sample_sort_state;
+
+static size_t block_end(const ac_sample_sort_state *state, size_t block) {
+    size_t end = (block + 1U) * state->block_size;
+    return end < state->size ? end : state->size;
+}
+
+static void classify_block(void *context, size_t block) {
+    ac_sample_sort_state *state = (ac_sample_sort_state *)context;
+    size_t element_size = state->element_size;
+    size_t *counts = state->offsets + (block * state->bucket_count);
+    size_t end = block_end(state, block);
+
+    for (size_t i = block * state->block_size; i < end; ++i) {
+        const unsigned char *element = state->data + (i * element_size);
+        size_t node = 1U;
+        for (unsigned level = 0; level < state->log_buckets; ++level) {
+            node = (2U * node) +
+                   (size_t)(AC_COMPARE(
+                                state->compare,
+                                state->tree + (node * element_size), element
+                            ) < 0);
+        }
+        size_t bucket = node - state->bucket_count;
+        state->oracle[i] = (uint8_t)bucket;
+        ++counts[bucket];
+    }
+}
+
+static void scatter_block(void *context, size_t block) {
+    ac_sample_sort_state *state = (ac_sample_sort_state *)context;
+    size_t element_size = state->element_size;
+    size_t *offsets = state->offsets + (block * state->bucket_count);
+    size_t end = block_end(state, block);
+
+    for (size_t i = block * state->block_size; i < end; ++i) {
+        memcpy(
+            state->buffer + (offsets[state->oracle[i]]++ * element_size),
+            state->data + (i * element_size), element_size
+        );
+    }
+    AC_COUNT_MOVES(end - (block * state->block_size));
+}
+
+static void sort_bucket(void *context, size_t bucket) {
+    ac_sample_sort_state *state = (ac_sample_sort_state *)context;
+    size_t element_size = state->element_size;
+    size_t begin = state->bucket_bounds[bucket];
+    size_t count = state->bucket_bounds[bucket + 1U] - begin;
+    unsigned char *source = state->buffer + (begin * element_size);
+
+    ac_quick_sort(source, count, element_size, state->compare);
+    memcpy(state->data + (begin * element_size), source, count * element_size);
+    AC_COUNT_MOVES(count);
+}
+
+/** Fill the subtree rooted at ``node`` with the next sorted splitters. */
+static void build_tree(
+    unsigned char *tree,
+    size_t node,
+    size_t node_count,
+    const unsigned char *splitters,
+    size_t *next,
+    size_t element_size
+) {
+    // An in-order walk of the implicit tree visits nodes in sorted order.
+    if (node > node_count) {
+        return;
+    }
+    build_tree(tree, 2U * node, node_count, splitters, next, element_size);
+    memcpy(
+        tree + (node * element_size), splitters + (*next * element_size),
+        element_size
+    );
+    AC_COUNT_MOVES(1U);
+    ++*next;
+    build_tree(
+        tree, (2U * node) + 1U, node_count, splitters, next, element_size
+    );
+}
+
+/**
+ * Draw the oversampled splitters and lay them out as a search tree.  Returns
+ * ``0`` on allocation failure.
+ */
+static int choose_splitters(ac_sample_sort_state *state, unsigned char *tree) {
+    size_t element_size = state->element_size;
+    size_t sample_count = state->bucket_count * AC_SAMPLE_SORT_OVERSAMPLING;
+    unsigned char *sample =
+        (unsigned char *)malloc(sample_count * element_size);
+    if (sample == NULL) {
+        return 0;
+    }
+
+    // A fixed xorshift sequence keeps runs reproducible while avoiding the
+    // pathological splitters a strided sample picks on periodic inputs.
+    uint64_t seed = UINT64_C(0x9E3779B97F4A7C15) ^ (uint64_t)state->size;
+    for (size_t i = 0; i < sample_count; ++i) {
+        seed ^= seed << 13U;
+        seed ^= seed >> 7U;
+        seed ^= seed << 17U;
+        size_t index = (size_t)(seed % (uint64_t)state->size);
+        memcpy(
+            sample + (i * element_size), state->data + (index * element_size),
+            element_size
+        );
+        AC_COUNT_MOVES(1U);
+    }
+    ac_quick_sort(sample, sample_count, element_size, state->compare);
+
+    // Keep every ``oversampling``-th sample; splitter ``b - 1`` is the upper
+    // bound of bucket ``b - 1``.
+    for (size_t b = 1; b < state->bucket_count; ++b) {
+        memmove(
+            sample + ((b - 1U) * element_size),
+            sample + ((b * AC_SAMPLE_SORT_OVERSAMPLING) * element_size),
+            element_size
+        );
+        AC_COUNT_MOVES(1U);
+    }
+    size_t next = 0;
+    build_tree(tree, 1U, state->bucket_count - 1U, sample, &next, element_size);
+    free(sample);
+    return 1;
+}
+
+void ac_sample_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    size_t threads
+) {
+    if (data == NULL || compare == NULL || element_size == 0 || size < 2U) {
+        return;
+    }
+    if (threads == 0) {
+        threads = ac_parallel_hardware_threads();
+    }
+    if (threads < 2U || size < AC_SAMPLE_SORT_MIN_SIZE) {
+        ac_quick_sort(data, size, element_size, compare);
+        return;
+    }
+
+    ac_sample_sort_state state;
+    state.data = (unsigned char *)data;
+    state.size = size;
+    state.element_size = element_size;
+    state.compare = compare;
+    state.log_buckets = 1U;
+    while ((1U << state.log_buckets) < AC_SAMPLE_SORT_MAX_BUCKETS &&
+           (1U << state.log_buckets) <
+               threads * AC_SAMPLE_SORT_BUCKETS_PER_THREAD) {
+        ++state.log_buckets;
+    }
+    state.bucket_count = (size_t)1U << state.log_buckets;
+
+    state.block_count = threads * 4U;
+    if (state.block_count > size / AC_SAMPLE_SORT_BLOCK) {
+        state.block_count = size / AC_SAMPLE_SORT_BLOCK;
+    }
+    if (state.block_count == 0) {
+        state.block_count = 1U;
+    }
+    state.block_size = (size + state.block_count - 1U) / state.block_count;
+
+    state.buffer = (unsigned char *)malloc(size * element_size);
+    state.oracle = (uint8_t *)malloc(size);
+    state.offsets = (size_t *)calloc(
+        state.block_count * state.bucket_count, sizeof(size_t)
+    );
+    state.bucket_bounds =
+        (size_t *)malloc((state.bucket_count + 1U) * sizeof(size_t));
+    unsigned char *tree =
+        (unsigned char *)malloc(state.bucket_count * element_size);
+    if (state.buffer == NULL || state.oracle == NULL || state.offsets == NULL ||
+        state.bucket_bounds == NULL || tree == NULL ||
+        !choose_splitters(&state, tree)) {
+        free(state.buffer);
+        free(state.oracle);
+        free(state.offsets);
+        free(state.bucket_bounds);
+        free(tree);
+        ac_quick_sort(data, size, element_size, compare);
+        return;
+    }
+    state.tree = tree;
+
+    ac_parallel_for(state.block_count, threads, classify_block, &state);
+
+    // Bucket-major prefix sums: bucket b of block k lands right after bucket
+    // b of block k - 1, so the scatter preserves block order within a bucket.
+    size_t total = 0;
+    for (size_t bucket = 0; bucket < state.bucket_count; ++bucket) {
+        state.bucket_bounds[bucket] = total;
+        for (size_t block = 0; block < state.block_count; ++block) {
+            size_t *slot =
+                state.offsets + (block * state.bucket_count) + bucket;
+            size_t count = *slot;
+            *slot = total;
+            total += count;
+        }
+    }
+    state.bucket_bounds[state.bucket_count] = total;
+
+    ac_parallel_for(state.block_count, threads, scatter_block, &state);
+    ac_parallel_for(state.bucket_count, threads, sort_bucket, &state);
+
+    free(state.buffer);
+    free(state.oracle);
+    free(state.offsets);
+    free(state.bucket_bounds);
+    free(tree);
+}
@@ -1,6 +1,42 @@
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+
+static void selection_sort_with_buffer(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *buffer
+) {
+    // Grow a sorted prefix left-to-right by selecting the minimum from the
+    // remaining suffix and swapping it into the current front position.
+    for (size_t i = 0; i + 1 < size; ++i) {
+        size_t min_index = i;
+
+        for (size_t j = i + 1; j < size; ++j) {
+            unsigned char *current = array + (j * element_size);
+            unsigned char *current_min = array + (min_index * element_size);
+            if (AC_COMPARE(compare, current, current_min) < 0) {
+                min_index = j;
+            }
+        }
+
+        if (min_index == i) {
+            continue;
+        }
+
+        unsigned char *lhs = array + (i * element_size);
+        unsigned char *rhs = array + (min_index * element_size);
+        memcpy(buffer, lhs, element_size);
+        memcpy(lhs, rhs, element_size);
+        memcpy(rhs, buffer, element_size);
+        AC_COUNT_MOVES(3U);
+    }
+}
 
 /**
  * @brief Sort contiguous storage using the selection-sort strategy.
@@ -24,35 +60,41 @@ void ac_selection_sort(
         return;
     }
 
-    unsigned char *array = (unsigned char *)data;
     unsigned char *buffer = (unsigned char *)malloc(element_size);
     if (buffer == NULL) {
         return;
     }
 
-    // Grow a sorted prefix left-to-right by selecting the minimum from the
-    // remaining suffix and swapping it into the current front position.
-    for (size_t i = 0; i + 1 < size; ++i) {
-        size_t min_index = i;
-
-        for (size_t j = i + 1; j < size; ++j) {
-            unsigned char *current = array + (j * element_size);
-            unsigned char *current_min = array + (min_index * element_size);
-            if (compare(current, current_min) < 0) {
-                min_index = j;
-            }
-        }
+    selection_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    free(buffer);
+}
 
-        if (min_index == i) {
-            continue;
-        }
+int ac_selection_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
 
-        unsigned char *lhs = array + (i * element_size);
-        unsigned char *rhs = array + (min_index * element_size);
-        memcpy(buffer, lhs, element_size);
-        memcpy(lhs, rhs, element_size);
-        memcpy(rhs, buffer, element_size);
+    unsigned char *buffer = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (buffer == NULL) {
+        return -ENOSPC;
     }
 
-    free(buffer);
+    selection_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    return 0;
 }
@@ -1,18 +1,103 @@
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/algorithms/sort_kernels.h"
+#include "algorithms_c/algorithms/sort_workspace.h"
 #include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+
+/** Elements up to this width are staged on the stack. */
+#define AC_SHELL_SORT_STACK_SCRATCH 256U
+
+static const size_t kShellGaps[] = {AC_SORT_KERNEL_SHELL_GAPS};
+
+/** Number of gaps below ``size``; the final gap of one is always kept. */
+static size_t shell_gap_count(size_t size) {
+    size_t count = sizeof(kShellGaps) / sizeof(kShellGaps[0]);
+    while (count > 1U && kShellGaps[count - 1U] >= size) {
+        --count;
+    }
+    return count;
+}
+
+/*
+ * One gapped insertion pass per gap, largest first.  An element that is
+ * already in order with its gap predecessor is neither staged nor moved.
+ *
+ * ``AC_SHELL_SORT_DEFINE(name, width)`` stamps out the passes with every
+ * element copy spanning ``width`` bytes.  The 4-, 8- and 16-byte
+ * instantiations use a constant width, so each copy compiles to a plain load
+ * and store instead of a ``memcpy`` call; the generic one uses
+ * ``element_size``.
+ */
+#define AC_SHELL_SORT_DEFINE(name, width)                                      \
+    static void name(                                                          \
+        unsigned char *array,                                                  \
+        size_t size,                                                           \
+        size_t element_size,                                                   \
+        ac_compare_fn compare,                                                 \
+        unsigned char *buffer                                                  \
+    ) {                                                                        \
+        (void)element_size;                                                    \
+        for (size_t g = shell_gap_count(size); g-- > 0;) {                     \
+            size_t stride = kShellGaps[g] * (width);                           \
+            unsigned char *end = array + (size * (width));                     \
+            for (unsigned char *current = array + stride; current < end;       \
+                 current += (width)) {                                         \
+                if (AC_COMPARE(compare, current - stride, current) <= 0) {     \
+                    continue;                                                  \
+                }                                                              \
+                memcpy(buffer, current, (width));                              \
+                unsigned char *hole = current;                                 \
+                do {                                                           \
+                    memcpy(hole, hole - stride, (width));                      \
+                    hole -= stride;                                            \
+                } while ((size_t)(hole - array) >= stride &&                   \
+                         AC_COMPARE(compare, hole - stride, buffer) > 0);      \
+                memcpy(hole, buffer, (width));                                 \
+                AC_COUNT_MOVES((size_t)(current - hole) / stride + 2U);        \
+            }                                                                  \
+        }                                                                      \
+    }
+
+AC_SHELL_SORT_DEFINE(shell_sort_4, 4U)
+AC_SHELL_SORT_DEFINE(shell_sort_8, 8U)
+AC_SHELL_SORT_DEFINE(shell_sort_16, 16U)
+AC_SHELL_SORT_DEFINE(shell_sort_generic, element_size)
+
+static void shell_sort_with_buffer(
+    unsigned char *array,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    unsigned char *buffer
+) {
+    switch (element_size) {
+    case 4U:
+        shell_sort_4(array, size, element_size, compare, buffer);
+        break;
+    case 8U:
+        shell_sort_8(array, size, element_size, compare, buffer);
+        break;
+    case 16U:
+        shell_sort_16(array, size, element_size, compare, buffer);
+        break;
+    default:
+        shell_sort_generic(array, size, element_size, compare, buffer);
+        break;
+    }
+}
 
 /**
  * @brief Sort contiguous storage with Shell sort using gap-based insertion.
  *
- * This routine mirrors a common educational Python variant of Shell sort:
- * repeatedly perform insertion-sort-like passes over elements spaced by a
- * shrinking ``gap``. The initial gap is ``size / 2`` and is halved until the
- * final pass uses ``gap == 1``. That last pass corresponds to insertion sort,
- * but on data that is already partially ordered by earlier gap passes.
+ * Repeatedly performs insertion-sort-like passes over elements spaced by a
+ * shrinking gap taken from ``AC_SORT_KERNEL_SHELL_GAPS`` (Ciura's sequence
+ * extended by Tokuda's ratio).  The final pass uses a gap of one and is plain
+ * insertion sort over data that earlier passes have nearly ordered.
  *
- * The implementation keeps generic element support by moving values via a
- * temporary buffer and comparator callback.
+ * Elements up to ``AC_SHELL_SORT_STACK_SCRATCH`` bytes are staged on the
+ * stack, so the common case performs no allocation.
  */
 void ac_shell_sort(
     void *data,
@@ -24,31 +109,47 @@ void ac_shell_sort(
         return;
     }
 
-    unsigned char *array = (unsigned char *)data;
-    unsigned char *buffer = (unsigned char *)malloc(element_size);
-    if (buffer == NULL) {
-        return;
+    unsigned char stack_buffer[AC_SHELL_SORT_STACK_SCRATCH];
+    unsigned char *buffer = stack_buffer;
+    if (element_size > sizeof(stack_buffer)) {
+        buffer = (unsigned char *)malloc(element_size);
+        if (buffer == NULL) {
+            return;
+        }
     }
 
-    // Gap sequence: N/2, N/4, ..., 1. This simple sequence keeps the
-    // implementation easy to follow and close to common textbook examples.
-    for (size_t gap = size / 2U; gap > 0; gap /= 2U) {
-        for (size_t i = gap; i < size; ++i) {
-            memcpy(buffer, array + (i * element_size), element_size);
+    shell_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    if (buffer != stack_buffer) {
+        free(buffer);
+    }
+}
 
-            size_t j = i;
-            while (j >= gap) {
-                unsigned char *previous = array + ((j - gap) * element_size);
-                if (compare(previous, buffer) <= 0) {
-                    break;
-                }
-                memcpy(array + (j * element_size), previous, element_size);
-                j -= gap;
-            }
+int ac_shell_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
 
-            memcpy(array + (j * element_size), buffer, element_size);
-        }
+    unsigned char *buffer = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (buffer == NULL) {
+        return -ENOSPC;
     }
 
-    free(buffer);
+    shell_sort_with_buffer(
+        (unsigned char *)data, size, element_size, compare, buffer
+    );
+    return 0;
 }
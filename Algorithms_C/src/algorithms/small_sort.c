@@ -0,0 +1,441 @@
+#include "algorithms_c/algorithms/small_sort.h"
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "algorithms_c/algorithms/typed_sort.h"
+
+/*
+ * Bitonic sorting networks.
+ *
+ * For a power-of-two width ``n`` the network runs the stages
+ * ``k = 2, 4, ..., n`` and, within each, the steps ``j = k/2, ..., 1``.  In
+ * every step element ``i`` is compare-exchanged with ``i ^ j``; the pair is
+ * ordered ascending when ``i & k`` is zero and descending otherwise.  Inputs
+ * are padded with the largest value of the type so the padding sorts last.
+ *
+ * A compare-exchange must make the same "swap or not" decision in both slots
+ * of a pair, otherwise equal-comparing but distinct values (``-0.0`` and
+ * ``+0.0``) could be duplicated.  The vector kernels therefore never use
+ * ``min``/``max`` instructions.  Instead each lane decides whether to take its
+ * partner's value from a single comparison:
+ *
+ * - a lane that should keep the smaller value takes the partner when
+ *   ``partner < own``;
+ * - a lane that should keep the larger value takes it when ``own < partner``.
+ *
+ * NaNs are moved to the end before the float networks run, so the networks
+ * only ever see a consistent order.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define AC_SMALL_SORT_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Up to this size the scalar network beats padding an eight-lane register
+ * (the four-lane ``double`` register is never padded further).
+ */
+#define AC_SMALL_SORT_SCALAR_MAX 4U
+
+/** Smallest power of two that is at least ``size`` and at least ``minimum``. */
+static size_t network_width(size_t size, size_t minimum) {
+    size_t width = minimum;
+    while (width < size) {
+        width *= 2U;
+    }
+    return width;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define AC_SMALL_SORT_ALWAYS_INLINE static inline __attribute__((always_inline))
+#define AC_SMALL_SORT_UNROLL _Pragma("GCC unroll 16")
+#else
+#define AC_SMALL_SORT_ALWAYS_INLINE static inline
+#define AC_SMALL_SORT_UNROLL
+#endif
+
+/*
+ * Scalar network over the ``width / 2`` pairs of every step.  Pair ``p`` of
+ * step ``j`` is formed by inserting a zero bit at position ``log2(j)``.  The
+ * loops are unrolled for each constant width by the dispatcher.
+ */
+#define AC_DEFINE_SCALAR_NETWORK(suffix, type)                                 \
+    AC_SMALL_SORT_ALWAYS_INLINE void scalar_network_##suffix##_fixed(          \
+        type *values, size_t width                                             \
+    ) {                                                                        \
+        AC_SMALL_SORT_UNROLL                                                   \
+        for (size_t k = 2U; k <= width; k *= 2U) {                             \
+            AC_SMALL_SORT_UNROLL                                               \
+            for (size_t j = k / 2U; j > 0; j /= 2U) {                          \
+                AC_SMALL_SORT_UNROLL                                           \
+                for (size_t p = 0; p < width / 2U; ++p) {                      \
+                    size_t i = ((p & ~(j - 1U)) << 1U) | (p & (j - 1U));       \
+                    type a = values[i];                                        \
+                    type b = values[i | j];                                    \
+                    /* Select forms the compiler lowers to min/max or cmov; */ \
+                    /* ties keep both inputs. */                               \
+                    type low = b < a ? b : a;                                  \
+                    type high = b < a ? a : b;                                 \
+                    int ascending = (i & k) == 0;                              \
+                    values[i] = ascending ? low : high;                        \
+                    values[i | j] = ascending ? high : low;                    \
+                }                                                              \
+            }                                                                  \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    static void scalar_network_##suffix(type *values, size_t width) {          \
+        switch (width) {                                                       \
+        case 2U:                                                               \
+            scalar_network_##suffix##_fixed(values, 2U);                       \
+            break;                                                             \
+        case 4U:                                                               \
+            scalar_network_##suffix##_fixed(values, 4U);                       \
+            break;                                                             \
+        case 8U:                                                               \
+            scalar_network_##suffix##_fixed(values, 8U);                       \
+            break;                                                             \
+        case 16U:                                                              \
+            scalar_network_##suffix##_fixed(values, 16U);                      \
+            break;                                                             \
+        default:                                                               \
+            scalar_network_##suffix##_fixed(values, 32U);                      \
+            break;                                                             \
+        }                                                                      \
+    }
+
+AC_DEFINE_SCALAR_NETWORK(int, int)
+AC_DEFINE_SCALAR_NETWORK(float, float)
+AC_DEFINE_SCALAR_NETWORK(double, double)
+
+#ifdef AC_SMALL_SORT_X86
+
+/*
+ * Like the scalar networks, the vector networks are instantiated per constant
+ * width and fully unrolled, so the lane masks fold to constants and the
+ * registers never spill.
+ */
+#define AC_SMALL_SORT_AVX2_INLINE \
+    static inline __attribute__((always_inline, target("avx2")))
+
+/** Instantiate ``avx2_network_<suffix>`` for the three supported widths. */
+#define AC_DEFINE_AVX2_DISPATCH(suffix, type, w0)                              \
+    __attribute__((target("avx2"))) static void avx2_network_##suffix(         \
+        type *values, size_t width                                             \
+    ) {                                                                        \
+        if (width == (w0)) {                                                   \
+            avx2_network_##suffix##_fixed(values, (w0));                       \
+        } else if (width == 2U * (w0)) {                                       \
+            avx2_network_##suffix##_fixed(values, 2U * (w0));                  \
+        } else {                                                               \
+            avx2_network_##suffix##_fixed(values, 4U * (w0));                  \
+        }                                                                      \
+    }
+
+#if INT_MAX == INT32_MAX
+#define AC_SMALL_SORT_INT_AVX2 1
+
+/** Eight 32-bit lanes per register; ``width`` is 8, 16 or 32. */
+AC_SMALL_SORT_AVX2_INLINE void avx2_network_int_fixed(
+    int *values,
+    size_t width
+) {
+    __m256i regs[AC_SORT_SMALL_MAX_INT / 8U];
+    __m256i next[AC_SORT_SMALL_MAX_INT / 8U];
+    size_t count = width / 8U;
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (size_t q = 0; q < count; ++q) {
+        regs[q] = _mm256_loadu_si256((const __m256i *)(values + (8U * q)));
+    }
+    AC_SMALL_SORT_UNROLL
+    for (size_t k = 2U; k <= width; k *= 2U) {
+        AC_SMALL_SORT_UNROLL
+        for (size_t j = k / 2U; j > 0; j /= 2U) {
+            AC_SMALL_SORT_UNROLL
+            for (size_t q = 0; q < count; ++q) {
+                __m256i index =
+                    _mm256_add_epi32(lane, _mm256_set1_epi32((int)(8U * q)));
+                __m256i partner;
+                if (j >= 8U) {
+                    partner = regs[q ^ (j / 8U)];
+                } else {
+                    __m256i swizzle =
+                        _mm256_xor_si256(lane, _mm256_set1_epi32((int)j));
+                    partner = _mm256_permutevar8x32_epi32(regs[q], swizzle);
+                }
+                __m256i lower = _mm256_cmpeq_epi32(
+                    _mm256_and_si256(index, _mm256_set1_epi32((int)j)), zero
+                );
+                __m256i ascending = _mm256_cmpeq_epi32(
+                    _mm256_and_si256(index, _mm256_set1_epi32((int)k)), zero
+                );
+                __m256i take_min = _mm256_cmpeq_epi32(lower, ascending);
+                __m256i take = _mm256_blendv_epi8(
+                    _mm256_cmpgt_epi32(partner, regs[q]),
+                    _mm256_cmpgt_epi32(regs[q], partner), take_min
+                );
+                next[q] = _mm256_blendv_epi8(regs[q], partner, take);
+            }
+            AC_SMALL_SORT_UNROLL
+            for (size_t q = 0; q < count; ++q) {
+                regs[q] = next[q];
+            }
+        }
+    }
+    for (size_t q = 0; q < count; ++q) {
+        _mm256_storeu_si256((__m256i *)(values + (8U * q)), regs[q]);
+    }
+}
+
+AC_DEFINE_AVX2_DISPATCH(int, int, 8U)
+#endif
+
+/** Eight float lanes per register; ``width`` is 8, 16 or 32. */
+AC_SMALL_SORT_AVX2_INLINE void avx2_network_float_fixed(
+    float *values,
+    size_t width
+) {
+    __m256 regs[AC_SORT_SMALL_MAX_FLOAT / 8U];
+    __m256 next[AC_SORT_SMALL_MAX_FLOAT / 8U];
+    size_t count = width / 8U;
+    const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (size_t q = 0; q < count; ++q) {
+        regs[q] = _mm256_loadu_ps(values + (8U * q));
+    }
+    AC_SMALL_SORT_UNROLL
+    for (size_t k = 2U; k <= width; k *= 2U) {
+        AC_SMALL_SORT_UNROLL
+        for (size_t j = k / 2U; j > 0; j /= 2U) {
+            AC_SMALL_SORT_UNROLL
+            for (size_t q = 0; q < count; ++q) {
+                __m256i index =
+                    _mm256_add_epi32(lane, _mm256_set1_epi32((int)(8U * q)));
+                __m256 partner;
+                if (j >= 8U) {
+                    partner = regs[q ^ (j / 8U)];
+                } else {
+                    __m256i swizzle =
+                        _mm256_xor_si256(lane, _mm256_set1_epi32((int)j));
+                    partner = _mm256_permutevar8x32_ps(regs[q], swizzle);
+                }
+                __m256i lower = _mm256_cmpeq_epi32(
+                    _mm256_and_si256(index, _mm256_set1_epi32((int)j)), zero
+                );
+                __m256i ascending = _mm256_cmpeq_epi32(
+                    _mm256_and_si256(index, _mm256_set1_epi32((int)k)), zero
+                );
+                __m256 take_min =
+                    _mm256_castsi256_ps(_mm256_cmpeq_epi32(lower, ascending));
+                __m256 take = _mm256_blendv_ps(
+                    _mm256_cmp_ps(regs[q], partner, _CMP_LT_OQ),
+                    _mm256_cmp_ps(partner, regs[q], _CMP_LT_OQ), take_min
+                );
+                next[q] = _mm256_blendv_ps(regs[q], partner, take);
+            }
+            AC_SMALL_SORT_UNROLL
+            for (size_t q = 0; q < count; ++q) {
+                regs[q] = next[q];
+            }
+        }
+    }
+    for (size_t q = 0; q < count; ++q) {
+        _mm256_storeu_ps(values + (8U * q), regs[q]);
+    }
+}
+
+AC_DEFINE_AVX2_DISPATCH(float, float, 8U)
+
+/** Four double lanes per register; ``width`` is 4, 8 or 16. */
+AC_SMALL_SORT_AVX2_INLINE void avx2_network_double_fixed(
+    double *values,
+    size_t width
+) {
+    __m256d regs[AC_SORT_SMALL_MAX_DOUBLE / 4U];
+    __m256d next[AC_SORT_SMALL_MAX_DOUBLE / 4U];
+    size_t count = width / 4U;
+    const __m256i lane = _mm256_setr_epi64x(0, 1, 2, 3);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (size_t q = 0; q < count; ++q) {
+        regs[q] = _mm256_loadu_pd(values + (4U * q));
+    }
+    AC_SMALL_SORT_UNROLL
+    for (size_t k = 2U; k <= width; k *= 2U) {
+        AC_SMALL_SORT_UNROLL
+        for (size_t j = k / 2U; j > 0; j /= 2U) {
+            AC_SMALL_SORT_UNROLL
+            for (size_t q = 0; q < count; ++q) {
+                __m256i index = _mm256_add_epi64(
+                    lane, _mm256_set1_epi64x((long long)(4U * q))
+                );
+                __m256d partner;
+                if (j >= 4U) {
+                    partner = regs[q ^ (j / 4U)];
+                } else if (j == 2U) {
+                    partner = _mm256_permute4x64_pd(regs[q], 0x4E);
+                } else {
+                    partner = _mm256_permute_pd(regs[q], 0x5);
+                }
+                __m256i lower = _mm256_cmpeq_epi64(
+                    _mm256_and_si256(index, _mm256_set1_epi64x((long long)j)),
+                    zero
+                );
+                __m256i ascending = _mm256_cmpeq_epi64(
+                    _mm256_and_si256(index, _mm256_set1_epi64x((long long)k)),
+                    zero
+                );
+                __m256d take_min =
+                    _mm256_castsi256_pd(_mm256_cmpeq_epi64(lower, ascending));
+                __m256d take = _mm256_blendv_pd(
+                    _mm256_cmp_pd(regs[q], partner, _CMP_LT_OQ),
+                    _mm256_cmp_pd(partner, regs[q], _CMP_LT_OQ), take_min
+                );
+                next[q] = _mm256_blendv_pd(regs[q], partner, take);
+            }
+            AC_SMALL_SORT_UNROLL
+            for (size_t q = 0; q < count; ++q) {
+                regs[q] = next[q];
+            }
+        }
+    }
+    for (size_t q = 0; q < count; ++q) {
+        _mm256_storeu_pd(values + (4U * q), regs[q]);
+    }
+}
+
+AC_DEFINE_AVX2_DISPATCH(double, double, 4U)
+
+static int cpu_has_avx2(void) {
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+
+/**
+ * Move NaNs behind every other value and return how many values precede
+ * them.  The relative order of the non-NaN values is irrelevant here.
+ */
+#define AC_DEFINE_PARTITION_NANS(suffix, type)                                 \
+    static size_t partition_nans_##suffix(type *data, size_t size) {           \
+        size_t end = size;                                                     \
+        size_t i = 0;                                                          \
+        while (i < end) {                                                      \
+            if (isnan(data[i])) {                                              \
+                --end;                                                         \
+                type tmp = data[i];                                            \
+                data[i] = data[end];                                           \
+                data[end] = tmp;                                               \
+            } else {                                                           \
+                ++i;                                                           \
+            }                                                                  \
+        }                                                                      \
+        return end;                                                            \
+    }
+
+AC_DEFINE_PARTITION_NANS(float, float)
+AC_DEFINE_PARTITION_NANS(double, double)
+
+void ac_sort_small_int(int *data, size_t size) {
+    if (data == NULL || size < 2U) {
+        return;
+    }
+    if (size > AC_SORT_SMALL_MAX_INT) {
+        ac_quick_sort_int(data, size);
+        return;
+    }
+
+    int buffer[AC_SORT_SMALL_MAX_INT];
+    memcpy(buffer, data, size * sizeof(int));
+#ifdef AC_SMALL_SORT_INT_AVX2
+    if (size > AC_SMALL_SORT_SCALAR_MAX && cpu_has_avx2()) {
+        size_t width = network_width(size, 8U);
+        for (size_t i = size; i < width; ++i) {
+            buffer[i] = INT_MAX;
+        }
+        avx2_network_int(buffer, width);
+        memcpy(data, buffer, size * sizeof(int));
+        return;
+    }
+#endif
+    size_t width = network_width(size, 2U);
+    for (size_t i = size; i < width; ++i) {
+        buffer[i] = INT_MAX;
+    }
+    scalar_network_int(buffer, width);
+    memcpy(data, buffer, size * sizeof(int));
+}
+
+void ac_sort_small_float(float *data, size_t size) {
+    if (data == NULL || size < 2U) {
+        return;
+    }
+    if (size > AC_SORT_SMALL_MAX_FLOAT) {
+        ac_quick_sort_float(data, size);
+        return;
+    }
+    size = partition_nans_float(data, size);
+    if (size < 2U) {
+        return;
+    }
+
+    float buffer[AC_SORT_SMALL_MAX_FLOAT];
+    memcpy(buffer, data, size * sizeof(float));
+#ifdef AC_SMALL_SORT_X86
+    if (size > AC_SMALL_SORT_SCALAR_MAX && cpu_has_avx2()) {
+        size_t width = network_width(size, 8U);
+        for (size_t i = size; i < width; ++i) {
+            buffer[i] = INFINITY;
+        }
+        avx2_network_float(buffer, width);
+        memcpy(data, buffer, size * sizeof(float));
+        return;
+    }
+#endif
+    size_t width = network_width(size, 2U);
+    for (size_t i = size; i < width; ++i) {
+        buffer[i] = INFINITY;
+    }
+    scalar_network_float(buffer, width);
+    memcpy(data, buffer, size * sizeof(float));
+}
+
+void ac_sort_small_double(double *data, size_t size) {
+    if (data == NULL || size < 2U) {
+        return;
+    }
+    if (size > AC_SORT_SMALL_MAX_DOUBLE) {
+        ac_quick_sort_double(data, size);
+        return;
+    }
+    size = partition_nans_double(data, size);
+    if (size < 2U) {
+        return;
+    }
+
+    double buffer[AC_SORT_SMALL_MAX_DOUBLE];
+    memcpy(buffer, data, size * sizeof(double));
+#ifdef AC_SMALL_SORT_X86
+    if (cpu_has_avx2()) {
+        size_t width = network_width(size, 4U);
+        for (size_t i = size; i < width; ++i) {
+            buffer[i] = (double)INFINITY;
+        }
+        avx2_network_double(buffer, width);
+        memcpy(data, buffer, size * sizeof(double));
+        return;
+    }
+#endif
+    size_t width = network_width(size, 2U);
+    for (size_t i = size; i < width; ++i) {
+        buffer[i] = (double)INFINITY;
+    }
+    scalar_network_double(buffer, width);
+    memcpy(data, buffer, size * sizeof(double));
+}
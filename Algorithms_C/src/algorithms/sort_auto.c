@@ -0,0 +1,265 @@
+#include "algorithms_c/algorithms/sort_auto.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include "algorithms_c/algorithms/binary_search.h"
+#include "algorithms_c/algorithms/small_sort.h"
+#include "algorithms_c/algorithms/typed_sort.h"
+#include "algorithms_c/utils/instrument.h"
+
+/*
+ * The thresholds below were calibrated with ``algorithms_c_sort_bench`` and
+ * its ``auto`` / ``auto_typed`` engines against the engines they route to.
+ */
+
+/** Generic inputs up to this size are finished by binary insertion. */
+#define AC_SORT_AUTO_INSERTION_MAX 16U
+
+/** Most windows of adjacent elements compared by the generic sample. */
+#define AC_SORT_AUTO_WINDOWS 32U
+
+/** Elements per sample window. */
+#define AC_SORT_AUTO_WINDOW 9U
+
+/**
+ * Generic inputs take the adaptive merge when at most one sampled window in
+ * this many is neither ascending nor descending.
+ */
+#define AC_SORT_AUTO_BROKEN_WINDOW_RATIO 4U
+
+/**
+ * Typed inputs below the radix size take the adaptive merge when the
+ * direction between adjacent elements turns at most once per this many
+ * pairs.  Larger ones do only when they consist of at most two runs; radix
+ * sort wins as soon as there are more.
+ */
+#define AC_SORT_AUTO_RUN_RATIO 16U
+
+/** Elements sampled to estimate the number of distinct ``double`` values. */
+#define AC_SORT_AUTO_DISTINCT_SAMPLE 64U
+
+/**
+ * ``double`` samples with at most this many distinct values take the
+ * introsort.  For ``int`` the radix engine was never slower by more than a
+ * few microseconds, so integer inputs skip the sample.
+ */
+#define AC_SORT_AUTO_FEW_DISTINCT 8U
+
+/** ``int`` inputs of at least this size take the radix engine. */
+#define AC_SORT_AUTO_RADIX_MIN_INT 1024U
+
+/** ``double`` inputs of at least this size take the radix engine. */
+#define AC_SORT_AUTO_RADIX_MIN_DOUBLE 2048U
+
+static void report(ac_sort_engine *engine, ac_sort_engine chosen) {
+    if (engine != NULL) {
+        *engine = chosen;
+    }
+}
+
+/**
+ * Whether a typed input whose adjacent pairs change direction ``turns``
+ * times should take the adaptive merge.  Equal neighbours hide a turn, which
+ * only errs towards the engines that handle duplicates well.
+ */
+static int prefers_adaptive_merge(size_t turns, size_t size, size_t radix_min) {
+    if (size >= radix_min) {
+        return turns <= 1U;
+    }
+    return turns * AC_SORT_AUTO_RUN_RATIO <= size - 1U;
+}
+
+static int compare_double_values(const void *lhs, const void *rhs) {
+    double left = *(const double *)lhs;
+    double right = *(const double *)rhs;
+    return (left > right) - (left < right);
+}
+
+const char *ac_sort_engine_name(ac_sort_engine engine) {
+    switch (engine) {
+    case AC_SORT_ENGINE_NONE:
+        return "none";
+    case AC_SORT_ENGINE_INSERTION:
+        return "insertion";
+    case AC_SORT_ENGINE_NETWORK:
+        return "network";
+    case AC_SORT_ENGINE_COUNTING:
+        return "counting";
+    case AC_SORT_ENGINE_RADIX:
+        return "radix";
+    case AC_SORT_ENGINE_ADAPTIVE_MERGE:
+        return "adaptive_merge";
+    case AC_SORT_ENGINE_INTROSORT:
+        return "introsort";
+    }
+    return "unknown";
+}
+
+int ac_sort_auto(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare,
+    ac_sort_engine *engine
+) {
+    if (compare == NULL || element_size == 0 || (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        report(engine, AC_SORT_ENGINE_NONE);
+        return 0;
+    }
+    if (size <= AC_SORT_AUTO_INSERTION_MAX) {
+        ac_binary_insertion_sort(data, size, element_size, compare);
+        report(engine, AC_SORT_ENGINE_INSERTION);
+        return 0;
+    }
+
+    // Count the evenly spread windows that are neither ascending nor
+    // descending.  Sorted, reversed, organ-pipe and sawtooth inputs break
+    // only the windows that straddle a run boundary; random data breaks
+    // nearly all of them.
+    const unsigned char *base = (const unsigned char *)data;
+    size_t windows = size / AC_SORT_AUTO_WINDOW;
+    if (windows > AC_SORT_AUTO_WINDOWS) {
+        windows = AC_SORT_AUTO_WINDOWS;
+    }
+    size_t stride = windows > 1U
+                        ? (size - AC_SORT_AUTO_WINDOW) / (windows - 1U)
+                        : 0U;
+    size_t broken = 0;
+    for (size_t w = 0; w < windows; ++w) {
+        const unsigned char *element = base + (w * stride * element_size);
+        int descends = 0;
+        int ascends = 0;
+        for (size_t i = 1; i < AC_SORT_AUTO_WINDOW; ++i) {
+            int order = AC_COMPARE(compare, element, element + element_size);
+            descends |= order > 0;
+            ascends |= order < 0;
+            element += element_size;
+        }
+        broken += descends && ascends;
+    }
+
+    if (broken * AC_SORT_AUTO_BROKEN_WINDOW_RATIO <= windows) {
+        ac_tim_sort(data, size, element_size, compare);
+        report(engine, AC_SORT_ENGINE_ADAPTIVE_MERGE);
+    } else {
+        ac_quick_sort(data, size, element_size, compare);
+        report(engine, AC_SORT_ENGINE_INTROSORT);
+    }
+    return 0;
+}
+
+int ac_sort_auto_int(int *data, size_t size, ac_sort_engine *engine) {
+    if (data == NULL && size != 0) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        report(engine, AC_SORT_ENGINE_NONE);
+        return 0;
+    }
+    if (size <= AC_SORT_SMALL_MAX_INT) {
+        ac_sort_small_int(data, size);
+        report(engine, AC_SORT_ENGINE_NETWORK);
+        return 0;
+    }
+
+    int min_value = data[0];
+    int max_value = data[0];
+    size_t descents = 0;
+    size_t turns = 0;
+    int direction = 0;
+    for (size_t i = 1; i < size; ++i) {
+        int value = data[i];
+        int step = (value > data[i - 1U]) - (value < data[i - 1U]);
+        descents += step < 0;
+        turns += step * direction < 0;
+        direction = step;
+        min_value = value < min_value ? value : min_value;
+        max_value = value > max_value ? value : max_value;
+    }
+
+    if (descents == 0) {
+        report(engine, AC_SORT_ENGINE_NONE);
+    } else if ((uint64_t)((unsigned)max_value - (unsigned)min_value) <
+               (uint64_t)size) {
+        ac_counting_sort_int(data, size, min_value, max_value);
+        report(engine, AC_SORT_ENGINE_COUNTING);
+    } else if (prefers_adaptive_merge(
+                   turns, size, AC_SORT_AUTO_RADIX_MIN_INT
+               )) {
+        ac_tim_sort(data, size, sizeof(int), ac_compare_int);
+        report(engine, AC_SORT_ENGINE_ADAPTIVE_MERGE);
+#if INT_MAX == INT32_MAX
+    } else if (size >= AC_SORT_AUTO_RADIX_MIN_INT) {
+        ac_radix_sort_int32((int32_t *)data, size);
+        report(engine, AC_SORT_ENGINE_RADIX);
+#endif
+    } else {
+        ac_quick_sort_int(data, size);
+        report(engine, AC_SORT_ENGINE_INTROSORT);
+    }
+    return 0;
+}
+
+/** Number of distinct values among evenly spaced ``double`` samples. */
+static size_t sample_distinct_double(const double *data, size_t size) {
+    double sample[AC_SORT_AUTO_DISTINCT_SAMPLE];
+    for (size_t i = 0; i < AC_SORT_AUTO_DISTINCT_SAMPLE; ++i) {
+        sample[i] = data[i * (size / AC_SORT_AUTO_DISTINCT_SAMPLE)];
+    }
+    ac_radix_sort_double(sample, AC_SORT_AUTO_DISTINCT_SAMPLE);
+    size_t distinct = 1;
+    for (size_t i = 1; i < AC_SORT_AUTO_DISTINCT_SAMPLE; ++i) {
+        distinct += sample[i] != sample[i - 1U];
+    }
+    return distinct;
+}
+
+int ac_sort_auto_double(double *data, size_t size, ac_sort_engine *engine) {
+    if (data == NULL && size != 0) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        report(engine, AC_SORT_ENGINE_NONE);
+        return 0;
+    }
+
+    size_t descents = 0;
+    size_t turns = 0;
+    size_t nans = 0;
+    int direction = 0;
+    for (size_t i = 1; i < size; ++i) {
+        int step = (data[i] > data[i - 1U]) - (data[i] < data[i - 1U]);
+        descents += step < 0;
+        turns += step * direction < 0;
+        direction = step;
+        nans += data[i] != data[i];
+    }
+    nans += data[0] != data[0];
+
+    if (nans != 0) {
+        // Only the radix total order gives NaNs a defined place.
+        ac_radix_sort_double(data, size);
+        report(engine, AC_SORT_ENGINE_RADIX);
+    } else if (descents == 0) {
+        report(engine, AC_SORT_ENGINE_NONE);
+    } else if (size <= AC_SORT_SMALL_MAX_DOUBLE) {
+        ac_sort_small_double(data, size);
+        report(engine, AC_SORT_ENGINE_NETWORK);
+    } else if (prefers_adaptive_merge(
+                   turns, size, AC_SORT_AUTO_RADIX_MIN_DOUBLE
+               )) {
+        ac_tim_sort(data, size, sizeof(double), compare_double_values);
+        report(engine, AC_SORT_ENGINE_ADAPTIVE_MERGE);
+    } else if (size >= AC_SORT_AUTO_RADIX_MIN_DOUBLE &&
+               sample_distinct_double(data, size) > AC_SORT_AUTO_FEW_DISTINCT) {
+        ac_radix_sort_double(data, size);
+        report(engine, AC_SORT_ENGINE_RADIX);
+    } else {
+        ac_quick_sort_double(data, size);
+        report(engine, AC_SORT_ENGINE_INTROSORT);
+    }
+    return 0;
+}
@@ -0,0 +1,86 @@
+#include "algorithms_c/algorithms/sort_workspace.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+size_t ac_sort_workspace_bytes(size_t max_size, size_t element_size) {
+    if (max_size == 0) {
+        max_size = 1U;
+    }
+    if (element_size != 0 && max_size > SIZE_MAX / element_size) {
+        return SIZE_MAX;
+    }
+    return max_size * element_size;
+}
+
+int ac_sort_workspace_init(ac_sort_workspace *workspace, size_t capacity) {
+    if (workspace == NULL) {
+        return -EINVAL;
+    }
+
+    workspace->memory = NULL;
+    workspace->capacity = 0;
+    workspace->owns_memory = 0;
+    if (capacity == 0) {
+        return 0;
+    }
+
+    workspace->memory = (unsigned char *)malloc(capacity);
+    if (workspace->memory == NULL) {
+        return -ENOMEM;
+    }
+    workspace->capacity = capacity;
+    workspace->owns_memory = 1;
+    return 0;
+}
+
+int ac_sort_workspace_init_buffer(
+    ac_sort_workspace *workspace,
+    void *memory,
+    size_t capacity
+) {
+    if (workspace == NULL || (memory == NULL && capacity != 0)) {
+        return -EINVAL;
+    }
+
+    workspace->memory = (unsigned char *)memory;
+    workspace->capacity = capacity;
+    workspace->owns_memory = 0;
+    return 0;
+}
+
+void ac_sort_workspace_destroy(ac_sort_workspace *workspace) {
+    if (workspace == NULL) {
+        return;
+    }
+    if (workspace->owns_memory) {
+        free(workspace->memory);
+    }
+    workspace->memory = NULL;
+    workspace->capacity = 0;
+    workspace->owns_memory = 0;
+}
+
+void *ac_sort_workspace_reserve(
+    const ac_sort_workspace *workspace,
+    size_t count,
+    size_t element_size,
+    size_t alignment
+) {
+    if (workspace == NULL || workspace->memory == NULL || alignment == 0 ||
+        (alignment & (alignment - 1U)) != 0) {
+        return NULL;
+    }
+    if (element_size != 0 && count > SIZE_MAX / element_size) {
+        return NULL;
+    }
+
+    uintptr_t address = (uintptr_t)workspace->memory;
+    size_t padding = (size_t)((alignment - (address & (alignment - 1U))) &
+                              (alignment - 1U));
+    if (padding > workspace->capacity ||
+        count * element_size > workspace->capacity - padding) {
+        return NULL;
+    }
+    return workspace->memory + padding;
+}
@@ -1,81 +1,63 @@
 #include "algorithms_c/algorithms/split_find.h"
-#include <math.h>
+#include <errno.h>
 #include <stddef.h>
-#include <stdlib.h>
-
-static void ac_swap_double(double *lhs, double *rhs) {
-    double tmp;
-    tmp = *lhs;
-    *lhs = *rhs;
-    *rhs = tmp;
+#include <stdint.h>
+#include <string.h>
+#include "algorithms_c/algorithms/nth_element.h"
+
+static int ac_compare_double_values(const void *lhs, const void *rhs) {
+    double left = *(const double *)lhs;
+    double right = *(const double *)rhs;
+    return (left > right) - (left < right);
 }
 
-static void ac_split(
-    double *array,
-    size_t left_edge,
-    size_t right_edge,
-    double pivot,
-    size_t *out_left,
-    size_t *out_right
-) {
-    size_t middle;
-    size_t i;
-    middle = left_edge;
-    for (i = left_edge; i < right_edge; ++i) {
-        if (array[i] < pivot) {
-            ac_swap_double(&array[i], &array[middle]);
-            middle += 1U;
-        }
+int ac_split_find(double *array, size_t size, size_t index, double *out_value) {
+    if (array == NULL || out_value == NULL || index >= size) {
+        return -1;
     }
 
-    *out_left = middle;
-    for (i = middle; i < right_edge; ++i) {
-        double difference;
-        difference = array[i] - pivot;
-        if (difference < 0.0) {
-            difference = -difference;
-        }
-        if (difference <= 1e-14) {
-            ac_swap_double(&array[i], &array[middle]);
-            middle += 1U;
-        }
+    if (ac_nth_element(
+            array, size, sizeof(double), ac_compare_double_values, index
+        ) != 0) {
+        return -1;
     }
-    *out_right = middle;
+    *out_value = array[index];
+    return 0;
 }
 
-static double ac_split_find_recursive(
-    double *array,
-    size_t left_edge,
-    size_t right_edge,
-    size_t index
-) {
-    size_t pivot_offset;
-    double pivot;
-    size_t new_left_edge;
-    size_t new_right_edge;
-
-    pivot_offset = (size_t)(rand() % (int)(right_edge - left_edge));
-    pivot = array[left_edge + pivot_offset];
-    ac_split(
-        array, left_edge, right_edge, pivot, &new_left_edge, &new_right_edge
-    );
-
-    if ((right_edge - left_edge) <= (new_right_edge - new_left_edge)) {
-        return array[index];
+size_t ac_split_find_workspace_bytes(size_t size) {
+    if (size > (SIZE_MAX - _Alignof(double)) / sizeof(double)) {
+        return SIZE_MAX;
     }
+    return (size * sizeof(double)) + _Alignof(double) - 1U;
+}
 
-    if (index < new_left_edge) {
-        return ac_split_find_recursive(array, left_edge, new_left_edge, index);
+int ac_split_find_ws(
+    ac_sort_workspace *workspace,
+    const double *array,
+    size_t size,
+    size_t index,
+    double *out_value
+) {
+    if (workspace == NULL || array == NULL || out_value == NULL ||
+        index >= size) {
+        return -EINVAL;
     }
 
-    return ac_split_find_recursive(array, new_left_edge, right_edge, index);
-}
-
-int ac_split_find(double *array, size_t size, size_t index, double *out_value) {
-    if (array == NULL || out_value == NULL || index >= size) {
-        return -1;
+    double *copy = (double *)ac_sort_workspace_reserve(
+        workspace, size, sizeof(double), _Alignof(double)
+    );
+    if (copy == NULL) {
+        return -ENOSPC;
     }
 
-    *out_value = ac_split_find_recursive(array, 0U, size, index);
+    memcpy(copy, array, size * sizeof(double));
+    int status = ac_nth_element(
+        copy, size, sizeof(double), ac_compare_double_values, index
+    );
+    if (status != 0) {
+        return status;
+    }
+    *out_value = copy[index];
     return 0;
 }
@@ -0,0 +1,247 @@
+#include "algorithms_c/algorithms/string_sort.h"
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Both entry points share one engine, stamped out per item type by
+ * ``AC_STRING_SORT_DEFINE``.  ``key_at(item, depth)`` returns the byte at
+ * ``depth`` plus one, or ``0`` once the string has ended, so the end of a
+ * string sorts first and a key of ``0`` means "fully compared".
+ * ``compare_from(a, b, depth)`` compares two strings known to agree on their
+ * first ``depth`` bytes.
+ *
+ * Recursion always skips the largest part of a partition and loops on it
+ * instead, so the stack depth stays logarithmic in ``size`` however long the
+ * common prefixes are.
+ */
+
+/** Partitions up to this size are finished by insertion sort. */
+#define AC_STRING_SORT_INSERTION_MAX 16U
+
+/** Ranges of at least this many strings take an MSD radix pass. */
+#define AC_STRING_SORT_RADIX_MIN 4096U
+
+/** One bucket per byte value plus one for strings that have ended. */
+#define AC_STRING_SORT_BUCKETS 257U
+
+static unsigned median_of_three(unsigned a, unsigned b, unsigned c) {
+    if (a < b) {
+        return b < c ? b : (a < c ? c : a);
+    }
+    return a < c ? a : (b < c ? c : b);
+}
+
+static unsigned cstring_key(const char *item, size_t depth) {
+    unsigned char byte = (unsigned char)item[depth];
+    return byte == 0U ? 0U : (unsigned)byte + 1U;
+}
+
+static int cstring_compare_from(
+    const char *lhs,
+    const char *rhs,
+    size_t depth
+) {
+    return strcmp(lhs + depth, rhs + depth);
+}
+
+static unsigned view_key(ac_string_view item, size_t depth) {
+    return depth < item.size ? (unsigned)(unsigned char)item.data[depth] + 1U
+                             : 0U;
+}
+
+static int view_compare_from(
+    ac_string_view lhs,
+    ac_string_view rhs,
+    size_t depth
+) {
+    size_t common = lhs.size < rhs.size ? lhs.size : rhs.size;
+    if (common > depth) {
+        int order =
+            memcmp(lhs.data + depth, rhs.data + depth, common - depth);
+        if (order != 0) {
+            return order;
+        }
+    }
+    return (lhs.size > rhs.size) - (lhs.size < rhs.size);
+}
+
+#define AC_STRING_SORT_DEFINE(name, type, key_at, compare_from)                \
+    static void name##_insertion(type *items, size_t size, size_t depth) {     \
+        for (size_t i = 1; i < size; ++i) {                                    \
+            type item = items[i];                                              \
+            size_t j = i;                                                      \
+            while (j > 0 && compare_from(items[j - 1U], item, depth) > 0) {    \
+                items[j] = items[j - 1U];                                      \
+                --j;                                                           \
+            }                                                                  \
+            items[j] = item;                                                   \
+        }                                                                      \
+    }                                                                          \
+                                                                               \
+    /* Depth past the prefix shared by all items, which agree at ``depth``. */ \
+    static size_t name##_common_prefix(                                        \
+        const type *items,                                                     \
+        size_t size,                                                           \
+        size_t depth                                                           \
+    ) {                                                                        \
+        size_t limit = depth;                                                  \
+        while (key_at(items[0], limit) != 0U) {                                \
+            ++limit;                                                           \
+        }                                                                      \
+        for (size_t i = 1; i < size && limit > depth + 1U; ++i) {              \
+            size_t d = depth + 1U;                                             \
+            while (d < limit && key_at(items[i], d) == key_at(items[0], d)) {  \
+                ++d;                                                           \
+            }                                                                  \
+            limit = d;                                                         \
+        }                                                                      \
+        return limit;                                                          \
+    }                                                                          \
+                                                                               \
+    static void name##_multikey(type *items, size_t size, size_t depth) {      \
+        while (size > AC_STRING_SORT_INSERTION_MAX) {                          \
+            unsigned pivot = median_of_three(                                  \
+                key_at(items[0], depth), key_at(items[size / 2U], depth),      \
+                key_at(items[size - 1U], depth)                                \
+            );                                                                 \
+            size_t lt = 0;                                                     \
+            size_t i = 0;                                                      \
+            size_t gt = size;                                                  \
+            while (i < gt) {                                                   \
+                unsigned key = key_at(items[i], depth);                        \
+                if (key < pivot) {                                             \
+                    type item = items[lt];                                     \
+                    items[lt++] = items[i];                                    \
+                    items[i++] = item;                                         \
+                } else if (key > pivot) {                                      \
+                    type item = items[--gt];                                   \
+                    items[gt] = items[i];                                      \
+                    items[i] = item;                                           \
+                } else {                                                       \
+                    ++i;                                                       \
+                }                                                              \
+            }                                                                  \
+            if (lt == 0 && gt == size) {                                       \
+                if (pivot == 0U) {                                             \
+                    return;                                                    \
+                }                                                              \
+                depth = name##_common_prefix(items, size, depth);              \
+                continue;                                                      \
+            }                                                                  \
+            /* The equal part moves to the next byte unless it has ended. */   \
+            type *parts[3] = {items, items + lt, items + gt};                  \
+            size_t sizes[3] = {lt, pivot == 0U ? 0U : gt - lt, size - gt};     \
+            size_t depths[3] = {depth, depth + 1U, depth};                     \
+            size_t largest = 0;                                                \
+            for (size_t p = 1; p < 3U; ++p) {                                  \
+                if (sizes[p] > sizes[largest]) {                               \
+                    largest = p;                                               \
+                }                                                              \
+            }                                                                  \
+            for (size_t p = 0; p < 3U; ++p) {                                  \
+                if (p != largest) {                                            \
+                    name##_multikey(parts[p], sizes[p], depths[p]);            \
+                }                                                              \
+            }                                                                  \
+            items = parts[largest];                                            \
+            size = sizes[largest];                                             \
+            depth = depths[largest];                                           \
+        }                                                                      \
+        name##_insertion(items, size, depth);                                  \
+    }                                                                          \
+                                                                               \
+    static void name##_radix(                                                  \
+        type *items,                                                           \
+        size_t size,                                                           \
+        size_t depth,                                                          \
+        type *scratch,                                                         \
+        uint16_t *keys                                                         \
+    ) {                                                                        \
+        while (size >= AC_STRING_SORT_RADIX_MIN) {                             \
+            size_t counts[AC_STRING_SORT_BUCKETS] = {0};                       \
+            for (size_t i = 0; i < size; ++i) {                                \
+                keys[i] = (uint16_t)key_at(items[i], depth);                   \
+                ++counts[keys[i]];                                             \
+            }                                                                  \
+            if (counts[keys[0]] == size) {                                     \
+                /* Shared byte: skip the whole shared prefix without moving. */\
+                if (keys[0] == 0U) {                                           \
+                    return;                                                    \
+                }                                                              \
+                depth = name##_common_prefix(items, size, depth);              \
+                continue;                                                      \
+            }                                                                  \
+            size_t next[AC_STRING_SORT_BUCKETS];                               \
+            size_t total = 0;                                                  \
+            size_t largest = 1U;                                               \
+            for (size_t b = 0; b < AC_STRING_SORT_BUCKETS; ++b) {              \
+                next[b] = total;                                               \
+                total += counts[b];                                            \
+                if (b != 0U && counts[b] > counts[largest]) {                  \
+                    largest = b;                                               \
+                }                                                              \
+            }                                                                  \
+            for (size_t i = 0; i < size; ++i) {                                \
+                scratch[next[keys[i]]++] = items[i];                           \
+            }                                                                  \
+            memcpy(items, scratch, size * sizeof(type));                       \
+                                                                               \
+            /* Bucket 0 holds the strings that ended and is done. */           \
+            type *bucket = items + counts[0];                                  \
+            type *largest_bucket = bucket;                                     \
+            for (size_t b = 1; b < AC_STRING_SORT_BUCKETS; ++b) {              \
+                if (b == largest) {                                            \
+                    largest_bucket = bucket;                                   \
+                } else if (counts[b] > 1U) {                                   \
+                    name##_radix(bucket, counts[b], depth + 1U, scratch, keys);\
+                }                                                              \
+                bucket += counts[b];                                           \
+            }                                                                  \
+            items = largest_bucket;                                            \
+            size = counts[largest];                                            \
+            ++depth;                                                           \
+        }                                                                      \
+        name##_multikey(items, size, depth);                                   \
+    }                                                                          \
+                                                                               \
+    static void name##_sort(type *items, size_t size) {                        \
+        type *scratch = NULL;                                                  \
+        uint16_t *keys = NULL;                                                 \
+        if (size >= AC_STRING_SORT_RADIX_MIN &&                                \
+            size <= SIZE_MAX / sizeof(type)) {                                 \
+            scratch = (type *)malloc(size * sizeof(type));                     \
+            keys = (uint16_t *)malloc(size * sizeof(uint16_t));                \
+        }                                                                      \
+        if (scratch != NULL && keys != NULL) {                                 \
+            name##_radix(items, size, 0U, scratch, keys);                      \
+        } else {                                                               \
+            name##_multikey(items, size, 0U);                                  \
+        }                                                                      \
+        free(scratch);                                                         \
+        free(keys);                                                            \
+    }
+
+AC_STRING_SORT_DEFINE(cstring, const char *, cstring_key, cstring_compare_from)
+AC_STRING_SORT_DEFINE(view, ac_string_view, view_key, view_compare_from)
+
+int ac_sort_strings(const char **strs, size_t size) {
+    if (strs == NULL && size != 0) {
+        return -EINVAL;
+    }
+    if (size >= 2U) {
+        cstring_sort(strs, size);
+    }
+    return 0;
+}
+
+int ac_sort_string_views(ac_string_view *strs, size_t size) {
+    if (strs == NULL && size != 0) {
+        return -EINVAL;
+    }
+    if (size >= 2U) {
+        view_sort(strs, size);
+    }
+    return 0;
+}
@@ -0,0 +1,821 @@
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/sort_workspace.h"
+#include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/utils/instrument.h"
+
+/*
+ * TimSort: adaptive, stable natural merge sort.
+ *
+ * The array is scanned left to right for natural runs.  Strictly descending
+ * runs are reversed in place (strictness keeps the sort stable), and runs
+ * shorter than ``minrun`` are extended with binary insertion sort.  Run
+ * boundaries are pushed on a stack whose lengths are kept close to a
+ * Fibonacci-like sequence, which balances merges and bounds the stack depth.
+ *
+ * Before merging two neighbouring runs, the prefix of the left run that is
+ * already in place and the suffix of the right run that is already in place
+ * are skipped with exponential ("galloping") searches.  Only the shorter of
+ * the remaining parts is copied to the temporary buffer, so a merge needs
+ * ``min(left, right)`` elements of scratch space.  While merging, a side that
+ * keeps winning switches the merge into galloping mode, which copies whole
+ * blocks at once; ``min_gallop`` adapts to how profitable that has been.
+ *
+ * On already sorted or reversed input the whole array forms one run and the
+ * sort finishes after ``n - 1`` comparisons.
+ */
+
+/** Runs shorter than ``minrun`` (between 32 and 64) are extended. */
+#define AC_TIM_MIN_MERGE 64U
+
+/** Initial number of consecutive wins before a merge starts galloping. */
+#define AC_TIM_MIN_GALLOP 7U
+
+/** Enough pending runs for any array that fits in a 64-bit address space. */
+#define AC_TIM_MAX_PENDING 85U
+
+typedef struct {
+    unsigned char *array;
+    size_t element_size;
+    ac_compare_fn compare;
+    unsigned char *temp;
+    size_t temp_capacity;
+    int temp_is_borrowed;
+    size_t min_gallop;
+    size_t run_base[AC_TIM_MAX_PENDING];
+    size_t run_length[AC_TIM_MAX_PENDING];
+    size_t run_count;
+} ac_tim_state;
+
+static unsigned char *element_at(
+    const ac_tim_state *state,
+    unsigned char *base,
+    size_t index
+) {
+    return base + (index * state->element_size);
+}
+
+static int less(
+    const ac_tim_state *state,
+    const unsigned char *a,
+    const unsigned char *b
+) {
+    return AC_COMPARE(state->compare, a, b) < 0;
+}
+
+/**
+ * Grow the temporary buffer to hold ``count`` elements; ``0`` on failure or
+ * when the buffer belongs to a caller's workspace and is too small.
+ */
+static int ensure_temp(ac_tim_state *state, size_t count) {
+    if (count <= state->temp_capacity) {
+        return 1;
+    }
+    if (state->temp_is_borrowed) {
+        return 0;
+    }
+    size_t capacity = state->temp_capacity * 2U;
+    if (capacity < count) {
+        capacity = count;
+    }
+    unsigned char *temp =
+        (unsigned char *)malloc(capacity * state->element_size);
+    if (temp == NULL) {
+        return 0;
+    }
+    free(state->temp);
+    state->temp = temp;
+    state->temp_capacity = capacity;
+    return 1;
+}
+
+static void swap_bytes(unsigned char *a, unsigned char *b, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char byte = a[i];
+        a[i] = b[i];
+        b[i] = byte;
+    }
+    AC_COUNT_MOVES(3U);
+}
+
+static void reverse_range(ac_tim_state *state, size_t low, size_t high) {
+    while (low + 1U < high) {
+        --high;
+        swap_bytes(
+            element_at(state, state->array, low),
+            element_at(state, state->array, high), state->element_size
+        );
+        ++low;
+    }
+}
+
+/**
+ * Sort ``[low, high)`` given that ``[low, start)`` is already sorted, using the
+ * first slot of the temporary buffer to hold the element being inserted.
+ */
+static void binary_insertion_sort(
+    ac_tim_state *state,
+    size_t low,
+    size_t high,
+    size_t start
+) {
+    size_t element_size = state->element_size;
+    unsigned char *pivot = state->temp;
+    for (size_t i = start; i < high; ++i) {
+        memcpy(pivot, element_at(state, state->array, i), element_size);
+        size_t left = low;
+        size_t right = i;
+        // Upper bound: equal keys are inserted after their predecessors.
+        while (left < right) {
+            size_t mid = left + ((right - left) / 2U);
+            if (less(state, pivot, element_at(state, state->array, mid))) {
+                right = mid;
+            } else {
+                left = mid + 1U;
+            }
+        }
+        memmove(
+            element_at(state, state->array, left + 1U),
+            element_at(state, state->array, left), (i - left) * element_size
+        );
+        memcpy(element_at(state, state->array, left), pivot, element_size);
+        AC_COUNT_MOVES((i - left) + 2U);
+    }
+}
+
+/**
+ * Return the length of the run starting at ``low``, reversing it first when it
+ * is strictly descending.
+ */
+static size_t count_run(ac_tim_state *state, size_t low, size_t high) {
+    size_t next = low + 1U;
+    if (next == high) {
+        return 1U;
+    }
+    if (less(
+            state, element_at(state, state->array, next),
+            element_at(state, state->array, low)
+        )) {
+        while (next + 1U < high &&
+               less(
+                   state, element_at(state, state->array, next + 1U),
+                   element_at(state, state->array, next)
+               )) {
+            ++next;
+        }
+        reverse_range(state, low, next + 1U);
+    } else {
+        while (next + 1U < high &&
+               !less(
+                   state, element_at(state, state->array, next + 1U),
+                   element_at(state, state->array, next)
+               )) {
+            ++next;
+        }
+    }
+    return next + 1U - low;
+}
+
+static size_t compute_min_run(size_t size) {
+    size_t remainder = 0;
+    while (size >= AC_TIM_MIN_MERGE) {
+        remainder |= size & 1U;
+        size >>= 1U;
+    }
+    return size + remainder;
+}
+
+/**
+ * Locate the leftmost position at which ``key`` could be inserted into the
+ * sorted ``base[0, length)``, i.e. the count of elements ``< key``.  The
+ * search gallops outwards from ``hint`` before finishing with a binary search.
+ */
+static size_t gallop_left(
+    const ac_tim_state *state,
+    const unsigned char *key,
+    unsigned char *base,
+    size_t length,
+    size_t hint
+) {
+    // Offsets are signed because the lower bracket may be one below ``hint``.
+    ptrdiff_t last_offset = 0;
+    ptrdiff_t offset = 1;
+    ptrdiff_t signed_hint = (ptrdiff_t)hint;
+    if (less(state, element_at(state, base, hint), key)) {
+        ptrdiff_t max_offset = (ptrdiff_t)(length - hint);
+        while (offset < max_offset &&
+               less(
+                   state, element_at(state, base, hint + (size_t)offset), key
+               )) {
+            last_offset = offset;
+            offset = (offset * 2) + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        last_offset += signed_hint;
+        offset += signed_hint;
+    } else {
+        ptrdiff_t max_offset = signed_hint + 1;
+        while (offset < max_offset &&
+               !less(
+                   state, element_at(state, base, hint - (size_t)offset), key
+               )) {
+            last_offset = offset;
+            offset = (offset * 2) + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        ptrdiff_t previous = last_offset;
+        last_offset = signed_hint - offset;
+        offset = signed_hint - previous;
+    }
+
+    // Now base[last_offset] < key <= base[offset]; narrow it down.
+    ++last_offset;
+    while (last_offset < offset) {
+        ptrdiff_t mid = last_offset + ((offset - last_offset) / 2);
+        if (less(state, element_at(state, base, (size_t)mid), key)) {
+            last_offset = mid + 1;
+        } else {
+            offset = mid;
+        }
+    }
+    return (size_t)offset;
+}
+
+/**
+ * Like ``gallop_left`` but return the rightmost insertion point, i.e. the
+ * count of elements ``<= key``.
+ */
+static size_t gallop_right(
+    const ac_tim_state *state,
+    const unsigned char *key,
+    unsigned char *base,
+    size_t length,
+    size_t hint
+) {
+    ptrdiff_t last_offset = 0;
+    ptrdiff_t offset = 1;
+    ptrdiff_t signed_hint = (ptrdiff_t)hint;
+    if (less(state, key, element_at(state, base, hint))) {
+        ptrdiff_t max_offset = signed_hint + 1;
+        while (offset < max_offset &&
+               less(
+                   state, key, element_at(state, base, hint - (size_t)offset)
+               )) {
+            last_offset = offset;
+            offset = (offset * 2) + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        ptrdiff_t previous = last_offset;
+        last_offset = signed_hint - offset;
+        offset = signed_hint - previous;
+    } else {
+        ptrdiff_t max_offset = (ptrdiff_t)(length - hint);
+        while (offset < max_offset &&
+               !less(
+                   state, key, element_at(state, base, hint + (size_t)offset)
+               )) {
+            last_offset = offset;
+            offset = (offset * 2) + 1;
+        }
+        if (offset > max_offset) {
+            offset = max_offset;
+        }
+        last_offset += signed_hint;
+        offset += signed_hint;
+    }
+
+    // Now base[last_offset] <= key < base[offset]; narrow it down.
+    ++last_offset;
+    while (last_offset < offset) {
+        ptrdiff_t mid = last_offset + ((offset - last_offset) / 2);
+        if (less(state, key, element_at(state, base, (size_t)mid))) {
+            offset = mid;
+        } else {
+            last_offset = mid + 1;
+        }
+    }
+    return (size_t)offset;
+}
+
+/**
+ * Merge ``left_length`` elements at ``base`` with the ``right_length``
+ * elements that follow, copying the (shorter) left run to the temporary
+ * buffer and filling the array from the front.  The caller guarantees that
+ * the first right element belongs before the first left element and that the
+ * last left element belongs after every right element.
+ */
+static void merge_low(
+    ac_tim_state *state,
+    size_t base,
+    size_t left_length,
+    size_t right_length
+) {
+    size_t element_size = state->element_size;
+    unsigned char *dest = element_at(state, state->array, base);
+    unsigned char *left = state->temp;
+    unsigned char *right = element_at(state, state->array, base + left_length);
+    // The left run goes out to ``temp`` and every element is written back
+    // exactly once.
+    AC_COUNT_MOVES((2U * left_length) + right_length);
+    memcpy(left, dest, left_length * element_size);
+
+    memcpy(dest, right, element_size);
+    dest += element_size;
+    right += element_size;
+    if (--right_length == 0) {
+        goto succeed;
+    }
+    if (left_length == 1U) {
+        goto copy_right;
+    }
+
+    size_t min_gallop = state->min_gallop;
+    for (;;) {
+        size_t left_wins = 0;
+        size_t right_wins = 0;
+
+        // One element at a time until one side wins ``min_gallop`` in a row.
+        for (;;) {
+            if (less(state, right, left)) {
+                memcpy(dest, right, element_size);
+                dest += element_size;
+                right += element_size;
+                ++right_wins;
+                left_wins = 0;
+                if (--right_length == 0) {
+                    goto succeed;
+                }
+                if (right_wins >= min_gallop) {
+                    break;
+                }
+            } else {
+                memcpy(dest, left, element_size);
+                dest += element_size;
+                left += element_size;
+                ++left_wins;
+                right_wins = 0;
+                if (--left_length == 1U) {
+                    goto copy_right;
+                }
+                if (left_wins >= min_gallop) {
+                    break;
+                }
+            }
+        }
+
+        // Galloping: copy whole blocks while that keeps paying off.
+        ++min_gallop;
+        do {
+            min_gallop -= min_gallop > 1U;
+            state->min_gallop = min_gallop;
+
+            size_t count = gallop_right(state, right, left, left_length, 0);
+            left_wins = count;
+            if (count != 0) {
+                memcpy(dest, left, count * element_size);
+                dest += count * element_size;
+                left += count * element_size;
+                left_length -= count;
+                if (left_length == 1U) {
+                    goto copy_right;
+                }
+                // Only reachable with an inconsistent comparator.
+                if (left_length == 0) {
+                    goto succeed;
+                }
+            }
+            memcpy(dest, right, element_size);
+            dest += element_size;
+            right += element_size;
+            if (--right_length == 0) {
+                goto succeed;
+            }
+
+            count = gallop_left(state, left, right, right_length, 0);
+            right_wins = count;
+            if (count != 0) {
+                memmove(dest, right, count * element_size);
+                dest += count * element_size;
+                right += count * element_size;
+                right_length -= count;
+                if (right_length == 0) {
+                    goto succeed;
+                }
+            }
+            memcpy(dest, left, element_size);
+            dest += element_size;
+            left += element_size;
+            if (--left_length == 1U) {
+                goto copy_right;
+            }
+        } while (left_wins >= AC_TIM_MIN_GALLOP ||
+                 right_wins >= AC_TIM_MIN_GALLOP);
+        ++min_gallop;
+        state->min_gallop = min_gallop;
+    }
+
+succeed:
+    if (left_length != 0) {
+        memcpy(dest, left, left_length * element_size);
+    }
+    return;
+
+copy_right:
+    // The last left element is the largest of what remains.
+    memmove(dest, right, right_length * element_size);
+    memcpy(dest + (right_length * element_size), left, element_size);
+}
+
+/**
+ * Mirror image of ``merge_low``: copy the (shorter) right run to the
+ * temporary buffer and fill the array from the back.  Positions are tracked
+ * as remaining counts so no pointer ever steps before the start of a run.
+ */
+static void merge_high(
+    ac_tim_state *state,
+    size_t base,
+    size_t left_length,
+    size_t right_length
+) {
+    size_t element_size = state->element_size;
+    unsigned char *dest = element_at(state, state->array, base);
+    unsigned char *left = dest;
+    unsigned char *right = state->temp;
+    AC_COUNT_MOVES(left_length + (2U * right_length));
+    memcpy(
+        right, element_at(state, state->array, base + left_length),
+        right_length * element_size
+    );
+
+    // dest[left_length + right_length - 1] is always the next slot to fill.
+    memcpy(
+        element_at(state, dest, left_length + right_length - 1U),
+        element_at(state, left, left_length - 1U), element_size
+    );
+    if (--left_length == 0) {
+        goto succeed;
+    }
+    if (right_length == 1U) {
+        goto copy_left;
+    }
+
+    size_t min_gallop = state->min_gallop;
+    for (;;) {
+        size_t left_wins = 0;
+        size_t right_wins = 0;
+
+        for (;;) {
+            unsigned char *slot =
+                element_at(state, dest, left_length + right_length - 1U);
+            if (less(
+                    state, element_at(state, right, right_length - 1U),
+                    element_at(state, left, left_length - 1U)
+                )) {
+                memcpy(
+                    slot, element_at(state, left, left_length - 1U),
+                    element_size
+                );
+                ++left_wins;
+                right_wins = 0;
+                if (--left_length == 0) {
+                    goto succeed;
+                }
+                if (left_wins >= min_gallop) {
+                    break;
+                }
+            } else {
+                memcpy(
+                    slot, element_at(state, right, right_length - 1U),
+                    element_size
+                );
+                ++right_wins;
+                left_wins = 0;
+                if (--right_length == 1U) {
+                    goto copy_left;
+                }
+                if (right_wins >= min_gallop) {
+                    break;
+                }
+            }
+        }
+
+        ++min_gallop;
+        do {
+            min_gallop -= min_gallop > 1U;
+            state->min_gallop = min_gallop;
+
+            // Left elements greater than the current right one move as a
+            // block.
+            size_t kept = gallop_right(
+                state, element_at(state, right, right_length - 1U), left,
+                left_length, left_length - 1U
+            );
+            size_t count = left_length - kept;
+            left_wins = count;
+            if (count != 0) {
+                left_length -= count;
+                memmove(
+                    element_at(state, dest, left_length + right_length),
+                    element_at(state, left, left_length), count * element_size
+                );
+                if (left_length == 0) {
+                    goto succeed;
+                }
+            }
+            memcpy(
+                element_at(state, dest, left_length + right_length - 1U),
+                element_at(state, right, right_length - 1U), element_size
+            );
+            if (--right_length == 1U) {
+                goto copy_left;
+            }
+
+            kept = gallop_left(
+                state, element_at(state, left, left_length - 1U), right,
+                right_length, right_length - 1U
+            );
+            count = right_length - kept;
+            right_wins = count;
+            if (count != 0) {
+                right_length -= count;
+                memcpy(
+                    element_at(state, dest, left_length + right_length),
+                    element_at(state, right, right_length), count * element_size
+                );
+                if (right_length == 1U) {
+                    goto copy_left;
+                }
+                // Only reachable with an inconsistent comparator.
+                if (right_length == 0) {
+                    goto succeed;
+                }
+            }
+            memcpy(
+                element_at(state, dest, left_length + right_length - 1U),
+                element_at(state, left, left_length - 1U), element_size
+            );
+            if (--left_length == 0) {
+                goto succeed;
+            }
+        } while (left_wins >= AC_TIM_MIN_GALLOP ||
+                 right_wins >= AC_TIM_MIN_GALLOP);
+        ++min_gallop;
+        state->min_gallop = min_gallop;
+    }
+
+succeed:
+    if (right_length != 0) {
+        memcpy(
+            element_at(state, dest, left_length), right,
+            right_length * element_size
+        );
+    }
+    return;
+
+copy_left:
+    // The first right element is the smallest of what remains.
+    memmove(element_at(state, dest, 1U), left, left_length * element_size);
+    memcpy(dest, right, element_size);
+}
+
+/**
+ * Stable in-place merge of ``[first, middle)`` and ``[middle, last)`` by
+ * rotations, used only when the temporary buffer cannot be grown.
+ */
+static void merge_in_place(
+    ac_tim_state *state,
+    size_t first,
+    size_t middle,
+    size_t last
+) {
+    while (first < middle && middle < last) {
+        size_t left_length = middle - first;
+        size_t right_length = last - middle;
+        unsigned char *array = state->array;
+        if (left_length + right_length == 2U) {
+            if (less(
+                    state, element_at(state, array, middle),
+                    element_at(state, array, first)
+                )) {
+                swap_bytes(
+                    element_at(state, array, first),
+                    element_at(state, array, middle), state->element_size
+                );
+            }
+            return;
+        }
+
+        size_t left_cut;
+        size_t right_cut;
+        if (left_length > right_length) {
+            left_cut = first + (left_length / 2U);
+            right_cut = middle + gallop_left(
+                                     state, element_at(state, array, left_cut),
+                                     element_at(state, array, middle),
+                                     right_length, 0
+                                 );
+        } else {
+            right_cut = middle + (right_length / 2U);
+            left_cut = first + gallop_right(
+                                   state, element_at(state, array, right_cut),
+                                   element_at(state, array, first),
+                                   left_length, 0
+                               );
+        }
+
+        // Rotate [left_cut, middle) past [middle, right_cut).
+        reverse_range(state, left_cut, middle);
+        reverse_range(state, middle, right_cut);
+        reverse_range(state, left_cut, right_cut);
+        size_t new_middle = left_cut + (right_cut - middle);
+
+        // Recurse into the smaller half and loop on the larger one.
+        if ((new_middle - first) < (last - new_middle)) {
+            merge_in_place(state, first, left_cut, new_middle);
+            first = new_middle;
+            middle = right_cut;
+        } else {
+            merge_in_place(state, new_middle, right_cut, last);
+            last = new_middle;
+            middle = left_cut;
+        }
+    }
+}
+
+/** Merge the pending runs at stack indices ``i`` and ``i + 1``. */
+static void merge_at(ac_tim_state *state, size_t i) {
+    size_t base = state->run_base[i];
+    size_t left_length = state->run_length[i];
+    size_t right_base = state->run_base[i + 1U];
+    size_t right_length = state->run_length[i + 1U];
+
+    state->run_length[i] = left_length + right_length;
+    if (i + 3U == state->run_count) {
+        state->run_base[i + 1U] = state->run_base[i + 2U];
+        state->run_length[i + 1U] = state->run_length[i + 2U];
+    }
+    --state->run_count;
+
+    // Elements of the left run that precede the first right element are
+    // already in place.
+    size_t skip = gallop_right(
+        state, element_at(state, state->array, right_base),
+        element_at(state, state->array, base), left_length, 0
+    );
+    base += skip;
+    left_length -= skip;
+    if (left_length == 0) {
+        return;
+    }
+
+    // So are elements of the right run that follow the last left element.
+    right_length = gallop_left(
+        state, element_at(state, state->array, base + left_length - 1U),
+        element_at(state, state->array, right_base), right_length,
+        right_length - 1U
+    );
+    if (right_length == 0) {
+        return;
+    }
+
+    size_t shorter = left_length <= right_length ? left_length : right_length;
+    if (!ensure_temp(state, shorter)) {
+        merge_in_place(state, base, right_base, right_base + right_length);
+    } else if (left_length <= right_length) {
+        merge_low(state, base, left_length, right_length);
+    } else {
+        merge_high(state, base, left_length, right_length);
+    }
+}
+
+/**
+ * Restore the stack invariants ``len[i - 2] > len[i - 1] + len[i]`` and
+ * ``len[i - 1] > len[i]`` for the topmost runs (including the fourth from the
+ * top, which the original formulation missed).
+ */
+static void merge_collapse(ac_tim_state *state) {
+    const size_t *length = state->run_length;
+    while (state->run_count > 1U) {
+        size_t n = state->run_count - 2U;
+        if ((n > 0 && length[n - 1U] <= length[n] + length[n + 1U]) ||
+            (n > 1U && length[n - 2U] <= length[n - 1U] + length[n])) {
+            if (length[n - 1U] < length[n + 1U]) {
+                --n;
+            }
+            merge_at(state, n);
+        } else if (length[n] <= length[n + 1U]) {
+            merge_at(state, n);
+        } else {
+            break;
+        }
+    }
+}
+
+static void merge_force_collapse(ac_tim_state *state) {
+    const size_t *length = state->run_length;
+    while (state->run_count > 1U) {
+        size_t n = state->run_count - 2U;
+        if (n > 0 && length[n - 1U] < length[n + 1U]) {
+            --n;
+        }
+        merge_at(state, n);
+    }
+}
+
+static void init_state(
+    ac_tim_state *state,
+    void *data,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    state->array = (unsigned char *)data;
+    state->element_size = element_size;
+    state->compare = compare;
+    state->temp = NULL;
+    state->temp_capacity = 0;
+    state->temp_is_borrowed = 0;
+    state->min_gallop = AC_TIM_MIN_GALLOP;
+    state->run_count = 0;
+}
+
+/** Sort ``state->array``; the temporary buffer holds at least one element. */
+static void tim_sort_runs(ac_tim_state *state, size_t size) {
+    size_t min_run = compute_min_run(size);
+    size_t low = 0;
+    while (low < size) {
+        size_t run = count_run(state, low, size);
+        if (run < min_run) {
+            size_t forced = size - low < min_run ? size - low : min_run;
+            binary_insertion_sort(state, low, low + forced, low + run);
+            run = forced;
+        }
+
+        state->run_base[state->run_count] = low;
+        state->run_length[state->run_count] = run;
+        ++state->run_count;
+        merge_collapse(state);
+        low += run;
+    }
+    merge_force_collapse(state);
+}
+
+void ac_tim_sort(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (data == NULL || compare == NULL || element_size == 0 || size < 2U) {
+        return;
+    }
+
+    ac_tim_state state;
+    init_state(&state, data, element_size, compare);
+
+    // Binary insertion needs one element of scratch for the pivot.
+    if (!ensure_temp(&state, 1U)) {
+        return;
+    }
+
+    tim_sort_runs(&state, size);
+    free(state.temp);
+}
+
+int ac_tim_sort_ws(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    if (workspace == NULL || compare == NULL || element_size == 0 ||
+        (data == NULL && size != 0)) {
+        return -EINVAL;
+    }
+    if (size < 2U) {
+        return 0;
+    }
+
+    ac_tim_state state;
+    init_state(&state, data, element_size, compare);
+    state.temp = (unsigned char *)ac_sort_workspace_reserve(
+        workspace, 1U, element_size, 1U
+    );
+    if (state.temp == NULL) {
+        return -ENOSPC;
+    }
+    // Merges that do not fit fall back to merge_in_place.
+    state.temp_capacity = workspace->capacity / element_size;
+    state.temp_is_borrowed = 1;
+
+    tim_sort_runs(&state, size);
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include "algorithms_c/algorithms/typed_sort.h"
+#include "algorithms_c/algorithms/small_sort.h"
+#include "algorithms_c/algorithms/sort_kernels.h"
+#include "algorithms_c/algorithms/sorting.h"
+
+/*
+ * Instantiate the kernel family for every built-in scalar type.  The double
+ * instantiation also provides the long-standing ``ac_insertion_sort_double``,
+ * ``ac_quick_sort_double`` and ``ac_merge_sort_double`` entry points declared
+ * in ``sorting.h``, which used to forward to the comparator-based path.
+ *
+ * The ``int``, ``float`` and ``double`` introsorts bottom out in the sorting
+ * networks from ``small_sort.h`` instead of insertion sort.  The networks may
+ * reorder values that compare equal, such as ``-0.0`` and ``+0.0``, so the
+ * stable merge kernels keep their insertion-sort base case.
+ */
+#define AC_TYPED_SORT_LESS(a, b) ((a) < (b))
+
+AC_DEFINE_SORT_KERNELS_WITH_LEAF(
+    , int, int, AC_TYPED_SORT_LESS, ac_sort_small_int, AC_SORT_SMALL_MAX_INT
+)
+AC_DEFINE_SORT_KERNELS(, uint, unsigned int, AC_TYPED_SORT_LESS)
+AC_DEFINE_SORT_KERNELS(, long, long, AC_TYPED_SORT_LESS)
+AC_DEFINE_SORT_KERNELS(, ulong, unsigned long, AC_TYPED_SORT_LESS)
+AC_DEFINE_SORT_KERNELS(, llong, long long, AC_TYPED_SORT_LESS)
+AC_DEFINE_SORT_KERNELS(, ullong, unsigned long long, AC_TYPED_SORT_LESS)
+AC_DEFINE_SORT_KERNELS_WITH_LEAF(
+    , float, float, AC_TYPED_SORT_LESS, ac_sort_small_float,
+    AC_SORT_SMALL_MAX_FLOAT
+)
+AC_DEFINE_SORT_KERNELS_WITH_LEAF(
+    , double, double, AC_TYPED_SORT_LESS, ac_sort_small_double,
+    AC_SORT_SMALL_MAX_DOUBLE
+)
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "algorithms_c/utils/instrument.h"
 
 /**
  * The Python ``Heap`` implementation leans on explanatory docstrings to outline
@@ -41,6 +42,7 @@ static int swap_elements(ac_heap *heap, size_t lhs, size_t rhs) {
     memcpy(tmp, a, element_size);
     memcpy(a, b, element_size);
     memcpy(b, tmp, element_size);
+    AC_COUNT_MOVES(3U);
 
     if (tmp != stack_buffer) {
         free(tmp);
@@ -55,7 +57,7 @@ static int sift_up(ac_heap *heap, size_t index) {
         size_t parent = (index - 1U) / 2U;
         void *child_ptr = index_ptr(heap, index);
         void *parent_ptr = index_ptr(heap, parent);
-        if (heap->compare(child_ptr, parent_ptr) < 0) {
+        if (AC_COMPARE(heap->compare, child_ptr, parent_ptr) < 0) {
             int status = swap_elements(heap, index, parent);
             if (status != 0) {
                 return status;
@@ -79,14 +81,16 @@ static int sift_down(ac_heap *heap, size_t index) {
         size_t smallest = index;
 
         if (left < size &&
-            heap->compare(index_ptr(heap, left), index_ptr(heap, smallest)) <
-                0) {
+            AC_COMPARE(
+                heap->compare, index_ptr(heap, left), index_ptr(heap, smallest)
+            ) < 0) {
             smallest = left;
         }
 
         if (right < size &&
-            heap->compare(index_ptr(heap, right), index_ptr(heap, smallest)) <
-                0) {
+            AC_COMPARE(
+                heap->compare, index_ptr(heap, right), index_ptr(heap, smallest)
+            ) < 0) {
             smallest = right;
         }
 
@@ -275,6 +279,7 @@ int ac_heap_push(ac_heap *heap, const void *element) {
     if (status != AC_VECTOR_OK) {
         return -ENOMEM;
     }
+    AC_COUNT_MOVES(1U);
 
     status = sift_up(heap, ac_heap_size(heap) - 1U);
     if (status != 0) {
@@ -324,6 +329,9 @@ int ac_heap_pop(ac_heap *heap, void *out_element) {
     if (status != AC_VECTOR_OK) {
         return -ENOENT;
     }
+    if (out_element != NULL) {
+        AC_COUNT_MOVES(1U);
+    }
 
     /* Restore ordering if elements remain. */
     if (!ac_heap_empty(heap)) {
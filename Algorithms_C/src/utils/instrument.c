@@ -0,0 +1,39 @@
+#include "algorithms_c/utils/instrument.h"
+#include <stddef.h>
+
+#ifdef AC_ENABLE_INSTRUMENTATION
+
+_Thread_local ac_instrument_counters ac_instrument_thread_counters;
+
+int ac_instrument_enabled(void) {
+    return 1;
+}
+
+void ac_instrument_snapshot(ac_instrument_counters *counters) {
+    if (counters != NULL) {
+        *counters = ac_instrument_thread_counters;
+    }
+}
+
+void ac_instrument_reset(void) {
+    ac_instrument_thread_counters.comparisons = 0;
+    ac_instrument_thread_counters.moves = 0;
+}
+
+#else
+
+int ac_instrument_enabled(void) {
+    return 0;
+}
+
+void ac_instrument_snapshot(ac_instrument_counters *counters) {
+    if (counters != NULL) {
+        counters->comparisons = 0;
+        counters->moves = 0;
+    }
+}
+
+void ac_instrument_reset(void) {
+}
+
+#endif
@@ -0,0 +1,132 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "algorithms_c/utils/parallel.h"
+#include <errno.h>
+#include <stdlib.h>
+#include "algorithms_c/utils/instrument.h"
+
+#ifdef AC_HAVE_PTHREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+/** Upper bound on workers spawned for a single batch. */
+#define AC_PARALLEL_MAX_THREADS 256U
+
+size_t ac_parallel_hardware_threads(void) {
+#if defined(AC_HAVE_PTHREADS) && defined(_SC_NPROCESSORS_ONLN)
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (count > 0) {
+        return (size_t)count;
+    }
+#endif
+    return 1U;
+}
+
+#ifdef AC_HAVE_PTHREADS
+
+/** Shared state of one batch: workers claim indices under ``lock``. */
+typedef struct {
+    pthread_mutex_t lock;
+    size_t next;
+    size_t count;
+    ac_parallel_task_fn task;
+    void *context;
+    /** Instrumentation counts gathered from the spawned workers. */
+    ac_instrument_counters counters;
+} ac_parallel_batch;
+
+static void run_batch(ac_parallel_batch *batch) {
+    for (;;) {
+        pthread_mutex_lock(&batch->lock);
+        size_t index = batch->next;
+        if (index < batch->count) {
+            batch->next = index + 1U;
+        }
+        pthread_mutex_unlock(&batch->lock);
+
+        if (index >= batch->count) {
+            return;
+        }
+        batch->task(batch->context, index);
+    }
+}
+
+static void *worker_main(void *arg) {
+    ac_parallel_batch *batch = (ac_parallel_batch *)arg;
+    run_batch(batch);
+
+    // The worker's counters die with the thread; hand them to the caller.
+    ac_instrument_counters counters;
+    ac_instrument_snapshot(&counters);
+    pthread_mutex_lock(&batch->lock);
+    batch->counters.comparisons += counters.comparisons;
+    batch->counters.moves += counters.moves;
+    pthread_mutex_unlock(&batch->lock);
+    return NULL;
+}
+
+#endif
+
+int ac_parallel_for(
+    size_t task_count,
+    size_t threads,
+    ac_parallel_task_fn task,
+    void *context
+) {
+    if (task == NULL) {
+        return -EINVAL;
+    }
+
+    if (threads == 0) {
+        threads = ac_parallel_hardware_threads();
+    }
+    if (threads > task_count) {
+        threads = task_count;
+    }
+
+#ifdef AC_HAVE_PTHREADS
+    if (threads > 1U) {
+        if (threads > AC_PARALLEL_MAX_THREADS) {
+            threads = AC_PARALLEL_MAX_THREADS;
+        }
+
+        ac_parallel_batch batch;
+        batch.next = 0;
+        batch.count = task_count;
+        batch.task = task;
+        batch.context = context;
+        batch.counters.comparisons = 0;
+        batch.counters.moves = 0;
+        if (pthread_mutex_init(&batch.lock, NULL) == 0) {
+            pthread_t workers[AC_PARALLEL_MAX_THREADS];
+            size_t started = 0;
+            while (started + 1U < threads &&
+                   pthread_create(
+                       &workers[started], NULL, worker_main, &batch
+                   ) == 0) {
+                ++started;
+            }
+
+            // The caller is a worker too; if some threads failed to start,
+            // the remaining ones (or the caller alone) drain the batch.
+            run_batch(&batch);
+            for (size_t i = 0; i < started; ++i) {
+                pthread_join(workers[i], NULL);
+            }
+            pthread_mutex_destroy(&batch.lock);
+#ifdef AC_ENABLE_INSTRUMENTATION
+            ac_instrument_thread_counters.comparisons +=
+                batch.counters.comparisons;
+            ac_instrument_thread_counters.moves += batch.counters.moves;
+#endif
+            return 0;
+        }
+    }
+#endif
+
+    for (size_t index = 0; index < task_count; ++index) {
+        task(context, index);
+    }
+    return 0;
+}
@@ -0,0 +1,760 @@
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "algorithms_c/algorithms/sort_auto.h"
+#include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/algorithms/typed_sort.h"
+#include "algorithms_c/utils/instrument.h"
+
+/*
+ * Sort benchmark.
+ *
+ * Every workload is a (distribution, element layout, size) triple.  The keys
+ * are generated once per workload, every engine sorts a fresh copy ``trials``
+ * times and the wall-clock samples are reduced to the median, the 10th and
+ * 90th percentiles and nanoseconds per element.  ``qsort`` runs first on each
+ * workload and the other engines are also reported relative to it.  Each
+ * result is checked for order, so the benchmark doubles as a smoke test.
+ *
+ * ``--counters`` adds one extra counted run per serial comparison engine.
+ * Comparisons are always counted; element moves are only reported when the
+ * library is built with ``-DAC_ENABLE_INSTRUMENTATION=ON``.
+ *
+ * Records wider than an ``int`` carry the key in their first four bytes and
+ * a payload after it, which exposes the cost of moving wide elements.
+ *
+ * Usage:
+ *   algorithms_c_sort_bench [--format=table|csv|json] [--trials=N]
+ *                           [--sizes=N,N,...] [--distributions=a,b,...]
+ *                           [--elements=a,b,...] [--engines=a,b,...]
+ *                           [--threads=N] [--counters] [--seed=N]
+ *                           [--quick]
+ */
+
+/** Trials stop early once one sample exceeds this many nanoseconds. */
+#define BENCH_TRIAL_LIMIT_NS 5000000000.0
+
+/** Workloads whose buffers would exceed this many bytes are skipped. */
+#define BENCH_MAX_BUFFER_BYTES ((size_t)64U << 20)
+
+#define BENCH_MAX_TRIALS 101U
+#define BENCH_MAX_SIZES 16U
+
+typedef enum { KEY_INT, KEY_DOUBLE } key_kind;
+
+typedef enum { FORMAT_TABLE, FORMAT_CSV, FORMAT_JSON } output_format;
+
+typedef struct {
+    const char *name;
+    size_t element_size;
+    key_kind key;
+} element_layout;
+
+typedef void (*generic_sort_fn)(void *, size_t, size_t, ac_compare_fn);
+
+typedef struct {
+    const char *name;
+    /** Comparator-based engine, or ``NULL`` for a typed one. */
+    generic_sort_fn generic;
+    /** Typed engine for ``int`` keys, if any. */
+    void (*int_sort)(int *, size_t);
+    /** Typed engine for ``double`` keys, if any. */
+    void (*double_sort)(double *, size_t);
+    /** Larger inputs are skipped (quadratic engines). */
+    size_t max_size;
+    /** Uses several threads, so comparisons are not counted. */
+    int parallel;
+} sort_engine;
+
+typedef struct {
+    output_format format;
+    size_t trials;
+    size_t sizes[BENCH_MAX_SIZES];
+    size_t size_count;
+    const char *distributions;
+    const char *elements;
+    const char *engines;
+    int counters;
+    uint64_t seed;
+} bench_options;
+
+typedef struct {
+    size_t trials;
+    double median_ns;
+    double p10_ns;
+    double p90_ns;
+    /** Comparator calls of one run, or ``-1`` when not counted. */
+    long long comparisons;
+    /** Element moves of the same run, or ``-1`` when not counted. */
+    long long moves;
+} bench_result;
+
+static const char *const kDistributions[] = {
+    "random",   "sorted",   "reversed", "organ_pipe",    "few_unique",
+    "zipf",     "sawtooth", "nearly_sorted",
+};
+
+static const element_layout kElements[] = {
+    {"int", sizeof(int), KEY_INT},   {"rec8", 8U, KEY_INT},
+    {"rec16", 16U, KEY_INT},         {"rec64", 64U, KEY_INT},
+    {"rec256", 256U, KEY_INT},       {"double", sizeof(double), KEY_DOUBLE},
+};
+
+/** Worker threads of the parallel engines; ``0`` uses every hardware one. */
+static size_t g_threads = 0;
+
+static void sort_parallel_merge(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    ac_merge_sort_parallel(data, size, element_size, compare, g_threads);
+}
+
+static void sort_sample(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    ac_sample_sort(data, size, element_size, compare, g_threads);
+}
+
+static void sort_auto(
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    (void)ac_sort_auto(data, size, element_size, compare, NULL);
+}
+
+static void sort_auto_int(int *data, size_t size) {
+    (void)ac_sort_auto_int(data, size, NULL);
+}
+
+static void sort_auto_double(double *data, size_t size) {
+    (void)ac_sort_auto_double(data, size, NULL);
+}
+
+#if INT_MAX == INT32_MAX
+static void sort_radix_int(int *data, size_t size) {
+    ac_radix_sort_int32((int32_t *)data, size);
+}
+#endif
+
+static const sort_engine kEngines[] = {
+    {"qsort", qsort, NULL, NULL, SIZE_MAX, 0},
+    {"insertion", ac_insertion_sort, NULL, NULL, 5000U, 0},
+    {"binary_insertion", ac_binary_insertion_sort, NULL, NULL, 5000U, 0},
+    {"shell", ac_shell_sort, NULL, NULL, SIZE_MAX, 0},
+    {"comb", ac_comb_sort, NULL, NULL, SIZE_MAX, 0},
+    {"heap", ac_heap_sort, NULL, NULL, SIZE_MAX, 0},
+    {"merge", ac_merge_sort, NULL, NULL, SIZE_MAX, 0},
+    {"inplace_merge", ac_inplace_merge_sort, NULL, NULL, SIZE_MAX, 0},
+    {"tim", ac_tim_sort, NULL, NULL, SIZE_MAX, 0},
+    {"quick", ac_quick_sort, NULL, NULL, SIZE_MAX, 0},
+    {"merge_parallel", sort_parallel_merge, NULL, NULL, SIZE_MAX, 1},
+    {"sample", sort_sample, NULL, NULL, SIZE_MAX, 1},
+    {"quick_typed", NULL, ac_quick_sort_int, ac_quick_sort_double, SIZE_MAX,
+     0},
+    {"merge_typed", NULL, ac_merge_sort_int, ac_merge_sort_double, SIZE_MAX,
+     0},
+    {"shell_typed", NULL, ac_shell_sort_int, ac_shell_sort_double, SIZE_MAX,
+     0},
+    {"heap_typed", NULL, ac_heap_sort_int, ac_heap_sort_double, SIZE_MAX,
+     0},
+#if INT_MAX == INT32_MAX
+    {"radix", NULL, sort_radix_int, ac_radix_sort_double, SIZE_MAX, 0},
+#else
+    {"radix", NULL, NULL, ac_radix_sort_double, SIZE_MAX, 0},
+#endif
+    {"counting", NULL, ac_count_sort_int_auto, NULL, SIZE_MAX, 1},
+    {"auto", sort_auto, NULL, NULL, SIZE_MAX, 0},
+    {"auto_typed", NULL, sort_auto_int, sort_auto_double, SIZE_MAX, 0},
+};
+
+/* ---- keys ------------------------------------------------------------- */
+
+static uint64_t g_rng_state = 0x9E3779B97F4A7C15ULL;
+
+/** xorshift64*: fast, seedable and identical on every platform. */
+static uint64_t next_random(void) {
+    uint64_t x = g_rng_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    g_rng_state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t random_below(size_t bound) {
+    return bound == 0 ? 0 : (size_t)(next_random() % bound);
+}
+
+static double random_unit(void) {
+    return (double)(next_random() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/**
+ * Zipf(1) ranks over ``min(size, 65536)`` values by inversion of the
+ * tabulated cumulative distribution.
+ */
+static int fill_zipf(int *keys, size_t size) {
+    size_t domain = size < 65536U ? size : 65536U;
+    double *cdf = (double *)malloc(domain * sizeof(double));
+    if (cdf == NULL) {
+        return 0;
+    }
+    double total = 0.0;
+    for (size_t rank = 0; rank < domain; ++rank) {
+        total += 1.0 / (double)(rank + 1U);
+        cdf[rank] = total;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        double target = random_unit() * total;
+        size_t low = 0;
+        size_t high = domain - 1U;
+        while (low < high) {
+            size_t mid = low + ((high - low) / 2U);
+            if (cdf[mid] < target) {
+                low = mid + 1U;
+            } else {
+                high = mid;
+            }
+        }
+        // Scatter the ranks so that frequent keys are not also the smallest.
+        keys[i] = (int)((low * 2654435761U) % 1000003U);
+    }
+    free(cdf);
+    return 1;
+}
+
+static int fill_keys(int *keys, size_t size, const char *distribution) {
+    if (strcmp(distribution, "random") == 0) {
+        for (size_t i = 0; i < size; ++i) {
+            keys[i] = (int)(next_random() >> 33);
+        }
+    } else if (strcmp(distribution, "sorted") == 0) {
+        for (size_t i = 0; i < size; ++i) {
+            keys[i] = (int)(i % (size_t)INT_MAX);
+        }
+    } else if (strcmp(distribution, "reversed") == 0) {
+        for (size_t i = 0; i < size; ++i) {
+            keys[i] = (int)((size - i) % (size_t)INT_MAX);
+        }
+    } else if (strcmp(distribution, "organ_pipe") == 0) {
+        for (size_t i = 0; i < size; ++i) {
+            size_t rise = i < size / 2U ? i : size - i;
+            keys[i] = (int)(rise % (size_t)INT_MAX);
+        }
+    } else if (strcmp(distribution, "few_unique") == 0) {
+        for (size_t i = 0; i < size; ++i) {
+            keys[i] = (int)random_below(16U);
+        }
+    } else if (strcmp(distribution, "zipf") == 0) {
+        return fill_zipf(keys, size);
+    } else if (strcmp(distribution, "sawtooth") == 0) {
+        // Sixteen ascending teeth.
+        size_t tooth = size / 16U + 1U;
+        for (size_t i = 0; i < size; ++i) {
+            keys[i] = (int)(i % tooth);
+        }
+    } else if (strcmp(distribution, "nearly_sorted") == 0) {
+        // Sorted, then 1% of the positions swapped with a random partner.
+        for (size_t i = 0; i < size; ++i) {
+            keys[i] = (int)(i % (size_t)INT_MAX);
+        }
+        for (size_t swaps = size / 100U; swaps > 0; --swaps) {
+            size_t a = random_below(size);
+            size_t b = random_below(size);
+            int tmp = keys[a];
+            keys[a] = keys[b];
+            keys[b] = tmp;
+        }
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+/** Lay the keys out as ``layout`` elements. */
+static void build_elements(
+    unsigned char *base,
+    const int *keys,
+    size_t size,
+    const element_layout *layout
+) {
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char *element = base + (i * layout->element_size);
+        if (layout->key == KEY_DOUBLE) {
+            double key = (double)keys[i] / 3.0;
+            memcpy(element, &key, sizeof(key));
+            continue;
+        }
+        memcpy(element, &keys[i], sizeof(int));
+        for (size_t byte = sizeof(int); byte < layout->element_size; ++byte) {
+            element[byte] = (unsigned char)(i + byte);
+        }
+    }
+}
+
+/* ---- comparators ------------------------------------------------------ */
+
+static int compare_int_key(const void *lhs, const void *rhs) {
+    int left;
+    int right;
+    memcpy(&left, lhs, sizeof(left));
+    memcpy(&right, rhs, sizeof(right));
+    return (left > right) - (left < right);
+}
+
+static int compare_double_key(const void *lhs, const void *rhs) {
+    double left = *(const double *)lhs;
+    double right = *(const double *)rhs;
+    return (left > right) - (left < right);
+}
+
+static ac_compare_fn g_counted_compare = NULL;
+static size_t g_comparisons = 0;
+
+static int counting_compare(const void *lhs, const void *rhs) {
+    ++g_comparisons;
+    return g_counted_compare(lhs, rhs);
+}
+
+/* ---- measurement ------------------------------------------------------ */
+
+static double now_ns(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return ((double)now.tv_sec * 1e9) + (double)now.tv_nsec;
+}
+
+static int engine_supports(
+    const sort_engine *engine,
+    const element_layout *layout
+) {
+    if (engine->generic != NULL) {
+        return 1;
+    }
+    if (layout->key == KEY_DOUBLE) {
+        return engine->double_sort != NULL;
+    }
+    return engine->int_sort != NULL && layout->element_size == sizeof(int);
+}
+
+static void run_engine(
+    const sort_engine *engine,
+    const element_layout *layout,
+    void *data,
+    size_t size,
+    ac_compare_fn compare
+) {
+    if (engine->generic != NULL) {
+        engine->generic(data, size, layout->element_size, compare);
+    } else if (layout->key == KEY_DOUBLE) {
+        engine->double_sort((double *)data, size);
+    } else {
+        engine->int_sort((int *)data, size);
+    }
+}
+
+static int is_sorted(
+    const unsigned char *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+) {
+    for (size_t i = 1; i < size; ++i) {
+        const unsigned char *current = data + (i * element_size);
+        if (compare(current - element_size, current) > 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int compare_doubles(const void *lhs, const void *rhs) {
+    return compare_double_key(lhs, rhs);
+}
+
+/** Nearest-rank percentile of the sorted ``samples``. */
+static double percentile(const double *samples, size_t count, unsigned pct) {
+    size_t rank = ((size_t)pct * count + 99U) / 100U;
+    return samples[rank == 0 ? 0 : rank - 1U];
+}
+
+/** Time ``engine`` on copies of ``base``; ``0`` if the output is unsorted. */
+static int measure(
+    const sort_engine *engine,
+    const element_layout *layout,
+    const unsigned char *base,
+    unsigned char *work,
+    size_t size,
+    const bench_options *options,
+    bench_result *result
+) {
+    ac_compare_fn compare =
+        layout->key == KEY_DOUBLE ? compare_double_key : compare_int_key;
+    size_t bytes = size * layout->element_size;
+    double samples[BENCH_MAX_TRIALS];
+    size_t trials = 0;
+    while (trials < options->trials) {
+        memcpy(work, base, bytes);
+        double start = now_ns();
+        run_engine(engine, layout, work, size, compare);
+        double elapsed = now_ns() - start;
+        if (!is_sorted(work, size, layout->element_size, compare)) {
+            return 0;
+        }
+        samples[trials++] = elapsed;
+        if (elapsed > BENCH_TRIAL_LIMIT_NS) {
+            break;
+        }
+    }
+    qsort(samples, trials, sizeof(double), compare_doubles);
+    result->trials = trials;
+    result->median_ns = trials % 2U == 1U
+                            ? samples[trials / 2U]
+                            : (samples[(trials / 2U) - 1U] +
+                               samples[trials / 2U]) /
+                                  2.0;
+    result->p10_ns = percentile(samples, trials, 10U);
+    result->p90_ns = percentile(samples, trials, 90U);
+
+    result->comparisons = -1;
+    result->moves = -1;
+    if (options->counters && engine->generic != NULL && !engine->parallel) {
+        memcpy(work, base, bytes);
+        g_counted_compare = compare;
+        g_comparisons = 0;
+        ac_instrument_reset();
+        engine->generic(work, size, layout->element_size, counting_compare);
+        result->comparisons = (long long)g_comparisons;
+        if (ac_instrument_enabled()) {
+            ac_instrument_counters counters;
+            ac_instrument_snapshot(&counters);
+            result->moves = (long long)counters.moves;
+        }
+    }
+    return 1;
+}
+
+/* ---- output ----------------------------------------------------------- */
+
+static size_t g_records = 0;
+
+/** Format a counter, blank (``null`` in JSON) when it was not counted. */
+static void format_count(
+    char *buffer,
+    size_t capacity,
+    long long value,
+    const bench_options *options
+) {
+    if (value < 0) {
+        snprintf(
+            buffer, capacity, "%s",
+            options->format == FORMAT_JSON ? "null" : ""
+        );
+    } else {
+        snprintf(buffer, capacity, "%lld", value);
+    }
+}
+
+static void print_header(const bench_options *options) {
+    if (options->format == FORMAT_CSV) {
+        printf(
+            "distribution,element,element_size,size,engine,trials,median_ns,"
+            "p10_ns,p90_ns,ns_per_element,vs_qsort,comparisons,moves\n"
+        );
+    } else if (options->format == FORMAT_JSON) {
+        printf("[\n");
+    } else {
+        printf(
+            "%-14s %-7s %9s %-16s %12s %12s %12s %9s %8s %14s %14s\n",
+            "distribution", "element", "size", "engine", "median_ms",
+            "p10_ms", "p90_ms", "ns/elem", "x_qsort", "comparisons", "moves"
+        );
+    }
+}
+
+static void print_result(
+    const bench_options *options,
+    const char *distribution,
+    const element_layout *layout,
+    size_t size,
+    const sort_engine *engine,
+    const bench_result *result,
+    double qsort_median_ns
+) {
+    double per_element = result->median_ns / (double)size;
+    double ratio =
+        qsort_median_ns > 0.0 ? result->median_ns / qsort_median_ns : 0.0;
+    char comparisons[32];
+    char moves[32];
+    format_count(
+        comparisons, sizeof(comparisons), result->comparisons, options
+    );
+    format_count(moves, sizeof(moves), result->moves, options);
+
+    if (options->format == FORMAT_CSV) {
+        printf(
+            "%s,%s,%zu,%zu,%s,%zu,%.0f,%.0f,%.0f,%.3f,%.4f,%s,%s\n",
+            distribution, layout->name, layout->element_size, size,
+            engine->name, result->trials, result->median_ns, result->p10_ns,
+            result->p90_ns, per_element, ratio, comparisons, moves
+        );
+    } else if (options->format == FORMAT_JSON) {
+        printf(
+            "%s  {\"distribution\": \"%s\", \"element\": \"%s\", "
+            "\"element_size\": %zu, \"size\": %zu, \"engine\": \"%s\", "
+            "\"trials\": %zu, \"median_ns\": %.0f, \"p10_ns\": %.0f, "
+            "\"p90_ns\": %.0f, \"ns_per_element\": %.3f, \"vs_qsort\": %.4f, "
+            "\"comparisons\": %s, \"moves\": %s}",
+            g_records == 0 ? "" : ",\n", distribution, layout->name,
+            layout->element_size, size, engine->name, result->trials,
+            result->median_ns, result->p10_ns, result->p90_ns, per_element,
+            ratio, comparisons, moves
+        );
+    } else {
+        printf(
+            "%-14s %-7s %9zu %-16s %12.3f %12.3f %12.3f %9.2f %8.2f %14s "
+            "%14s\n",
+            distribution, layout->name, size, engine->name,
+            result->median_ns / 1e6, result->p10_ns / 1e6,
+            result->p90_ns / 1e6, per_element, ratio, comparisons, moves
+        );
+    }
+    ++g_records;
+    fflush(stdout);
+}
+
+static void print_footer(const bench_options *options) {
+    if (options->format == FORMAT_JSON) {
+        printf("%s]\n", g_records == 0 ? "" : "\n");
+    }
+}
+
+/* ---- options ---------------------------------------------------------- */
+
+/** Whether ``name`` appears in the comma-separated ``list`` (``NULL``: all). */
+static int selected(const char *list, const char *name) {
+    if (list == NULL) {
+        return 1;
+    }
+    size_t length = strlen(name);
+    const char *item = list;
+    while (*item != '\0') {
+        const char *end = strchr(item, ',');
+        size_t item_length = end == NULL ? strlen(item) : (size_t)(end - item);
+        if (item_length == length && strncmp(item, name, length) == 0) {
+            return 1;
+        }
+        if (end == NULL) {
+            break;
+        }
+        item = end + 1;
+    }
+    return 0;
+}
+
+static int parse_count(const char *text, size_t *out) {
+    char *end = NULL;
+    unsigned long long value = strtoull(text, &end, 10);
+    if (end == text || value == 0 || value > SIZE_MAX) {
+        return 0;
+    }
+    *out = (size_t)value;
+    return *end == '\0' || *end == ',';
+}
+
+static int parse_sizes(const char *text, bench_options *options) {
+    options->size_count = 0;
+    while (*text != '\0') {
+        if (options->size_count == BENCH_MAX_SIZES ||
+            !parse_count(text, &options->sizes[options->size_count])) {
+            return 0;
+        }
+        ++options->size_count;
+        const char *comma = strchr(text, ',');
+        if (comma == NULL) {
+            break;
+        }
+        text = comma + 1;
+    }
+    return options->size_count != 0;
+}
+
+static void print_usage(const char *program) {
+    fprintf(
+        stderr,
+        "usage: %s [--format=table|csv|json] [--trials=N] [--sizes=N,...]\n"
+        "          [--distributions=a,...] [--elements=a,...]"
+        " [--engines=a,...]\n"
+        "          [--threads=N] [--counters] [--seed=N] [--quick]\n",
+        program
+    );
+}
+
+static int parse_options(int argc, char **argv, bench_options *options) {
+    static const size_t kDefaultSizes[] = {1000U, 100000U, 1000000U};
+    options->format = FORMAT_TABLE;
+    options->trials = 7U;
+    options->size_count = sizeof(kDefaultSizes) / sizeof(kDefaultSizes[0]);
+    memcpy(options->sizes, kDefaultSizes, sizeof(kDefaultSizes));
+    options->distributions = NULL;
+    options->elements = NULL;
+    options->engines = NULL;
+    options->counters = 0;
+    options->seed = 42U;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *arg = argv[i];
+        size_t count = 0;
+        if (strcmp(arg, "--format=table") == 0) {
+            options->format = FORMAT_TABLE;
+        } else if (strcmp(arg, "--format=csv") == 0) {
+            options->format = FORMAT_CSV;
+        } else if (strcmp(arg, "--format=json") == 0) {
+            options->format = FORMAT_JSON;
+        } else if (strncmp(arg, "--trials=", 9) == 0 &&
+                   parse_count(arg + 9, &count) && count <= BENCH_MAX_TRIALS) {
+            options->trials = count;
+        } else if (strncmp(arg, "--sizes=", 8) == 0 &&
+                   parse_sizes(arg + 8, options)) {
+            continue;
+        } else if (strncmp(arg, "--distributions=", 16) == 0) {
+            options->distributions = arg + 16;
+        } else if (strncmp(arg, "--elements=", 11) == 0) {
+            options->elements = arg + 11;
+        } else if (strncmp(arg, "--engines=", 10) == 0) {
+            options->engines = arg + 10;
+        } else if (strncmp(arg, "--threads=", 10) == 0 &&
+                   parse_count(arg + 10, &count)) {
+            g_threads = count;
+        } else if (strcmp(arg, "--counters") == 0) {
+            options->counters = 1;
+        } else if (strncmp(arg, "--seed=", 7) == 0 &&
+                   parse_count(arg + 7, &count)) {
+            options->seed = (uint64_t)count;
+        } else if (strcmp(arg, "--quick") == 0) {
+            // Small smoke run for CI.
+            options->trials = 3U;
+            options->size_count = 2U;
+            options->sizes[0] = 1000U;
+            options->sizes[1] = 20000U;
+        } else {
+            print_usage(argv[0]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    bench_options options;
+    if (!parse_options(argc, argv, &options)) {
+        return 2;
+    }
+
+    size_t max_size = 0;
+    for (size_t i = 0; i < options.size_count; ++i) {
+        if (options.sizes[i] > max_size) {
+            max_size = options.sizes[i];
+        }
+    }
+    size_t max_bytes = 0;
+    for (size_t e = 0; e < sizeof(kElements) / sizeof(kElements[0]); ++e) {
+        size_t limit = BENCH_MAX_BUFFER_BYTES / kElements[e].element_size;
+        size_t count = max_size < limit ? max_size : limit;
+        if (count * kElements[e].element_size > max_bytes) {
+            max_bytes = count * kElements[e].element_size;
+        }
+    }
+
+    int *keys = (int *)malloc(max_size * sizeof(int));
+    unsigned char *base = (unsigned char *)malloc(max_bytes);
+    unsigned char *work = (unsigned char *)malloc(max_bytes);
+    if (keys == NULL || base == NULL || work == NULL) {
+        fprintf(stderr, "Failed to allocate buffers\n");
+        free(keys);
+        free(base);
+        free(work);
+        return 1;
+    }
+
+    int status = 0;
+    print_header(&options);
+    const size_t distribution_count =
+        sizeof(kDistributions) / sizeof(kDistributions[0]);
+    const size_t element_count = sizeof(kElements) / sizeof(kElements[0]);
+    const size_t engine_count = sizeof(kEngines) / sizeof(kEngines[0]);
+    for (size_t d = 0; d < distribution_count && status == 0; ++d) {
+        const char *distribution = kDistributions[d];
+        if (!selected(options.distributions, distribution)) {
+            continue;
+        }
+        for (size_t s = 0; s < options.size_count && status == 0; ++s) {
+            size_t size = options.sizes[s];
+            g_rng_state = (options.seed * 0x9E3779B97F4A7C15ULL) + d + 1U;
+            if (!fill_keys(keys, size, distribution)) {
+                fprintf(stderr, "Failed to generate %s keys\n", distribution);
+                status = 1;
+                break;
+            }
+            for (size_t e = 0; e < element_count && status == 0; ++e) {
+                const element_layout *layout = &kElements[e];
+                if (!selected(options.elements, layout->name) ||
+                    size > BENCH_MAX_BUFFER_BYTES / layout->element_size) {
+                    continue;
+                }
+                build_elements(base, keys, size, layout);
+
+                double qsort_median_ns = 0.0;
+                for (size_t k = 0; k < engine_count; ++k) {
+                    const sort_engine *engine = &kEngines[k];
+                    // The baseline always runs so that ratios are available.
+                    int baseline = k == 0;
+                    if ((!baseline &&
+                         !selected(options.engines, engine->name)) ||
+                        !engine_supports(engine, layout) ||
+                        size > engine->max_size) {
+                        continue;
+                    }
+                    bench_result result;
+                    if (!measure(
+                            engine, layout, base, work, size, &options,
+                            &result
+                        )) {
+                        fprintf(
+                            stderr, "%s left %s/%s/%zu unsorted\n",
+                            engine->name, distribution, layout->name, size
+                        );
+                        status = 1;
+                        break;
+                    }
+                    if (baseline) {
+                        qsort_median_ns = result.median_ns;
+                    }
+                    if (!baseline || selected(options.engines, "qsort")) {
+                        print_result(
+                            &options, distribution, layout, size, engine,
+                            &result, qsort_median_ns
+                        );
+                    }
+                }
+            }
+        }
+    }
+    print_footer(&options);
+
+    free(keys);
+    free(base);
+    free(work);
+    return status;
+}
@@ -31,7 +31,7 @@ static void print_operation_separator(void) {
     printf("+----------------------+--------------+--------------------+\n");
 }
 
-// Render a compact summary similar to the sorting stress harness so that the
+// Render a compact summary similar to the sort benchmark so that the
 // data structure runs expose throughput at a glance.
 static void print_operation_table(
     const char *title,
@@ -0,0 +1,160 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/argsort.h"
+#include "algorithms_c/utils/minunit.h"
+
+typedef struct {
+    int key;
+    size_t origin;
+    unsigned char payload[240];
+} fat_record;
+
+static int compare_fat_record(const void *lhs, const void *rhs) {
+    int left = ((const fat_record *)lhs)->key;
+    int right = ((const fat_record *)rhs)->key;
+    return (left > right) - (left < right);
+}
+
+static fat_record *make_records(size_t size, int modulus) {
+    fat_record *records = (fat_record *)malloc(size * sizeof(fat_record));
+    if (records == NULL) {
+        return NULL;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        records[i].key = rand() % modulus;
+        records[i].origin = i;
+        memset(
+            records[i].payload, (int)(i & 0xFFU), sizeof(records[i].payload)
+        );
+    }
+    return records;
+}
+
+static void test_argsort_orders_indices_without_moving_data(void) {
+    enum { kSize = 5000 };
+    fat_record *records = make_records(kSize, 100000);
+    size_t *perm = (size_t *)malloc(kSize * sizeof(size_t));
+    MU_ASSERT(records != NULL && perm != NULL);
+    if (records == NULL || perm == NULL) {
+        free(records);
+        free(perm);
+        return;
+    }
+
+    MU_ASSERT(
+        ac_argsort(
+            records, kSize, sizeof(fat_record), compare_fat_record, perm
+        ) == 0
+    );
+    for (size_t i = 0; i < kSize; ++i) {
+        MU_ASSERT(records[i].origin == i);
+    }
+    for (size_t i = 1; i < kSize; ++i) {
+        MU_ASSERT(records[perm[i - 1]].key <= records[perm[i]].key);
+    }
+    free(records);
+    free(perm);
+}
+
+static void test_stable_argsort_keeps_ties_in_input_order(void) {
+    enum { kSize = 4000 };
+    fat_record *records = make_records(kSize, 7);
+    size_t *perm = (size_t *)malloc(kSize * sizeof(size_t));
+    MU_ASSERT(records != NULL && perm != NULL);
+    if (records == NULL || perm == NULL) {
+        free(records);
+        free(perm);
+        return;
+    }
+
+    MU_ASSERT(
+        ac_stable_argsort(
+            records, kSize, sizeof(fat_record), compare_fat_record, perm
+        ) == 0
+    );
+    for (size_t i = 1; i < kSize; ++i) {
+        const fat_record *prev = &records[perm[i - 1]];
+        const fat_record *next = &records[perm[i]];
+        MU_ASSERT(prev->key <= next->key);
+        if (prev->key == next->key) {
+            MU_ASSERT(perm[i - 1] < perm[i]);
+        }
+    }
+    free(records);
+    free(perm);
+}
+
+static void test_apply_permutation_matches_stable_sort(void) {
+    enum { kSize = 3000 };
+    fat_record *records = make_records(kSize, 50);
+    fat_record *expected = (fat_record *)malloc(kSize * sizeof(fat_record));
+    size_t *perm = (size_t *)malloc(kSize * sizeof(size_t));
+    MU_ASSERT(records != NULL && expected != NULL && perm != NULL);
+    if (records == NULL || expected == NULL || perm == NULL) {
+        free(records);
+        free(expected);
+        free(perm);
+        return;
+    }
+
+    memcpy(expected, records, kSize * sizeof(fat_record));
+    ac_merge_sort(expected, kSize, sizeof(fat_record), compare_fat_record);
+    MU_ASSERT(
+        ac_stable_argsort(
+            records, kSize, sizeof(fat_record), compare_fat_record, perm
+        ) == 0
+    );
+    MU_ASSERT(
+        ac_apply_permutation(records, kSize, sizeof(fat_record), perm) == 0
+    );
+    MU_ASSERT(memcmp(records, expected, kSize * sizeof(fat_record)) == 0);
+    free(records);
+    free(expected);
+    free(perm);
+}
+
+static void test_apply_permutation_rejects_invalid_permutations(void) {
+    int data[] = {10, 20, 30, 40};
+    const size_t duplicate[] = {0, 1, 1, 3};
+    const size_t out_of_range[] = {0, 1, 2, 4};
+    const size_t rotation[] = {1, 2, 3, 0};
+
+    MU_ASSERT(
+        ac_apply_permutation(data, 4, sizeof(int), duplicate) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_apply_permutation(data, 4, sizeof(int), out_of_range) == -EINVAL
+    );
+    MU_ASSERT(data[0] == 10 && data[3] == 40);
+    MU_ASSERT(ac_apply_permutation(data, 4, sizeof(int), rotation) == 0);
+    MU_ASSERT(data[0] == 20);
+    MU_ASSERT(data[1] == 30);
+    MU_ASSERT(data[2] == 40);
+    MU_ASSERT(data[3] == 10);
+}
+
+static void test_argsort_invalid_arguments(void) {
+    int data[] = {3, 1, 2};
+    size_t perm[3];
+    MU_ASSERT(
+        ac_argsort(NULL, 3, sizeof(int), ac_compare_int, perm) == -EINVAL
+    );
+    MU_ASSERT(ac_argsort(data, 3, sizeof(int), NULL, perm) == -EINVAL);
+    MU_ASSERT(
+        ac_argsort(data, 3, sizeof(int), ac_compare_int, NULL) == -EINVAL
+    );
+    MU_ASSERT(ac_stable_argsort(data, 3, 0, ac_compare_int, perm) == -EINVAL);
+    MU_ASSERT(ac_argsort(NULL, 0, sizeof(int), ac_compare_int, NULL) == 0);
+    MU_ASSERT(ac_apply_permutation(data, 3, sizeof(int), NULL) == -EINVAL);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_argsort_orders_indices_without_moving_data);
+    run_test(test_stable_argsort_keeps_ties_in_input_order);
+    run_test(test_apply_permutation_matches_stable_sort);
+    run_test(test_apply_permutation_rejects_invalid_permutations);
+    run_test(test_argsort_invalid_arguments);
+    return summary();
+}
@@ -1,3 +1,4 @@
+#include <errno.h>
 #include <limits.h>
 #include <stdlib.h>
 #include <string.h>
@@ -94,11 +95,161 @@ static void test_small_matrix_sorted_by_first_column(void) {
 
 static void test_randomized_matrix(void) {
     run_randomized_case(64, 8, 3);
+    run_randomized_case(1000, 3, 0);
+}
+
+static void test_nulls_sort_last_and_keep_order(void) {
+    int *data[] = {
+        (int[]){INT_MIN, 0}, (int[]){5, 1}, (int[]){-7, 2},
+        (int[]){INT_MIN, 3}, (int[]){5, 4}, (int[]){INT_MAX, 5},
+    };
+
+    ac_array_count_sort(data, 6, 2, 0);
+
+    int expected[][2] = {
+        {-7, 2}, {5, 1}, {5, 4}, {INT_MAX, 5}, {INT_MIN, 0}, {INT_MIN, 3},
+    };
+    for (size_t i = 0; i < 6; ++i) {
+        MU_ASSERT(data[i][0] == expected[i][0]);
+        MU_ASSERT(data[i][1] == expected[i][1]);
+    }
+    ac_array_count_sort(NULL, 6, 2, 0);
+    ac_array_count_sort(data, 6, 2, 2);
+    MU_ASSERT(data[0][0] == -7);
+}
+
+static const size_t *g_keys = NULL;
+static size_t g_key_count = 0;
+static size_t g_stride = 0;
+static unsigned g_flags = 0;
+
+static long long ordered_key(int value) {
+    if ((g_flags & AC_ROW_SORT_NULLS_LAST) != 0U && value == INT_MIN) {
+        return (long long)INT_MAX + 1;
+    }
+    return value;
+}
+
+/** Compare table rows by the global keys, then by the original row id. */
+static int compare_table_rows(const void *lhs, const void *rhs) {
+    const int *left = (const int *)lhs;
+    const int *right = (const int *)rhs;
+    for (size_t k = 0; k < g_key_count; ++k) {
+        long long a = ordered_key(left[g_keys[k]]);
+        long long b = ordered_key(right[g_keys[k]]);
+        if (a != b) {
+            return a < b ? -1 : 1;
+        }
+    }
+    int a = left[g_stride - 1];
+    int b = right[g_stride - 1];
+    return (a > b) - (a < b);
+}
+
+/**
+ * Sort a random table and compare against ``qsort`` over a copy whose rows
+ * end with their original index, which serves as the final tie-break.
+ */
+static void check_row_sort(
+    size_t rows,
+    size_t cols,
+    size_t stride,
+    const size_t *keys,
+    size_t key_count,
+    int modulus,
+    unsigned flags
+) {
+    // The reference rows carry their original index as an extra column.
+    size_t ref_stride = cols + 1U;
+    size_t cells = rows * stride + 1U;
+    int *table = (int *)malloc(cells * sizeof(int));
+    int *padding = (int *)malloc(cells * sizeof(int));
+    int *reference = (int *)malloc((rows * ref_stride + 1U) * sizeof(int));
+    MU_ASSERT(table != NULL && padding != NULL && reference != NULL);
+    if (table == NULL || padding == NULL || reference == NULL) {
+        free(table);
+        free(padding);
+        free(reference);
+        return;
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < stride; ++j) {
+            int value = j == 0 ? (int)i : rand() % modulus - (modulus / 2);
+            if (j != 0 && rand() % 16 == 0) {
+                value = rand() % 2 == 0 ? INT_MIN : INT_MAX;
+            }
+            table[i * stride + j] = value;
+            if (j < cols) {
+                reference[i * ref_stride + j] = value;
+            }
+        }
+        reference[i * ref_stride + cols] = (int)i;
+    }
+    memcpy(padding, table, cells * sizeof(int));
+
+    MU_ASSERT(
+        ac_row_sort_int(table, rows, cols, stride, keys, key_count, flags) == 0
+    );
+    g_keys = keys;
+    g_key_count = key_count;
+    g_stride = ref_stride;
+    g_flags = flags;
+    qsort(reference, rows, ref_stride * sizeof(int), compare_table_rows);
+
+    int same = 1;
+    for (size_t i = 0; i < rows; ++i) {
+        for (size_t j = 0; j < cols; ++j) {
+            if (table[i * stride + j] != reference[i * ref_stride + j]) {
+                same = 0;
+            }
+        }
+        for (size_t j = cols; j < stride; ++j) {
+            // Padding is not part of the row and stays where it was.
+            if (table[i * stride + j] != padding[i * stride + j]) {
+                same = 0;
+            }
+        }
+    }
+    MU_ASSERT(same);
+    free(table);
+    free(padding);
+    free(reference);
+}
+
+static void test_row_sort_multiple_keys(void) {
+    const size_t one_key[] = {2};
+    const size_t two_keys[] = {1, 3};
+    const size_t three_keys[] = {3, 1, 2};
+    check_row_sort(5000U, 4U, 4U, one_key, 1U, 50, 0U);
+    check_row_sort(5000U, 4U, 4U, one_key, 1U, 50, AC_ROW_SORT_NULLS_LAST);
+    check_row_sort(5000U, 4U, 6U, two_keys, 2U, 7, AC_ROW_SORT_NULLS_LAST);
+    check_row_sort(3000U, 5U, 5U, three_keys, 3U, 1 << 30, 0U);
+    check_row_sort(3000U, 5U, 8U, three_keys, 3U, 3, AC_ROW_SORT_NULLS_LAST);
+    check_row_sort(1U, 4U, 4U, two_keys, 2U, 5, 0U);
+}
+
+static void test_row_sort_rejects_bad_input(void) {
+    int table[6] = {3, 1, 2, 2, 1, 3};
+    const size_t keys[] = {0};
+    const size_t bad_keys[] = {2};
+    MU_ASSERT(ac_row_sort_int(NULL, 3, 2, 2, keys, 1, 0) == -EINVAL);
+    MU_ASSERT(ac_row_sort_int(table, 3, 2, 2, NULL, 1, 0) == -EINVAL);
+    MU_ASSERT(ac_row_sort_int(table, 3, 2, 1, keys, 1, 0) == -EINVAL);
+    MU_ASSERT(ac_row_sort_int(table, 3, 0, 2, keys, 1, 0) == -EINVAL);
+    MU_ASSERT(ac_row_sort_int(table, 3, 2, 2, bad_keys, 1, 0) == -EINVAL);
+    MU_ASSERT(ac_row_sort_int(table, 3, 2, 2, keys, 0, 0) == 0);
+    MU_ASSERT(table[0] == 3);
+    MU_ASSERT(ac_row_sort_int(table, 3, 2, 2, keys, 1, 0) == 0);
+    MU_ASSERT(table[0] == 1 && table[1] == 3);
+    MU_ASSERT(table[4] == 3 && table[5] == 1);
 }
 
 int main(void) {
     srand(12345u);
     run_test(test_small_matrix_sorted_by_first_column);
     run_test(test_randomized_matrix);
+    run_test(test_nulls_sort_last_and_keep_order);
+    run_test(test_row_sort_multiple_keys);
+    run_test(test_row_sort_rejects_bad_input);
     return summary();
 }
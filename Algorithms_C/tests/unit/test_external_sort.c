@@ -0,0 +1,187 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "algorithms_c/algorithms/external_sort.h"
+#include "algorithms_c/utils/minunit.h"
+
+typedef struct {
+    int key;
+    int sequence;
+} keyed_record;
+
+static int compare_keyed_record(const void *lhs, const void *rhs) {
+    int left = ((const keyed_record *)lhs)->key;
+    int right = ((const keyed_record *)rhs)->key;
+    return (left > right) - (left < right);
+}
+
+/** Create an empty temporary file and store its name in ``path``. */
+static int make_temp_path(char *path, size_t capacity) {
+    const char *directory = getenv("TMPDIR");
+    if (directory == NULL || directory[0] == '\0') {
+        directory = "/tmp";
+    }
+    int written = snprintf(
+        path, capacity, "%s/ac_external_sort_test_XXXXXX", directory
+    );
+    if (written < 0 || (size_t)written >= capacity) {
+        return -1;
+    }
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return -1;
+    }
+    close(fd);
+    return 0;
+}
+
+static int write_file(const char *path, const void *data, size_t bytes) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return -1;
+    }
+    size_t put = bytes == 0 ? 0 : fwrite(data, 1, bytes, file);
+    int closed = fclose(file);
+    return put == bytes && closed == 0 ? 0 : -1;
+}
+
+/** Read ``path`` into ``data``; returns the byte count or ``-1``. */
+static long read_file(const char *path, void *data, size_t capacity) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+    size_t got = fread(data, 1, capacity, file);
+    int extra = fgetc(file);
+    fclose(file);
+    return extra == EOF ? (long)got : -1;
+}
+
+/**
+ * Sort ``count`` random records through the external sorter with the given
+ * budget and verify order and stability.
+ */
+static void check_external_sort(size_t count, int modulus, size_t budget) {
+    char in_path[512];
+    char out_path[512];
+    MU_ASSERT(make_temp_path(in_path, sizeof(in_path)) == 0);
+    MU_ASSERT(make_temp_path(out_path, sizeof(out_path)) == 0);
+
+    size_t bytes = count * sizeof(keyed_record);
+    keyed_record *records = (keyed_record *)malloc(bytes + 1U);
+    MU_ASSERT(records != NULL);
+    if (records == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        records[i].key = rand() % modulus;
+        records[i].sequence = (int)i;
+    }
+    MU_ASSERT(write_file(in_path, records, bytes) == 0);
+    MU_ASSERT(
+        ac_external_sort(
+            in_path, out_path, sizeof(keyed_record), compare_keyed_record,
+            budget
+        ) == 0
+    );
+
+    memset(records, 0, bytes);
+    MU_ASSERT(read_file(out_path, records, bytes + 1U) == (long)bytes);
+    int stable = 1;
+    for (size_t i = 1; i < count; ++i) {
+        if (records[i - 1].key > records[i].key ||
+            (records[i - 1].key == records[i].key &&
+             records[i - 1].sequence > records[i].sequence)) {
+            stable = 0;
+        }
+    }
+    MU_ASSERT(stable);
+
+    free(records);
+    remove(in_path);
+    remove(out_path);
+}
+
+static void test_external_sort_with_many_merge_passes(void) {
+    // 8 KiB budget: 512-record runs merged two at a time.
+    check_external_sort(50000U, 1000, 8192U);
+}
+
+static void test_external_sort_with_wide_fan_in(void) {
+    check_external_sort(200000U, 1 << 30, 256U * 1024U);
+}
+
+static void test_external_sort_in_memory_and_edge_sizes(void) {
+    check_external_sort(0U, 10, 8192U);
+    check_external_sort(1U, 10, 8192U);
+    check_external_sort(300U, 10, 8192U);
+    // Exactly one full chunk (4096 bytes), then end of file.
+    check_external_sort(512U, 50, 6144U);
+}
+
+static void test_external_sort_in_place(void) {
+    enum { kCount = 3000 };
+    int values[kCount];
+    for (int i = 0; i < kCount; ++i) {
+        values[i] = kCount - i;
+    }
+    char path[512];
+    MU_ASSERT(make_temp_path(path, sizeof(path)) == 0);
+    MU_ASSERT(write_file(path, values, sizeof(values)) == 0);
+    MU_ASSERT(
+        ac_external_sort(path, path, sizeof(int), ac_compare_int, 4096U) == 0
+    );
+    MU_ASSERT(read_file(path, values, sizeof(values)) == (long)sizeof(values));
+    for (int i = 0; i < kCount; ++i) {
+        MU_ASSERT(values[i] == i + 1);
+    }
+    remove(path);
+}
+
+static void test_external_sort_rejects_bad_input(void) {
+    char in_path[512];
+    char out_path[512];
+    MU_ASSERT(make_temp_path(in_path, sizeof(in_path)) == 0);
+    MU_ASSERT(make_temp_path(out_path, sizeof(out_path)) == 0);
+
+    const unsigned char ragged[10] = {0};
+    MU_ASSERT(write_file(in_path, ragged, sizeof(ragged)) == 0);
+    MU_ASSERT(
+        ac_external_sort(in_path, out_path, sizeof(int), ac_compare_int, 4096) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_external_sort(in_path, out_path, sizeof(int), ac_compare_int, 20) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_external_sort(NULL, out_path, sizeof(int), ac_compare_int, 4096) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_external_sort(in_path, out_path, sizeof(int), NULL, 4096) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_external_sort(in_path, out_path, 0, ac_compare_int, 4096) == -EINVAL
+    );
+    remove(in_path);
+    MU_ASSERT(
+        ac_external_sort(in_path, out_path, sizeof(int), ac_compare_int, 4096) ==
+        -ENOENT
+    );
+    remove(out_path);
+}
+
+int main(void) {
+    srand(1111u);
+    run_test(test_external_sort_with_many_merge_passes);
+    run_test(test_external_sort_with_wide_fan_in);
+    run_test(test_external_sort_in_memory_and_edge_sizes);
+    run_test(test_external_sort_in_place);
+    run_test(test_external_sort_rejects_bad_input);
+    return summary();
+}
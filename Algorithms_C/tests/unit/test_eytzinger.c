@@ -0,0 +1,194 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "algorithms_c/algorithms/binary_search.h"
+#include "algorithms_c/algorithms/eytzinger.h"
+#include "algorithms_c/utils/minunit.h"
+
+static int compare_double(const void *lhs, const void *rhs) {
+    double a = *(const double *)lhs;
+    double b = *(const double *)rhs;
+    return (a > b) - (a < b);
+}
+
+/** Sorted table of ``size`` values in steps of 0 to 2, so with duplicates. */
+static void fill_sorted(int *values, double *doubles, size_t size) {
+    int value = -(int)size;
+    for (size_t i = 0; i < size; ++i) {
+        value += rand() % 3;
+        values[i] = value;
+        doubles[i] = (double)value / 4.0;
+    }
+}
+
+static void test_eytzinger_matches_lower_bound(void) {
+    enum { kMaxSize = 300 };
+    int values[kMaxSize];
+    double doubles[kMaxSize];
+
+    for (size_t size = 0; size <= kMaxSize; ++size) {
+        fill_sorted(values, doubles, size);
+        ac_eytzinger_index ints;
+        ac_eytzinger_index reals;
+        ac_eytzinger_index generic;
+        MU_ASSERT(ac_eytzinger_init_int(&ints, values, size) == 0);
+        MU_ASSERT(ac_eytzinger_init_double(&reals, doubles, size) == 0);
+        MU_ASSERT(
+            ac_eytzinger_init(
+                &generic, doubles, size, sizeof(double), compare_double
+            ) == 0
+        );
+
+        // Every value between the extremes plus one past each end.
+        int low = size == 0 ? 0 : values[0] - 1;
+        int high = size == 0 ? 0 : values[size - 1U] + 1;
+        for (int target = low; target <= high; ++target) {
+            double real = (double)target / 4.0;
+            size_t expected = ac_lower_bound(
+                values, size, sizeof(int), &target, ac_compare_int
+            );
+            MU_ASSERT(ac_eytzinger_lower_bound_int(&ints, target) == expected);
+            MU_ASSERT(ac_eytzinger_lower_bound(&ints, &target) == expected);
+            MU_ASSERT(
+                ac_eytzinger_lower_bound_double(&reals, real) == expected
+            );
+            MU_ASSERT(ac_eytzinger_lower_bound(&generic, &real) == expected);
+            // Halfway between two table values.
+            real += 0.125;
+            MU_ASSERT(
+                ac_eytzinger_lower_bound_double(&reals, real) ==
+                ac_lower_bound(
+                    doubles, size, sizeof(double), &real, compare_double
+                )
+            );
+        }
+        MU_ASSERT(ac_eytzinger_lower_bound_int(&ints, INT_MIN) == 0);
+        MU_ASSERT(ac_eytzinger_lower_bound_int(&ints, INT_MAX) == size);
+
+        ac_eytzinger_destroy(&ints);
+        ac_eytzinger_destroy(&reals);
+        ac_eytzinger_destroy(&generic);
+    }
+}
+
+static void test_eytzinger_large_table(void) {
+    // Deep enough for the prefetch to reach four levels ahead.
+    enum { kSize = 100003, kQueries = 20000 };
+    int *values = (int *)malloc(kSize * sizeof(int));
+    double *doubles = (double *)malloc(kSize * sizeof(double));
+    MU_ASSERT(values != NULL && doubles != NULL);
+    if (values == NULL || doubles == NULL) {
+        free(values);
+        free(doubles);
+        return;
+    }
+    fill_sorted(values, doubles, kSize);
+
+    ac_eytzinger_index ints;
+    ac_eytzinger_index reals;
+    MU_ASSERT(ac_eytzinger_init_int(&ints, values, kSize) == 0);
+    MU_ASSERT(ac_eytzinger_init_double(&reals, doubles, kSize) == 0);
+    int span = values[kSize - 1] - values[0] + 3;
+    for (size_t q = 0; q < kQueries; ++q) {
+        int target = values[0] - 1 + (rand() % span);
+        double real = (double)target / 4.0;
+        size_t expected = ac_lower_bound(
+            values, kSize, sizeof(int), &target, ac_compare_int
+        );
+        MU_ASSERT(ac_eytzinger_lower_bound_int(&ints, target) == expected);
+        MU_ASSERT(ac_eytzinger_lower_bound_double(&reals, real) == expected);
+    }
+    ac_eytzinger_destroy(&ints);
+    ac_eytzinger_destroy(&reals);
+    free(values);
+    free(doubles);
+}
+
+/** Record wider than its ``int`` key, ordered by ``ac_compare_int``. */
+typedef struct {
+    int key;
+    int payload[3];
+} wide_record;
+
+static void test_eytzinger_wide_records(void) {
+    enum { kSize = 100 };
+    wide_record records[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        records[i].key = (int)(2U * i);
+        records[i].payload[0] = -1;
+        records[i].payload[1] = -1;
+        records[i].payload[2] = -1;
+    }
+
+    ac_eytzinger_index index;
+    MU_ASSERT(
+        ac_eytzinger_init(
+            &index, records, kSize, sizeof(wide_record), ac_compare_int
+        ) == 0
+    );
+    for (int target = -1; target <= (int)(2U * kSize); ++target) {
+        wide_record probe = {target, {0, 0, 0}};
+        MU_ASSERT(
+            ac_eytzinger_lower_bound(&index, &probe) ==
+            (size_t)(target + 1) / 2U
+        );
+        // The index holds records, not packed ints.
+        MU_ASSERT(ac_eytzinger_lower_bound_int(&index, target) == kSize);
+    }
+    ac_eytzinger_destroy(&index);
+}
+
+static void test_eytzinger_invalid_arguments(void) {
+    int values[] = {1, 3, 5};
+    int target = 3;
+    ac_eytzinger_index index;
+
+    MU_ASSERT(
+        ac_eytzinger_init(NULL, values, 3, sizeof(int), ac_compare_int) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_eytzinger_init(&index, NULL, 3, sizeof(int), ac_compare_int) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_eytzinger_init(&index, values, 3, 0, ac_compare_int) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_eytzinger_init(&index, values, 3, sizeof(int), NULL) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_eytzinger_init(
+            &index, values, SIZE_MAX / 2U, sizeof(int), ac_compare_int
+        ) == -ENOMEM
+    );
+
+    MU_ASSERT(ac_eytzinger_lower_bound(NULL, &target) == 0);
+    MU_ASSERT(ac_eytzinger_lower_bound_int(NULL, target) == 0);
+    MU_ASSERT(ac_eytzinger_lower_bound_double(NULL, 3.0) == 0);
+
+    MU_ASSERT(ac_eytzinger_init_int(&index, values, 3) == 0);
+    MU_ASSERT(ac_eytzinger_lower_bound(&index, NULL) == 3);
+    // A typed query against an index of another type fails safe.
+    MU_ASSERT(ac_eytzinger_lower_bound_double(&index, 3.0) == 3);
+    MU_ASSERT(ac_eytzinger_lower_bound_int(&index, target) == 1);
+    ac_eytzinger_destroy(&index);
+    MU_ASSERT(index.nodes == NULL && index.memory == NULL);
+    MU_ASSERT(index.size == 0);
+    MU_ASSERT(ac_eytzinger_lower_bound_int(&index, target) == 0);
+    ac_eytzinger_destroy(NULL);
+
+    MU_ASSERT(ac_eytzinger_init_int(&index, NULL, 0) == 0);
+    MU_ASSERT(ac_eytzinger_lower_bound_int(&index, target) == 0);
+    ac_eytzinger_destroy(&index);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_eytzinger_matches_lower_bound);
+    run_test(test_eytzinger_large_table);
+    run_test(test_eytzinger_wide_records);
+    run_test(test_eytzinger_invalid_arguments);
+    return summary();
+}
@@ -0,0 +1,187 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "algorithms_c/algorithms/binary_search.h"
+#include "algorithms_c/algorithms/sorting.h"
+#include "algorithms_c/structures/heap.h"
+#include "algorithms_c/utils/instrument.h"
+#include "algorithms_c/utils/minunit.h"
+
+#define TEST_SIZE 300U
+
+static uint64_t compare_calls;
+
+static int counting_compare(const void *lhs, const void *rhs) {
+    ++compare_calls;
+    return ac_compare_int(lhs, rhs);
+}
+
+static void fill_shuffled(int *data, size_t size) {
+    uint32_t state = 12345U;
+    for (size_t i = 0; i < size; ++i) {
+        state = (state * 1103515245U) + 12345U;
+        data[i] = (int)((state >> 8) % 97U);
+    }
+}
+
+/** The counters must agree with the comparator, or stay at zero. */
+static void check_counters(uint64_t expect_moves_at_least) {
+    ac_instrument_counters counters;
+    ac_instrument_snapshot(&counters);
+    if (ac_instrument_enabled()) {
+        MU_ASSERT(counters.comparisons == compare_calls);
+        MU_ASSERT(counters.moves >= expect_moves_at_least);
+    } else {
+        MU_ASSERT(counters.comparisons == 0);
+        MU_ASSERT(counters.moves == 0);
+    }
+}
+
+typedef void (*sort_fn)(void *, size_t, size_t, ac_compare_fn);
+
+static void test_instrument_counts_sorts(void) {
+    sort_fn sorts[] = {
+        ac_insertion_sort, ac_binary_insertion_sort,
+        ac_bubble_sort,    ac_selection_sort,
+        ac_shell_sort,     ac_comb_sort,
+        ac_merge_sort,     ac_tim_sort,
+        ac_quick_sort,     ac_heap_sort,
+    };
+    for (size_t s = 0; s < sizeof(sorts) / sizeof(sorts[0]); ++s) {
+        int data[TEST_SIZE];
+        fill_shuffled(data, TEST_SIZE);
+        ac_instrument_reset();
+        compare_calls = 0;
+        sorts[s](data, TEST_SIZE, sizeof(int), counting_compare);
+        MU_ASSERT(compare_calls > 0);
+        // Shuffled input cannot be sorted without moving something.
+        check_counters(1U);
+        for (size_t i = 1; i < TEST_SIZE; ++i) {
+            MU_ASSERT(data[i - 1U] <= data[i]);
+        }
+    }
+}
+
+static void test_instrument_sorted_input_moves(void) {
+    int data[TEST_SIZE];
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+        data[i] = (int)i;
+    }
+    ac_instrument_reset();
+    compare_calls = 0;
+    ac_tim_sort(data, TEST_SIZE, sizeof(int), counting_compare);
+    // One ascending run: n - 1 comparisons and no moves at all.
+    MU_ASSERT(compare_calls == TEST_SIZE - 1U);
+    ac_instrument_counters counters;
+    ac_instrument_snapshot(&counters);
+    MU_ASSERT(counters.moves == 0);
+    check_counters(0U);
+}
+
+static void test_instrument_parallel_merge_sort_moves(void) {
+    // Four threads split 2^15 elements into four chunks of 8192.  Sorted
+    // input leaves the 16-element insertion runs untouched, so every move
+    // is a merge copy: one per element per level, in the chunks and across
+    // them, plus one copy back after the odd number of chunk passes.
+    enum { kSize = 32768, kRunLevels = 4 };
+    static int data[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = (int)i;
+    }
+
+    ac_instrument_counters serial;
+    ac_instrument_reset();
+    ac_merge_sort(data, kSize, sizeof(int), ac_compare_int);
+    ac_instrument_snapshot(&serial);
+
+    ac_instrument_counters parallel;
+    ac_instrument_reset();
+    ac_merge_sort_parallel(data, kSize, sizeof(int), ac_compare_int, 4);
+    ac_instrument_snapshot(&parallel);
+    for (size_t i = 0; i < kSize; ++i) {
+        MU_ASSERT(data[i] == (int)i);
+    }
+    if (!ac_instrument_enabled()) {
+        MU_ASSERT(parallel.moves == 0);
+        return;
+    }
+
+    // ``ac_merge_sort`` copies every element out and back at each level.
+    uint64_t levels = serial.moves / (2U * kSize);
+    MU_ASSERT(serial.moves == 2U * kSize * levels);
+    MU_ASSERT(levels == 15U);
+    MU_ASSERT(parallel.moves == (levels - kRunLevels + 1U) * kSize);
+    MU_ASSERT(parallel.comparisons > 0);
+}
+
+static void test_instrument_counts_searches(void) {
+    int data[TEST_SIZE];
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+        data[i] = (int)(2U * i);
+    }
+    int target = 100;
+    ac_instrument_reset();
+    compare_calls = 0;
+    MU_ASSERT(
+        ac_binary_search(
+            data, TEST_SIZE, sizeof(int), &target, counting_compare
+        ) == 50
+    );
+    MU_ASSERT(
+        ac_lower_bound(
+            data, TEST_SIZE, sizeof(int), &target, counting_compare
+        ) == 50U
+    );
+    MU_ASSERT(
+        ac_upper_bound(
+            data, TEST_SIZE, sizeof(int), &target, counting_compare
+        ) == 51U
+    );
+    check_counters(0U);
+    ac_instrument_counters counters;
+    ac_instrument_snapshot(&counters);
+    MU_ASSERT(counters.moves == 0);
+}
+
+static void test_instrument_counts_heap(void) {
+    ac_heap heap;
+    MU_ASSERT(ac_heap_init(&heap, sizeof(int), counting_compare) == 0);
+    int data[TEST_SIZE];
+    fill_shuffled(data, TEST_SIZE);
+    ac_instrument_reset();
+    compare_calls = 0;
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+        MU_ASSERT(ac_heap_push(&heap, &data[i]) == 0);
+    }
+    int previous = -1;
+    for (size_t i = 0; i < TEST_SIZE; ++i) {
+        int value;
+        MU_ASSERT(ac_heap_pop(&heap, &value) == 0);
+        MU_ASSERT(previous <= value);
+        previous = value;
+    }
+    // Every push stores one element and every pop copies one out.
+    check_counters(2U * TEST_SIZE);
+    ac_heap_destroy(&heap);
+}
+
+static void test_instrument_reset(void) {
+    int data[TEST_SIZE];
+    fill_shuffled(data, TEST_SIZE);
+    ac_quick_sort(data, TEST_SIZE, sizeof(int), counting_compare);
+    ac_instrument_reset();
+    ac_instrument_counters counters;
+    ac_instrument_snapshot(&counters);
+    MU_ASSERT(counters.comparisons == 0);
+    MU_ASSERT(counters.moves == 0);
+    ac_instrument_snapshot(NULL);
+}
+
+int main(void) {
+    run_test(test_instrument_counts_sorts);
+    run_test(test_instrument_sorted_input_moves);
+    run_test(test_instrument_parallel_merge_sort_moves);
+    run_test(test_instrument_counts_searches);
+    run_test(test_instrument_counts_heap);
+    run_test(test_instrument_reset);
+    return summary();
+}
@@ -0,0 +1,214 @@
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/key_sort.h"
+#include "algorithms_c/utils/minunit.h"
+
+/** Records put the key at an unaligned offset and their origin behind it. */
+enum { kRecordSize = 24, kKeyOffset = 3, kOriginOffset = 16 };
+
+static ac_key_type g_key_type;
+static int g_descending;
+
+static size_t record_origin(const unsigned char *record) {
+    size_t origin;
+    memcpy(&origin, record + kOriginOffset, sizeof(origin));
+    return origin;
+}
+
+static int compare_keys(const unsigned char *lhs, const unsigned char *rhs) {
+    const unsigned char *a = lhs + kKeyOffset;
+    const unsigned char *b = rhs + kKeyOffset;
+    switch (g_key_type) {
+#define KEY_CASE(tag, type)                                                    \
+    case tag: {                                                                \
+        type x;                                                                \
+        type y;                                                                \
+        memcpy(&x, a, sizeof(x));                                              \
+        memcpy(&y, b, sizeof(y));                                              \
+        return (x > y) - (x < y);                                              \
+    }
+        KEY_CASE(AC_KEY_INT8, int8_t)
+        KEY_CASE(AC_KEY_UINT8, uint8_t)
+        KEY_CASE(AC_KEY_INT16, int16_t)
+        KEY_CASE(AC_KEY_UINT16, uint16_t)
+        KEY_CASE(AC_KEY_INT32, int32_t)
+        KEY_CASE(AC_KEY_UINT32, uint32_t)
+        KEY_CASE(AC_KEY_INT64, int64_t)
+        KEY_CASE(AC_KEY_UINT64, uint64_t)
+        KEY_CASE(AC_KEY_FLOAT, float)
+        KEY_CASE(AC_KEY_DOUBLE, double)
+#undef KEY_CASE
+    }
+    return 0;
+}
+
+/** Stable reference order: by key, then by origin. */
+static int compare_reference(const void *lhs, const void *rhs) {
+    const unsigned char *a = (const unsigned char *)lhs;
+    const unsigned char *b = (const unsigned char *)rhs;
+    int order = compare_keys(a, b);
+    if (g_descending) {
+        order = -order;
+    }
+    if (order != 0) {
+        return order;
+    }
+    size_t left = record_origin(a);
+    size_t right = record_origin(b);
+    return (left > right) - (left < right);
+}
+
+static uint64_t random_bits(void) {
+    uint64_t bits = 0;
+    for (int i = 0; i < 4; ++i) {
+        bits = (bits << 16U) ^ (uint64_t)(rand() & 0xFFFF);
+    }
+    return bits;
+}
+
+/** Fill a key of ``type``: half from a few duplicates, half full range. */
+static void write_key(unsigned char *field, ac_key_type type) {
+    uint64_t bits = (rand() & 1) != 0 ? random_bits()
+                                      : (uint64_t)(rand() % 7) - 3U;
+    switch (type) {
+    case AC_KEY_FLOAT: {
+        float value = (float)((int64_t)bits % 100000) / 7.0f;
+        memcpy(field, &value, sizeof(value));
+        return;
+    }
+    case AC_KEY_DOUBLE: {
+        double value = (double)(int64_t)bits / 3.0;
+        memcpy(field, &value, sizeof(value));
+        return;
+    }
+    default:
+        // Narrow keys read only their first bytes; any byte order will do.
+        for (size_t i = 0; i < 8U; ++i) {
+            field[i] = (unsigned char)(bits >> (8U * i));
+        }
+        return;
+    }
+}
+
+static void test_sort_by_key_matches_stable_reference(void) {
+    static const ac_key_type kTypes[] = {
+        AC_KEY_INT8,  AC_KEY_UINT8,  AC_KEY_INT16, AC_KEY_UINT16,
+        AC_KEY_INT32, AC_KEY_UINT32, AC_KEY_INT64, AC_KEY_UINT64,
+        AC_KEY_FLOAT, AC_KEY_DOUBLE,
+    };
+    static const size_t kSizes[] = {0, 1, 2, 64, 65, 3000};
+    enum { kMaxSize = 3000 };
+    unsigned char *records = (unsigned char *)malloc(kMaxSize * kRecordSize);
+    unsigned char *expected = (unsigned char *)malloc(kMaxSize * kRecordSize);
+    MU_ASSERT(records != NULL && expected != NULL);
+    if (records == NULL || expected == NULL) {
+        free(records);
+        free(expected);
+        return;
+    }
+
+    for (size_t t = 0; t < sizeof(kTypes) / sizeof(kTypes[0]); ++t) {
+        for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+            for (int descending = 0; descending < 2; ++descending) {
+                size_t size = kSizes[s];
+                for (size_t i = 0; i < size; ++i) {
+                    unsigned char *record = records + (i * kRecordSize);
+                    memset(record, 0xA5, kRecordSize);
+                    write_key(record + kKeyOffset, kTypes[t]);
+                    memcpy(record + kOriginOffset, &i, sizeof(i));
+                }
+                g_key_type = kTypes[t];
+                g_descending = descending;
+                if (size != 0) {
+                    memcpy(expected, records, size * kRecordSize);
+                    qsort(expected, size, kRecordSize, compare_reference);
+                }
+
+                unsigned flags = AC_SORT_BY_KEY_STABLE;
+                if (descending) {
+                    flags |= AC_SORT_BY_KEY_DESCENDING;
+                }
+                MU_ASSERT(
+                    ac_sort_by_key(
+                        records, size, kRecordSize, kKeyOffset, kTypes[t],
+                        flags
+                    ) == 0
+                );
+                MU_ASSERT(
+                    size == 0 ||
+                    memcmp(records, expected, size * kRecordSize) == 0
+                );
+            }
+        }
+    }
+    free(records);
+    free(expected);
+}
+
+static void test_sort_by_key_float_total_order(void) {
+    double values[] = {1.0, -0.0, INFINITY, -1.5, 0.0, -INFINITY, NAN, 2.0};
+    size_t count = sizeof(values) / sizeof(values[0]);
+
+    MU_ASSERT(
+        ac_sort_by_key(
+            values, count, sizeof(double), 0, AC_KEY_DOUBLE, 0U
+        ) == 0
+    );
+    MU_ASSERT(values[0] == -INFINITY && values[1] == -1.5);
+    MU_ASSERT(values[2] == 0.0 && signbit(values[2]));
+    MU_ASSERT(values[3] == 0.0 && !signbit(values[3]));
+    MU_ASSERT(values[4] == 1.0 && values[5] == 2.0);
+    MU_ASSERT(values[6] == INFINITY && isnan(values[7]));
+
+    MU_ASSERT(
+        ac_sort_by_key(
+            values, count, sizeof(double), 0, AC_KEY_DOUBLE,
+            AC_SORT_BY_KEY_DESCENDING
+        ) == 0
+    );
+    MU_ASSERT(isnan(values[0]) && values[1] == INFINITY);
+    MU_ASSERT(values[7] == -INFINITY);
+}
+
+static void test_sort_by_key_invalid_arguments(void) {
+    unsigned char records[4 * kRecordSize] = {0};
+    MU_ASSERT(
+        ac_sort_by_key(NULL, 4, kRecordSize, 0, AC_KEY_INT32, 0U) == -EINVAL
+    );
+    MU_ASSERT(ac_sort_by_key(records, 4, 0, 0, AC_KEY_INT32, 0U) == -EINVAL);
+    MU_ASSERT(
+        ac_sort_by_key(
+            records, 4, kRecordSize, kRecordSize - 7U, AC_KEY_DOUBLE, 0U
+        ) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_sort_by_key(
+            records, 4, kRecordSize, kRecordSize + 1U, AC_KEY_UINT8, 0U
+        ) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_sort_by_key(records, 4, kRecordSize, 0, (ac_key_type)99, 0U) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_sort_by_key(records, 4, kRecordSize, 0, AC_KEY_INT32, 8U) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_sort_by_key(
+            records, 4, kRecordSize, kRecordSize - 8U, AC_KEY_DOUBLE, 0U
+        ) == 0
+    );
+    MU_ASSERT(ac_sort_by_key(NULL, 0, kRecordSize, 0, AC_KEY_INT8, 0U) == 0);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_sort_by_key_matches_stable_reference);
+    run_test(test_sort_by_key_float_total_order);
+    run_test(test_sort_by_key_invalid_arguments);
+    return summary();
+}
@@ -0,0 +1,353 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/kway_merge.h"
+#include "algorithms_c/utils/minunit.h"
+
+typedef struct {
+    int key;
+    int input;
+    int sequence;
+} tagged_record;
+
+static int compare_tagged_record(const void *lhs, const void *rhs) {
+    int left = ((const tagged_record *)lhs)->key;
+    int right = ((const tagged_record *)rhs)->key;
+    return (left > right) - (left < right);
+}
+
+static size_t counted_comparisons;
+
+static int compare_int_counted(const void *lhs, const void *rhs) {
+    ++counted_comparisons;
+    return ac_compare_int(lhs, rhs);
+}
+
+/**
+ * Build ``count`` sorted inputs of random length (some empty) holding keys
+ * below ``modulus``; returns the total number of records.
+ */
+static size_t make_inputs(
+    tagged_record **inputs,
+    ac_merge_span *spans,
+    size_t count,
+    size_t max_length,
+    int modulus
+) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = (size_t)rand() % (max_length + 1U);
+        inputs[i] = (tagged_record *)malloc((length + 1U) * sizeof(**inputs));
+        int key = 0;
+        for (size_t j = 0; j < length; ++j) {
+            key += rand() % modulus;
+            inputs[i][j].key = key;
+            inputs[i][j].input = (int)i;
+            inputs[i][j].sequence = (int)j;
+        }
+        spans[i].data = inputs[i];
+        spans[i].size = length;
+        total += length;
+    }
+    return total;
+}
+
+static int is_stable_merge(const tagged_record *out, size_t total) {
+    for (size_t i = 1; i < total; ++i) {
+        const tagged_record *prev = &out[i - 1];
+        const tagged_record *cur = &out[i];
+        if (prev->key > cur->key) {
+            return 0;
+        }
+        if (prev->key == cur->key &&
+            (prev->input > cur->input ||
+             (prev->input == cur->input && prev->sequence > cur->sequence))) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void check_generic_merge(size_t count, size_t max_length, int modulus) {
+    tagged_record **inputs =
+        (tagged_record **)malloc((count + 1U) * sizeof(*inputs));
+    ac_merge_span *spans =
+        (ac_merge_span *)malloc((count + 1U) * sizeof(*spans));
+    size_t total = make_inputs(inputs, spans, count, max_length, modulus);
+    tagged_record *out =
+        (tagged_record *)malloc((total + 1U) * sizeof(tagged_record));
+
+    MU_ASSERT(
+        ac_kway_merge(
+            spans, count, sizeof(tagged_record), compare_tagged_record, out
+        ) == 0
+    );
+    MU_ASSERT(is_stable_merge(out, total));
+
+    for (size_t i = 0; i < count; ++i) {
+        free(inputs[i]);
+    }
+    free(out);
+    free(spans);
+    free(inputs);
+}
+
+static void test_kway_merge_is_stable(void) {
+    check_generic_merge(0U, 0U, 1);
+    check_generic_merge(1U, 50U, 3);
+    check_generic_merge(2U, 50U, 3);
+    check_generic_merge(7U, 200U, 2);
+    check_generic_merge(64U, 100U, 4);
+    // More than 64 inputs use a heap-allocated tree.
+    check_generic_merge(300U, 40U, 5);
+}
+
+static void test_kway_merge_comparison_count(void) {
+    enum { kInputs = 256, kLength = 64 };
+    int *data = (int *)malloc(kInputs * kLength * sizeof(int));
+    ac_merge_span spans[kInputs];
+    for (int i = 0; i < kInputs; ++i) {
+        for (int j = 0; j < kLength; ++j) {
+            data[(i * kLength) + j] = (j * kInputs) + ((i * 37) % kInputs);
+        }
+        spans[i].data = data + (i * kLength);
+        spans[i].size = kLength;
+    }
+    int *out = (int *)malloc(kInputs * kLength * sizeof(int));
+
+    counted_comparisons = 0;
+    MU_ASSERT(
+        ac_kway_merge(spans, kInputs, sizeof(int), compare_int_counted, out) ==
+        0
+    );
+    for (int i = 0; i < kInputs * kLength; ++i) {
+        MU_ASSERT(out[i] == i);
+    }
+    // Build plus one comparison per level (8) for every record.
+    MU_ASSERT(counted_comparisons <= (size_t)(kInputs * kLength * 8 + kInputs));
+
+    free(out);
+    free(data);
+}
+
+static int compare_ints_ascending(const void *lhs, const void *rhs) {
+    return ac_compare_int(lhs, rhs);
+}
+
+static void test_kway_merge_typed(void) {
+    enum { kInputs = 100, kLength = 50 };
+    int *ints = (int *)malloc(kInputs * kLength * sizeof(int));
+    double *doubles = (double *)malloc(kInputs * kLength * sizeof(double));
+    ac_merge_span int_spans[kInputs];
+    ac_merge_span double_spans[kInputs];
+    size_t total = 0;
+    for (int i = 0; i < kInputs; ++i) {
+        size_t length = (size_t)rand() % (kLength + 1);
+        int *run = ints + total;
+        double *double_run = doubles + total;
+        for (size_t j = 0; j < length; ++j) {
+            run[j] = (rand() % 2000) - 1000;
+        }
+        qsort(run, length, sizeof(int), compare_ints_ascending);
+        for (size_t j = 0; j < length; ++j) {
+            double_run[j] = run[j] * 0.5;
+        }
+        int_spans[i].data = run;
+        int_spans[i].size = length;
+        double_spans[i].data = double_run;
+        double_spans[i].size = length;
+        total += length;
+    }
+
+    int *expected = (int *)malloc((total + 1U) * sizeof(int));
+    int *int_out = (int *)malloc((total + 1U) * sizeof(int));
+    double *double_out = (double *)malloc((total + 1U) * sizeof(double));
+    memcpy(expected, ints, total * sizeof(int));
+    qsort(expected, total, sizeof(int), compare_ints_ascending);
+
+    MU_ASSERT(ac_kway_merge_int(int_spans, kInputs, int_out) == 0);
+    MU_ASSERT(ac_kway_merge_double(double_spans, kInputs, double_out) == 0);
+    for (size_t i = 0; i < total; ++i) {
+        MU_ASSERT(int_out[i] == expected[i]);
+        MU_ASSERT(double_out[i] == expected[i] * 0.5);
+    }
+    MU_ASSERT(ac_kway_merge_int(int_spans, 1U, int_out) == 0);
+    MU_ASSERT(ac_kway_merge_int(NULL, 0U, NULL) == 0);
+
+    free(double_out);
+    free(int_out);
+    free(expected);
+    free(doubles);
+    free(ints);
+}
+
+static void test_kway_cursor_emits_in_chunks(void) {
+    enum { kInputs = 20 };
+    tagged_record *inputs[kInputs];
+    ac_merge_span spans[kInputs];
+    size_t total = make_inputs(inputs, spans, kInputs, 300U, 3);
+    tagged_record *out =
+        (tagged_record *)malloc((total + 1U) * sizeof(tagged_record));
+
+    ac_kway_cursor cursor;
+    MU_ASSERT(
+        ac_kway_cursor_init(
+            &cursor, spans, kInputs, sizeof(tagged_record),
+            compare_tagged_record
+        ) == 0
+    );
+    size_t produced = 0;
+    size_t got = 0;
+    do {
+        size_t chunk = 1U + ((size_t)rand() % 97U);
+        if (chunk > total + 1U - produced) {
+            chunk = total + 1U - produced;
+        }
+        MU_ASSERT(
+            ac_kway_cursor_next(&cursor, out + produced, chunk, &got) == 0
+        );
+        produced += got;
+        if (got < chunk) {
+            break;
+        }
+    } while (produced <= total);
+    MU_ASSERT(produced == total);
+    MU_ASSERT(is_stable_merge(out, total));
+    MU_ASSERT(ac_kway_cursor_next(&cursor, out, 8U, &got) == 0);
+    MU_ASSERT(got == 0);
+    ac_kway_cursor_destroy(&cursor);
+
+    for (size_t i = 0; i < kInputs; ++i) {
+        free(inputs[i]);
+    }
+    free(out);
+}
+
+/** Refill source serving each input ``block`` records at a time. */
+typedef struct {
+    const ac_merge_span *spans;
+    size_t *served;
+    size_t block;
+    size_t fail_after;
+    size_t calls;
+} block_source;
+
+static int refill_blocks(void *context, size_t input, ac_merge_span *span) {
+    block_source *source = (block_source *)context;
+    if (++source->calls == source->fail_after) {
+        return -EIO;
+    }
+    const ac_merge_span *whole = &source->spans[input];
+    size_t offset = source->served[input];
+    size_t size = whole->size - offset;
+    if (size > source->block) {
+        size = source->block;
+    }
+    span->data = (const tagged_record *)whole->data + offset;
+    span->size = size;
+    source->served[input] = offset + size;
+    return 0;
+}
+
+static void test_kway_cursor_refill(void) {
+    enum { kInputs = 9 };
+    tagged_record *inputs[kInputs];
+    ac_merge_span spans[kInputs];
+    size_t served[kInputs] = {0};
+    size_t total = make_inputs(inputs, spans, kInputs, 500U, 4);
+    tagged_record *out =
+        (tagged_record *)malloc((total + 1U) * sizeof(tagged_record));
+
+    block_source source = {spans, served, 7U, 0U, 0U};
+    ac_kway_cursor cursor;
+    MU_ASSERT(
+        ac_kway_cursor_init_refill(
+            &cursor, kInputs, sizeof(tagged_record), compare_tagged_record,
+            refill_blocks, &source
+        ) == 0
+    );
+    size_t got = 0;
+    MU_ASSERT(ac_kway_cursor_next(&cursor, out, total + 1U, &got) == 0);
+    MU_ASSERT(got == total);
+    MU_ASSERT(is_stable_merge(out, total));
+    ac_kway_cursor_destroy(&cursor);
+
+    // A failing refill stops the merge and the error sticks.
+    memset(served, 0, sizeof(served));
+    source.fail_after = kInputs + 3U;
+    source.calls = 0;
+    MU_ASSERT(
+        ac_kway_cursor_init_refill(
+            &cursor, kInputs, sizeof(tagged_record), compare_tagged_record,
+            refill_blocks, &source
+        ) == 0
+    );
+    MU_ASSERT(ac_kway_cursor_next(&cursor, out, total + 1U, &got) == -EIO);
+    MU_ASSERT(got < total);
+    MU_ASSERT(ac_kway_cursor_next(&cursor, out, 1U, &got) == -EIO);
+    ac_kway_cursor_destroy(&cursor);
+
+    // Failure while loading the first blocks is reported by init.
+    memset(served, 0, sizeof(served));
+    source.fail_after = 2U;
+    source.calls = 0;
+    MU_ASSERT(
+        ac_kway_cursor_init_refill(
+            &cursor, kInputs, sizeof(tagged_record), compare_tagged_record,
+            refill_blocks, &source
+        ) == -EIO
+    );
+
+    for (size_t i = 0; i < kInputs; ++i) {
+        free(inputs[i]);
+    }
+    free(out);
+}
+
+static void test_kway_merge_rejects_bad_input(void) {
+    int value = 1;
+    int out[2];
+    ac_merge_span spans[2] = {{&value, 1U}, {NULL, 1U}};
+    ac_kway_cursor cursor;
+    size_t got = 0;
+
+    MU_ASSERT(ac_kway_merge(spans, 2U, sizeof(int), ac_compare_int, out) ==
+              -EINVAL);
+    MU_ASSERT(ac_kway_merge(NULL, 1U, sizeof(int), ac_compare_int, out) ==
+              -EINVAL);
+    MU_ASSERT(ac_kway_merge(spans, 1U, sizeof(int), NULL, out) == -EINVAL);
+    MU_ASSERT(ac_kway_merge(spans, 1U, 0U, ac_compare_int, out) == -EINVAL);
+    MU_ASSERT(ac_kway_merge(spans, 1U, sizeof(int), ac_compare_int, NULL) ==
+              -EINVAL);
+    MU_ASSERT(ac_kway_merge_int(spans, 2U, out) == -EINVAL);
+    MU_ASSERT(ac_kway_merge_double(NULL, 3U, NULL) == -EINVAL);
+    MU_ASSERT(
+        ac_kway_cursor_init(&cursor, spans, 2U, sizeof(int), ac_compare_int) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_kway_cursor_init_refill(
+            &cursor, 2U, sizeof(int), ac_compare_int, NULL, NULL
+        ) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_kway_cursor_init(&cursor, spans, 1U, sizeof(int), ac_compare_int) ==
+        0
+    );
+    MU_ASSERT(ac_kway_cursor_next(&cursor, NULL, 1U, &got) == -EINVAL);
+    MU_ASSERT(ac_kway_cursor_next(&cursor, out, 2U, NULL) == -EINVAL);
+    MU_ASSERT(ac_kway_cursor_next(&cursor, out, 2U, &got) == 0);
+    MU_ASSERT(got == 1U && out[0] == 1);
+    ac_kway_cursor_destroy(&cursor);
+}
+
+int main(void) {
+    srand(1212u);
+    run_test(test_kway_merge_is_stable);
+    run_test(test_kway_merge_comparison_count);
+    run_test(test_kway_merge_typed);
+    run_test(test_kway_cursor_emits_in_chunks);
+    run_test(test_kway_cursor_refill);
+    run_test(test_kway_merge_rejects_bad_input);
+    return summary();
+}
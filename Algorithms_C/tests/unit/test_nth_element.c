@@ -0,0 +1,245 @@
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/nth_element.h"
+#include "algorithms_c/utils/minunit.h"
+
+typedef struct {
+    int key;
+    unsigned char payload[300];
+} wide_record;
+
+static int compare_wide_record(const void *lhs, const void *rhs) {
+    int left = ((const wide_record *)lhs)->key;
+    int right = ((const wide_record *)rhs)->key;
+    return (left > right) - (left < right);
+}
+
+static size_t counted_comparisons;
+
+static int compare_int_counted(const void *lhs, const void *rhs) {
+    ++counted_comparisons;
+    return ac_compare_int(lhs, rhs);
+}
+
+enum input_shape {
+    SHAPE_RANDOM,
+    SHAPE_SORTED,
+    SHAPE_REVERSED,
+    SHAPE_EQUAL,
+    SHAPE_FEW_DISTINCT,
+    SHAPE_ORGAN_PIPE,
+    SHAPE_COUNT
+};
+
+static void fill(int *data, size_t size, enum input_shape shape) {
+    for (size_t i = 0; i < size; ++i) {
+        switch (shape) {
+        case SHAPE_RANDOM:
+            data[i] = rand();
+            break;
+        case SHAPE_SORTED:
+            data[i] = (int)i;
+            break;
+        case SHAPE_REVERSED:
+            data[i] = (int)(size - i);
+            break;
+        case SHAPE_EQUAL:
+            data[i] = 7;
+            break;
+        case SHAPE_FEW_DISTINCT:
+            data[i] = rand() % 4;
+            break;
+        default:
+            data[i] = (int)(i < size / 2U ? i : size - i);
+            break;
+        }
+    }
+}
+
+/** Check that ``data`` is partitioned around ``nth`` with the right value. */
+static int is_nth_partitioned(
+    const int *data,
+    const int *sorted,
+    size_t size,
+    size_t nth
+) {
+    if (data[nth] != sorted[nth]) {
+        return 0;
+    }
+    for (size_t i = 0; i < nth; ++i) {
+        if (data[i] > data[nth]) {
+            return 0;
+        }
+    }
+    for (size_t i = nth + 1U; i < size; ++i) {
+        if (data[i] < data[nth]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_nth_element_places_every_shape(void) {
+    static const size_t sizes[] = {1, 2, 17, 100, 601, 5000, 40000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        size_t size = sizes[s];
+        int *input = (int *)malloc(size * sizeof(int));
+        int *sorted = (int *)malloc(size * sizeof(int));
+        int *data = (int *)malloc(size * sizeof(int));
+        MU_ASSERT(input != NULL && sorted != NULL && data != NULL);
+        if (input == NULL || sorted == NULL || data == NULL) {
+            free(input);
+            free(sorted);
+            free(data);
+            return;
+        }
+
+        for (int shape = 0; shape < SHAPE_COUNT; ++shape) {
+            fill(input, size, (enum input_shape)shape);
+            memcpy(sorted, input, size * sizeof(int));
+            qsort(sorted, size, sizeof(int), ac_compare_int);
+
+            const size_t ranks[] = {0, size / 3U, size / 2U, size - 1U};
+            for (size_t r = 0; r < sizeof(ranks) / sizeof(ranks[0]); ++r) {
+                memcpy(data, input, size * sizeof(int));
+                MU_ASSERT(
+                    ac_nth_element(
+                        data, size, sizeof(int), ac_compare_int, ranks[r]
+                    ) == 0
+                );
+                MU_ASSERT(is_nth_partitioned(data, sorted, size, ranks[r]));
+            }
+        }
+        free(input);
+        free(sorted);
+        free(data);
+    }
+}
+
+static void test_nth_element_is_linear_on_random_input(void) {
+    enum { kSize = 200000 };
+    int *data = (int *)malloc(kSize * sizeof(int));
+    MU_ASSERT(data != NULL);
+    if (data == NULL) {
+        return;
+    }
+    fill(data, kSize, SHAPE_RANDOM);
+
+    counted_comparisons = 0;
+    MU_ASSERT(
+        ac_nth_element(
+            data, kSize, sizeof(int), compare_int_counted, kSize / 2U
+        ) == 0
+    );
+    // Floyd-Rivest needs about 1.5 n comparisons for the median.
+    MU_ASSERT(counted_comparisons < 2U * kSize);
+    free(data);
+}
+
+static void test_partial_sort_produces_sorted_prefix(void) {
+    enum { kSize = 30000, kTop = 1000 };
+    int *input = (int *)malloc(kSize * sizeof(int));
+    int *data = (int *)malloc(kSize * sizeof(int));
+    MU_ASSERT(input != NULL && data != NULL);
+    if (input == NULL || data == NULL) {
+        free(input);
+        free(data);
+        return;
+    }
+
+    for (int shape = 0; shape < SHAPE_COUNT; ++shape) {
+        fill(input, kSize, (enum input_shape)shape);
+        memcpy(data, input, kSize * sizeof(int));
+        MU_ASSERT(
+            ac_partial_sort(data, kSize, sizeof(int), ac_compare_int, kTop) ==
+            0
+        );
+        qsort(input, kSize, sizeof(int), ac_compare_int);
+        MU_ASSERT(memcmp(data, input, kTop * sizeof(int)) == 0);
+        for (size_t i = kTop; i < kSize; ++i) {
+            MU_ASSERT(data[i] >= data[kTop - 1]);
+        }
+    }
+
+    int small[] = {4, 2, 3, 1};
+    MU_ASSERT(ac_partial_sort(small, 4, sizeof(int), ac_compare_int, 10) == 0);
+    MU_ASSERT(small[0] == 1 && small[1] == 2 && small[2] == 3);
+    MU_ASSERT(small[3] == 4);
+    free(input);
+    free(data);
+}
+
+static void test_partial_sort_copy_keeps_source(void) {
+    enum { kSize = 5000, kTop = 64 };
+    wide_record *source =
+        (wide_record *)malloc(kSize * sizeof(wide_record));
+    wide_record *top = (wide_record *)malloc(kTop * sizeof(wide_record));
+    int *keys = (int *)malloc(kSize * sizeof(int));
+    MU_ASSERT(source != NULL && top != NULL && keys != NULL);
+    if (source == NULL || top == NULL || keys == NULL) {
+        free(source);
+        free(top);
+        free(keys);
+        return;
+    }
+
+    for (size_t i = 0; i < kSize; ++i) {
+        source[i].key = rand() % 100000;
+        memset(source[i].payload, (int)(i & 0xFFU), sizeof(source[i].payload));
+        keys[i] = source[i].key;
+    }
+    MU_ASSERT(
+        ac_partial_sort_copy(
+            source, kSize, sizeof(wide_record), compare_wide_record, top, kTop
+        ) == 0
+    );
+    qsort(keys, kSize, sizeof(int), ac_compare_int);
+    for (size_t i = 0; i < kTop; ++i) {
+        MU_ASSERT(top[i].key == keys[i]);
+    }
+    MU_ASSERT(source[0].payload[0] == 0 && source[1].payload[0] == 1);
+
+    int values[] = {3, 1, 2};
+    int out[5] = {0, 0, 0, 0, -1};
+    MU_ASSERT(
+        ac_partial_sort_copy(values, 3, sizeof(int), ac_compare_int, out, 5) ==
+        0
+    );
+    MU_ASSERT(out[0] == 1 && out[1] == 2 && out[2] == 3 && out[4] == -1);
+    MU_ASSERT(values[0] == 3);
+    free(source);
+    free(top);
+    free(keys);
+}
+
+static void test_selection_invalid_arguments(void) {
+    int data[] = {2, 1};
+    int out[2];
+    MU_ASSERT(ac_nth_element(data, 2, sizeof(int), ac_compare_int, 2) ==
+              -EINVAL);
+    MU_ASSERT(ac_nth_element(NULL, 2, sizeof(int), ac_compare_int, 0) ==
+              -EINVAL);
+    MU_ASSERT(ac_nth_element(data, 2, 0, ac_compare_int, 0) == -EINVAL);
+    MU_ASSERT(ac_nth_element(data, 2, sizeof(int), NULL, 0) == -EINVAL);
+    MU_ASSERT(ac_partial_sort(NULL, 0, sizeof(int), ac_compare_int, 3) == 0);
+    MU_ASSERT(ac_partial_sort(data, 2, sizeof(int), NULL, 1) == -EINVAL);
+    MU_ASSERT(
+        ac_partial_sort_copy(data, 2, sizeof(int), ac_compare_int, NULL, 2) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_partial_sort_copy(data, 2, sizeof(int), ac_compare_int, out, 0) == 0
+    );
+    MU_ASSERT(data[0] == 2 && data[1] == 1);
+}
+
+int main(void) {
+    srand(1010u);
+    run_test(test_nth_element_places_every_shape);
+    run_test(test_nth_element_is_linear_on_random_input);
+    run_test(test_partial_sort_produces_sorted_prefix);
+    run_test(test_partial_sort_copy_keeps_source);
+    run_test(test_selection_invalid_arguments);
+    return summary();
+}
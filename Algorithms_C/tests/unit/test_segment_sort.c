@@ -0,0 +1,204 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/binary_search.h"
+#include "algorithms_c/algorithms/segment_sort.h"
+#include "algorithms_c/utils/minunit.h"
+
+/** Wide element that forces the generic variant onto heap scratch. */
+typedef struct {
+    int key;
+    unsigned char payload[300];
+} wide_element;
+
+static int compare_wide(const void *lhs, const void *rhs) {
+    int a = ((const wide_element *)lhs)->key;
+    int b = ((const wide_element *)rhs)->key;
+    return (a > b) - (a < b);
+}
+
+static int compare_double(const void *lhs, const void *rhs) {
+    double a = *(const double *)lhs;
+    double b = *(const double *)rhs;
+    return (a > b) - (a < b);
+}
+
+/**
+ * Fill ``offsets`` with segments of 0 to ``max_length - 1`` elements starting
+ * at ``first``; returns the offset one past the last segment.
+ */
+static size_t fill_offsets(
+    size_t *offsets,
+    size_t num_segments,
+    size_t first,
+    size_t max_length
+) {
+    offsets[0] = first;
+    for (size_t s = 0; s < num_segments; ++s) {
+        offsets[s + 1U] = offsets[s] + ((size_t)rand() % max_length);
+    }
+    return offsets[num_segments];
+}
+
+static void test_sort_segments_matches_qsort(void) {
+    static const size_t kSegments[] = {1, 7, 300, 2000};
+    static const size_t kThreads[] = {1, 0, 3};
+    // Short segments take the networks, long ones the packed ``int`` radix.
+    static const size_t kLengths[] = {40, 400};
+    enum { kMaxSegments = 2000, kMaxLength = 400, kFirst = 5 };
+    enum { kMaxSize = kFirst + (kMaxSegments * kMaxLength) };
+    size_t *offsets = (size_t *)malloc((kMaxSegments + 1) * sizeof(size_t));
+    int *ints = (int *)malloc(kMaxSize * sizeof(int));
+    int *generic = (int *)malloc(kMaxSize * sizeof(int));
+    double *doubles = (double *)malloc(kMaxSize * sizeof(double));
+    int *expected = (int *)malloc(kMaxSize * sizeof(int));
+    MU_ASSERT(
+        offsets != NULL && ints != NULL && generic != NULL &&
+        doubles != NULL && expected != NULL
+    );
+    if (offsets == NULL || ints == NULL || generic == NULL ||
+        doubles == NULL || expected == NULL) {
+        free(offsets);
+        free(ints);
+        free(generic);
+        free(doubles);
+        free(expected);
+        return;
+    }
+
+    for (size_t n = 0; n < sizeof(kSegments) / sizeof(kSegments[0]); ++n) {
+        for (size_t t = 0; t < sizeof(kThreads) / sizeof(kThreads[0]); ++t) {
+            size_t segments = kSegments[n];
+            size_t length = kLengths[(n + t) % 2U];
+            size_t end = fill_offsets(offsets, segments, kFirst, length);
+            for (size_t i = 0; i < end; ++i) {
+                ints[i] = (rand() % 1000) - 500;
+                if (i % 97U == 0) {
+                    ints[i] = i % 2U == 0 ? INT_MIN : INT_MAX;
+                }
+                generic[i] = ints[i];
+                doubles[i] = (double)ints[i] / 8.0;
+                expected[i] = ints[i];
+            }
+            for (size_t s = 0; s < segments; ++s) {
+                size_t size = offsets[s + 1U] - offsets[s];
+                if (size != 0) {
+                    qsort(
+                        expected + offsets[s], size, sizeof(int),
+                        ac_compare_int
+                    );
+                }
+            }
+
+            size_t threads = kThreads[t];
+            MU_ASSERT(
+                ac_sort_segments_int(ints, offsets, segments, threads) == 0
+            );
+            MU_ASSERT(
+                ac_sort_segments(
+                    generic, offsets, segments, sizeof(int), ac_compare_int,
+                    threads
+                ) == 0
+            );
+            MU_ASSERT(
+                ac_sort_segments_double(doubles, offsets, segments, threads) ==
+                0
+            );
+            for (size_t i = 0; i < end; ++i) {
+                MU_ASSERT(ints[i] == expected[i]);
+                MU_ASSERT(generic[i] == expected[i]);
+                MU_ASSERT(doubles[i] == (double)expected[i] / 8.0);
+            }
+        }
+    }
+    free(offsets);
+    free(ints);
+    free(generic);
+    free(doubles);
+    free(expected);
+}
+
+static void test_sort_segments_long_and_wide(void) {
+    // Segments longer than a batch leave whole batches empty.
+    size_t offsets[] = {0, 3, 40000, 40000, 90001, 90017};
+    size_t segments = sizeof(offsets) / sizeof(offsets[0]) - 1U;
+    double *data = (double *)malloc(90017U * sizeof(double));
+    int *ints = (int *)malloc(90017U * sizeof(int));
+    MU_ASSERT(data != NULL && ints != NULL);
+    if (data != NULL && ints != NULL) {
+        for (size_t i = 0; i < 90017U; ++i) {
+            ints[i] = rand() - (RAND_MAX / 2);
+            data[i] = (double)ints[i];
+        }
+        MU_ASSERT(
+            ac_sort_segments(
+                data, offsets, segments, sizeof(double), compare_double, 4
+            ) == 0
+        );
+        MU_ASSERT(ac_sort_segments_int(ints, offsets, segments, 4) == 0);
+        for (size_t s = 0; s < segments; ++s) {
+            for (size_t i = offsets[s] + 1U; i < offsets[s + 1U]; ++i) {
+                MU_ASSERT(data[i - 1U] <= data[i]);
+                MU_ASSERT(ints[i - 1U] <= ints[i]);
+            }
+        }
+    }
+    free(data);
+    free(ints);
+
+    size_t wide_offsets[] = {0, 2, 19, 60};
+    wide_element *wide = (wide_element *)calloc(60, sizeof(wide_element));
+    MU_ASSERT(wide != NULL);
+    if (wide != NULL) {
+        for (size_t i = 0; i < 60; ++i) {
+            wide[i].key = rand() % 50;
+            memset(wide[i].payload, wide[i].key, sizeof(wide[i].payload));
+        }
+        MU_ASSERT(
+            ac_sort_segments(
+                wide, wide_offsets, 3, sizeof(wide_element), compare_wide, 1
+            ) == 0
+        );
+        for (size_t s = 0; s < 3; ++s) {
+            for (size_t i = wide_offsets[s]; i < wide_offsets[s + 1U]; ++i) {
+                MU_ASSERT(wide[i].payload[299] == (unsigned char)wide[i].key);
+                MU_ASSERT(
+                    i == wide_offsets[s] || wide[i - 1U].key <= wide[i].key
+                );
+            }
+        }
+        free(wide);
+    }
+}
+
+static void test_sort_segments_invalid_arguments(void) {
+    int data[] = {3, 2, 1, 0};
+    size_t decreasing[] = {0, 3, 2};
+    size_t empty[] = {4, 4, 4};
+    size_t valid[] = {0, 2, 4};
+
+    MU_ASSERT(ac_sort_segments_int(data, NULL, 2, 1) == -EINVAL);
+    MU_ASSERT(ac_sort_segments_int(data, decreasing, 2, 1) == -EINVAL);
+    MU_ASSERT(data[0] == 3 && data[1] == 2 && data[2] == 1);
+    MU_ASSERT(ac_sort_segments_double(NULL, valid, 2, 1) == -EINVAL);
+    MU_ASSERT(
+        ac_sort_segments(data, valid, 2, 0, ac_compare_int, 1) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_sort_segments(data, valid, 2, sizeof(int), NULL, 1) == -EINVAL
+    );
+
+    MU_ASSERT(ac_sort_segments_int(NULL, NULL, 0, 1) == 0);
+    MU_ASSERT(ac_sort_segments_int(NULL, empty, 2, 1) == 0);
+    MU_ASSERT(ac_sort_segments_int(data, valid, 2, 1) == 0);
+    MU_ASSERT(data[0] == 2 && data[1] == 3 && data[2] == 0 && data[3] == 1);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_sort_segments_matches_qsort);
+    run_test(test_sort_segments_long_and_wide);
+    run_test(test_sort_segments_invalid_arguments);
+    return summary();
+}
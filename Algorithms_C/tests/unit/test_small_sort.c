@@ -0,0 +1,118 @@
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/small_sort.h"
+#include "algorithms_c/utils/minunit.h"
+
+static int compare_int_values(const void *lhs, const void *rhs) {
+    int left = *(const int *)lhs;
+    int right = *(const int *)rhs;
+    return (left > right) - (left < right);
+}
+
+static void test_small_int_matches_qsort_for_every_size(void) {
+    int data[AC_SORT_SMALL_MAX_INT];
+    int expected[AC_SORT_SMALL_MAX_INT];
+    for (size_t size = 0; size <= AC_SORT_SMALL_MAX_INT; ++size) {
+        for (int round = 0; round < 50; ++round) {
+            for (size_t i = 0; i < size; ++i) {
+                int value = (rand() % 200) - 100;
+                if (rand() % 8 == 0) {
+                    value = (rand() % 2) ? INT_MAX : INT_MIN;
+                }
+                data[i] = value;
+                expected[i] = value;
+            }
+            qsort(expected, size, sizeof(int), compare_int_values);
+            ac_sort_small_int(data, size);
+            MU_ASSERT(memcmp(data, expected, size * sizeof(int)) == 0);
+        }
+    }
+}
+
+static void test_small_float_sorts_and_moves_nans_last(void) {
+    float data[] = {3.5f, NAN, -1.0f, INFINITY, 0.0f, -INFINITY, NAN, 2.0f,
+                    -1.0f, 7.0f, 1.5f};
+    size_t size = sizeof(data) / sizeof(data[0]);
+    ac_sort_small_float(data, size);
+    MU_ASSERT(data[0] == -INFINITY);
+    MU_ASSERT(data[1] == -1.0f);
+    MU_ASSERT(data[2] == -1.0f);
+    MU_ASSERT(data[3] == 0.0f);
+    MU_ASSERT(data[8] == INFINITY);
+    MU_ASSERT(isnan(data[9]));
+    MU_ASSERT(isnan(data[10]));
+    for (size_t i = 1; i < 9; ++i) {
+        MU_ASSERT(data[i - 1] <= data[i]);
+    }
+}
+
+static void test_small_double_preserves_signed_zeros(void) {
+    double data[AC_SORT_SMALL_MAX_DOUBLE];
+    for (size_t size = 2; size <= AC_SORT_SMALL_MAX_DOUBLE; ++size) {
+        size_t negative_zeros = 0;
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = (i % 2U) ? -0.0 : 0.0;
+            negative_zeros += i % 2U;
+        }
+        data[size / 2U] = -3.0;
+        negative_zeros -= (size / 2U) % 2U;
+
+        ac_sort_small_double(data, size);
+        MU_ASSERT(data[0] == -3.0);
+        size_t seen = 0;
+        for (size_t i = 1; i < size; ++i) {
+            MU_ASSERT(data[i] == 0.0);
+            seen += signbit(data[i]) ? 1U : 0U;
+        }
+        MU_ASSERT(seen == negative_zeros);
+    }
+}
+
+static void test_small_double_matches_qsort(void) {
+    double data[AC_SORT_SMALL_MAX_DOUBLE];
+    for (size_t size = 0; size <= AC_SORT_SMALL_MAX_DOUBLE; ++size) {
+        for (int round = 0; round < 50; ++round) {
+            for (size_t i = 0; i < size; ++i) {
+                data[i] = (double)(rand() % 1000) / 8.0;
+            }
+            ac_sort_small_double(data, size);
+            for (size_t i = 1; i < size; ++i) {
+                MU_ASSERT(data[i - 1] <= data[i]);
+            }
+        }
+    }
+}
+
+static void test_small_sort_large_input_falls_back(void) {
+    int data[100];
+    for (size_t i = 0; i < 100; ++i) {
+        data[i] = (int)(100 - i);
+    }
+    ac_sort_small_int(data, 100);
+    for (size_t i = 0; i < 100; ++i) {
+        MU_ASSERT(data[i] == (int)(i + 1U));
+    }
+}
+
+static void test_small_sort_invalid_arguments_are_noop(void) {
+    float data[] = {2.0f, 1.0f};
+    ac_sort_small_int(NULL, 4);
+    ac_sort_small_float(NULL, 4);
+    ac_sort_small_double(NULL, 4);
+    ac_sort_small_float(data, 1);
+    MU_ASSERT(data[0] == 2.0f);
+    MU_ASSERT(data[1] == 1.0f);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_small_int_matches_qsort_for_every_size);
+    run_test(test_small_float_sorts_and_moves_nans_last);
+    run_test(test_small_double_preserves_signed_zeros);
+    run_test(test_small_double_matches_qsort);
+    run_test(test_small_sort_large_input_falls_back);
+    run_test(test_small_sort_invalid_arguments_are_noop);
+    return summary();
+}
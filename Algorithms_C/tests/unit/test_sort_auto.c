@@ -0,0 +1,189 @@
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/binary_search.h"
+#include "algorithms_c/algorithms/sort_auto.h"
+#include "algorithms_c/utils/minunit.h"
+
+typedef enum {
+    SHAPE_RANDOM,
+    SHAPE_SORTED,
+    SHAPE_REVERSED,
+    SHAPE_NEARLY_SORTED,
+    SHAPE_FEW_UNIQUE,
+    SHAPE_NARROW,
+    SHAPE_COUNT,
+} input_shape;
+
+static void fill_ints(int *data, size_t size, input_shape shape) {
+    for (size_t i = 0; i < size; ++i) {
+        switch (shape) {
+        case SHAPE_RANDOM:
+            data[i] = rand() - (RAND_MAX / 2);
+            break;
+        case SHAPE_SORTED:
+        case SHAPE_NEARLY_SORTED:
+            data[i] = (int)i * 3;
+            break;
+        case SHAPE_REVERSED:
+            data[i] = (int)(size - i) * 3;
+            break;
+        case SHAPE_FEW_UNIQUE:
+            data[i] = (rand() % 4) * 100000;
+            break;
+        default:
+            data[i] = rand() % (int)(size / 2U + 1U);
+            break;
+        }
+    }
+    if (shape == SHAPE_NEARLY_SORTED) {
+        for (size_t swaps = size / 100U; swaps > 0; --swaps) {
+            size_t a = (size_t)rand() % size;
+            size_t b = (size_t)rand() % size;
+            int tmp = data[a];
+            data[a] = data[b];
+            data[b] = tmp;
+        }
+    }
+}
+
+static void test_sort_auto_sorts_every_shape(void) {
+    static const size_t kSizes[] = {0, 1, 2, 15, 17, 33, 300, 5000, 70000};
+    enum { kMaxSize = 70000 };
+    int *ints = (int *)malloc(kMaxSize * sizeof(int));
+    int *generic = (int *)malloc(kMaxSize * sizeof(int));
+    int *expected = (int *)malloc(kMaxSize * sizeof(int));
+    double *doubles = (double *)malloc(kMaxSize * sizeof(double));
+    MU_ASSERT(
+        ints != NULL && generic != NULL && expected != NULL && doubles != NULL
+    );
+    if (ints == NULL || generic == NULL || expected == NULL ||
+        doubles == NULL) {
+        free(ints);
+        free(generic);
+        free(expected);
+        free(doubles);
+        return;
+    }
+
+    for (int shape = 0; shape < SHAPE_COUNT; ++shape) {
+        for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+            size_t size = kSizes[s];
+            fill_ints(ints, size, (input_shape)shape);
+            for (size_t i = 0; i < size; ++i) {
+                generic[i] = ints[i];
+                expected[i] = ints[i];
+                doubles[i] = (double)ints[i] / 4.0;
+            }
+            if (size != 0) {
+                qsort(expected, size, sizeof(int), ac_compare_int);
+            }
+
+            ac_sort_engine engine = (ac_sort_engine)99;
+            MU_ASSERT(ac_sort_auto_int(ints, size, &engine) == 0);
+            MU_ASSERT(strcmp(ac_sort_engine_name(engine), "unknown") != 0);
+            MU_ASSERT(
+                ac_sort_auto(
+                    generic, size, sizeof(int), ac_compare_int, NULL
+                ) == 0
+            );
+            MU_ASSERT(ac_sort_auto_double(doubles, size, NULL) == 0);
+            for (size_t i = 0; i < size; ++i) {
+                MU_ASSERT(ints[i] == expected[i]);
+                MU_ASSERT(generic[i] == expected[i]);
+                MU_ASSERT(doubles[i] == (double)expected[i] / 4.0);
+            }
+        }
+    }
+    free(ints);
+    free(generic);
+    free(expected);
+    free(doubles);
+}
+
+static void test_sort_auto_reports_engine(void) {
+    enum { kSize = 20000 };
+    int *data = (int *)malloc(kSize * sizeof(int));
+    MU_ASSERT(data != NULL);
+    if (data == NULL) {
+        return;
+    }
+    ac_sort_engine engine;
+
+    fill_ints(data, 20, SHAPE_RANDOM);
+    MU_ASSERT(ac_sort_auto_int(data, 20, &engine) == 0);
+    MU_ASSERT(engine == AC_SORT_ENGINE_NETWORK);
+    MU_ASSERT(
+        ac_sort_auto(data, 10, sizeof(int), ac_compare_int, &engine) == 0
+    );
+    MU_ASSERT(engine == AC_SORT_ENGINE_INSERTION);
+
+    fill_ints(data, kSize, SHAPE_SORTED);
+    MU_ASSERT(ac_sort_auto_int(data, kSize, &engine) == 0);
+    MU_ASSERT(engine == AC_SORT_ENGINE_NONE);
+
+    fill_ints(data, kSize, SHAPE_REVERSED);
+    MU_ASSERT(ac_sort_auto_int(data, kSize, &engine) == 0);
+    MU_ASSERT(engine == AC_SORT_ENGINE_ADAPTIVE_MERGE);
+    fill_ints(data, kSize, SHAPE_REVERSED);
+    MU_ASSERT(
+        ac_sort_auto(data, kSize, sizeof(int), ac_compare_int, &engine) == 0
+    );
+    MU_ASSERT(engine == AC_SORT_ENGINE_ADAPTIVE_MERGE);
+
+    fill_ints(data, kSize, SHAPE_NARROW);
+    MU_ASSERT(ac_sort_auto_int(data, kSize, &engine) == 0);
+    MU_ASSERT(engine == AC_SORT_ENGINE_COUNTING);
+
+    fill_ints(data, kSize, SHAPE_FEW_UNIQUE);
+    double *doubles = (double *)malloc(kSize * sizeof(double));
+    MU_ASSERT(doubles != NULL);
+    if (doubles != NULL) {
+        for (size_t i = 0; i < kSize; ++i) {
+            doubles[i] = (double)data[i];
+        }
+        MU_ASSERT(ac_sort_auto_double(doubles, kSize, &engine) == 0);
+        MU_ASSERT(engine == AC_SORT_ENGINE_INTROSORT);
+        free(doubles);
+    }
+
+    fill_ints(data, kSize, SHAPE_RANDOM);
+    MU_ASSERT(
+        ac_sort_auto(data, kSize, sizeof(int), ac_compare_int, &engine) == 0
+    );
+    MU_ASSERT(engine == AC_SORT_ENGINE_INTROSORT);
+    free(data);
+}
+
+static void test_sort_auto_double_places_nan(void) {
+    double values[] = {3.0, NAN, -1.0, 2.0, -INFINITY};
+    ac_sort_engine engine;
+    MU_ASSERT(ac_sort_auto_double(values, 5, &engine) == 0);
+    MU_ASSERT(engine == AC_SORT_ENGINE_RADIX);
+    MU_ASSERT(values[0] == -INFINITY && values[1] == -1.0);
+    MU_ASSERT(values[2] == 2.0 && values[3] == 3.0 && isnan(values[4]));
+}
+
+static void test_sort_auto_invalid_arguments(void) {
+    int data[] = {2, 1};
+    MU_ASSERT(
+        ac_sort_auto(NULL, 2, sizeof(int), ac_compare_int, NULL) == -EINVAL
+    );
+    MU_ASSERT(ac_sort_auto(data, 2, 0, ac_compare_int, NULL) == -EINVAL);
+    MU_ASSERT(ac_sort_auto(data, 2, sizeof(int), NULL, NULL) == -EINVAL);
+    MU_ASSERT(ac_sort_auto_int(NULL, 2, NULL) == -EINVAL);
+    MU_ASSERT(ac_sort_auto_double(NULL, 2, NULL) == -EINVAL);
+    MU_ASSERT(ac_sort_auto_int(NULL, 0, NULL) == 0);
+    MU_ASSERT(strcmp(ac_sort_engine_name(AC_SORT_ENGINE_RADIX), "radix") == 0);
+    MU_ASSERT(strcmp(ac_sort_engine_name((ac_sort_engine)99), "unknown") == 0);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_sort_auto_sorts_every_shape);
+    run_test(test_sort_auto_reports_engine);
+    run_test(test_sort_auto_double_places_nan);
+    run_test(test_sort_auto_invalid_arguments);
+    return summary();
+}
@@ -0,0 +1,317 @@
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/damerau_levenshtein.h"
+#include "algorithms_c/algorithms/sort_workspace.h"
+#include "algorithms_c/algorithms/split_find.h"
+#include "algorithms_c/utils/minunit.h"
+
+typedef int (*ws_sort_fn)(
+    ac_sort_workspace *workspace,
+    void *data,
+    size_t size,
+    size_t element_size,
+    ac_compare_fn compare
+);
+
+typedef struct {
+    int key;
+    int sequence;
+} keyed_record;
+
+static int compare_keyed_record(const void *lhs, const void *rhs) {
+    int left = ((const keyed_record *)lhs)->key;
+    int right = ((const keyed_record *)rhs)->key;
+    return (left > right) - (left < right);
+}
+
+static const ws_sort_fn kSorts[] = {
+    ac_insertion_sort_ws, ac_binary_insertion_sort_ws, ac_bubble_sort_ws,
+    ac_selection_sort_ws, ac_shell_sort_ws,            ac_comb_sort_ws,
+    ac_merge_sort_ws,     ac_tim_sort_ws,              ac_quick_sort_ws,
+    ac_heap_sort_ws,
+};
+
+static const ws_sort_fn kStableSorts[] = {
+    ac_insertion_sort_ws, ac_binary_insertion_sort_ws, ac_bubble_sort_ws,
+    ac_merge_sort_ws,     ac_tim_sort_ws,
+};
+
+static void test_workspace_sorts_match_qsort(void) {
+    enum { kSize = 700 };
+    int input[kSize];
+    int expected[kSize];
+    int actual[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        input[i] = (rand() % 200) - 100;
+    }
+    memcpy(expected, input, sizeof(input));
+    qsort(expected, kSize, sizeof(int), ac_compare_int);
+
+    ac_sort_workspace workspace;
+    MU_ASSERT(
+        ac_sort_workspace_init(
+            &workspace, ac_sort_workspace_bytes(kSize, sizeof(int))
+        ) == 0
+    );
+    for (size_t s = 0; s < sizeof(kSorts) / sizeof(kSorts[0]); ++s) {
+        // The same workspace serves every call.
+        for (size_t size = 0; size <= kSize; size += 233U) {
+            memcpy(actual, input, sizeof(input));
+            MU_ASSERT(
+                kSorts[s](
+                    &workspace, actual, size, sizeof(int), ac_compare_int
+                ) == 0
+            );
+            for (size_t i = 1; i < size; ++i) {
+                MU_ASSERT(actual[i - 1] <= actual[i]);
+            }
+        }
+        memcpy(actual, input, sizeof(input));
+        MU_ASSERT(
+            kSorts[s](&workspace, actual, kSize, sizeof(int), ac_compare_int) ==
+            0
+        );
+        MU_ASSERT(memcmp(actual, expected, sizeof(expected)) == 0);
+    }
+    ac_sort_workspace_destroy(&workspace);
+    MU_ASSERT(workspace.memory == NULL && workspace.capacity == 0);
+}
+
+static void test_stable_workspace_sorts_keep_ties_in_order(void) {
+    enum { kSize = 1500 };
+    keyed_record input[kSize];
+    keyed_record actual[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        input[i].key = rand() % 13;
+        input[i].sequence = (int)i;
+    }
+
+    static unsigned char storage[kSize * sizeof(keyed_record)];
+    ac_sort_workspace workspace;
+    MU_ASSERT(
+        ac_sort_workspace_init_buffer(&workspace, storage, sizeof(storage)) ==
+        0
+    );
+    for (size_t s = 0; s < sizeof(kStableSorts) / sizeof(kStableSorts[0]);
+         ++s) {
+        memcpy(actual, input, sizeof(input));
+        MU_ASSERT(
+            kStableSorts[s](
+                &workspace, actual, kSize, sizeof(keyed_record),
+                compare_keyed_record
+            ) == 0
+        );
+        for (size_t i = 1; i < kSize; ++i) {
+            MU_ASSERT(actual[i - 1].key <= actual[i].key);
+            if (actual[i - 1].key == actual[i].key) {
+                MU_ASSERT(actual[i - 1].sequence < actual[i].sequence);
+            }
+        }
+    }
+    ac_sort_workspace_destroy(&workspace);
+}
+
+static void test_small_workspace_reports_enospc(void) {
+    int data[] = {5, 4, 3, 2, 1};
+    unsigned char storage[3 * sizeof(int)];
+    ac_sort_workspace workspace;
+    MU_ASSERT(
+        ac_sort_workspace_init_buffer(&workspace, storage, sizeof(storage)) ==
+        0
+    );
+
+    // Merge sort needs one slot per element and must not touch the data.
+    MU_ASSERT(
+        ac_merge_sort_ws(&workspace, data, 5, sizeof(int), ac_compare_int) ==
+        -ENOSPC
+    );
+    MU_ASSERT(data[0] == 5 && data[4] == 1);
+
+    // TimSort degrades to rotation merges instead of failing.
+    MU_ASSERT(
+        ac_tim_sort_ws(&workspace, data, 5, sizeof(int), ac_compare_int) == 0
+    );
+    for (int i = 0; i < 5; ++i) {
+        MU_ASSERT(data[i] == i + 1);
+    }
+
+    ac_sort_workspace empty;
+    MU_ASSERT(ac_sort_workspace_init(&empty, 0) == 0);
+    MU_ASSERT(
+        ac_quick_sort_ws(&empty, data, 5, sizeof(int), ac_compare_int) ==
+        -ENOSPC
+    );
+    MU_ASSERT(
+        ac_heap_sort_ws(&empty, data, 1, sizeof(int), ac_compare_int) == 0
+    );
+    ac_sort_workspace_destroy(&empty);
+}
+
+static void test_tim_sort_ws_with_one_element_workspace(void) {
+    enum { kSize = 2000 };
+    keyed_record actual[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        actual[i].key = rand() % 31;
+        actual[i].sequence = (int)i;
+    }
+
+    keyed_record slot;
+    ac_sort_workspace workspace;
+    MU_ASSERT(
+        ac_sort_workspace_init_buffer(&workspace, &slot, sizeof(slot)) == 0
+    );
+    MU_ASSERT(
+        ac_tim_sort_ws(
+            &workspace, actual, kSize, sizeof(keyed_record),
+            compare_keyed_record
+        ) == 0
+    );
+    for (size_t i = 1; i < kSize; ++i) {
+        MU_ASSERT(actual[i - 1].key <= actual[i].key);
+        if (actual[i - 1].key == actual[i].key) {
+            MU_ASSERT(actual[i - 1].sequence < actual[i].sequence);
+        }
+    }
+}
+
+static void test_workspace_invalid_arguments(void) {
+    int data[] = {2, 1};
+    unsigned char storage[16];
+    ac_sort_workspace workspace;
+    MU_ASSERT(ac_sort_workspace_init(NULL, 8) == -EINVAL);
+    MU_ASSERT(ac_sort_workspace_init_buffer(&workspace, NULL, 8) == -EINVAL);
+    MU_ASSERT(
+        ac_sort_workspace_init_buffer(&workspace, storage, sizeof(storage)) ==
+        0
+    );
+
+    for (size_t s = 0; s < sizeof(kSorts) / sizeof(kSorts[0]); ++s) {
+        MU_ASSERT(
+            kSorts[s](NULL, data, 2, sizeof(int), ac_compare_int) == -EINVAL
+        );
+        MU_ASSERT(
+            kSorts[s](&workspace, NULL, 2, sizeof(int), ac_compare_int) ==
+            -EINVAL
+        );
+        MU_ASSERT(kSorts[s](&workspace, data, 2, 0, ac_compare_int) == -EINVAL);
+        MU_ASSERT(kSorts[s](&workspace, data, 2, sizeof(int), NULL) == -EINVAL);
+        MU_ASSERT(
+            kSorts[s](&workspace, NULL, 0, sizeof(int), ac_compare_int) == 0
+        );
+    }
+    MU_ASSERT(data[0] == 2 && data[1] == 1);
+    MU_ASSERT(ac_sort_workspace_bytes(SIZE_MAX, 2) == SIZE_MAX);
+    MU_ASSERT(ac_sort_workspace_bytes(0, 8) == 8);
+}
+
+static void test_reserve_aligns_typed_storage(void) {
+    unsigned char storage[64];
+    ac_sort_workspace workspace;
+    MU_ASSERT(
+        ac_sort_workspace_init_buffer(&workspace, storage + 1, 63) == 0
+    );
+
+    void *slot = ac_sort_workspace_reserve(&workspace, 4, sizeof(double), 8);
+    MU_ASSERT(slot != NULL);
+    MU_ASSERT(((uintptr_t)slot % 8U) == 0);
+    MU_ASSERT(
+        ac_sort_workspace_reserve(&workspace, 8, sizeof(double), 8) == NULL
+    );
+    MU_ASSERT(ac_sort_workspace_reserve(&workspace, 1, 1, 3) == NULL);
+}
+
+static void test_split_find_ws_leaves_input_untouched(void) {
+    const double values[] = {9.0, -1.0, 4.0, 4.0, 7.5, 0.25, 3.0};
+    enum { kCount = sizeof(values) / sizeof(values[0]) };
+    const double sorted[] = {-1.0, 0.25, 3.0, 4.0, 4.0, 7.5, 9.0};
+    double storage[kCount];
+    ac_sort_workspace workspace;
+    MU_ASSERT(
+        ac_sort_workspace_init_buffer(&workspace, storage, sizeof(storage)) ==
+        0
+    );
+
+    for (size_t index = 0; index < kCount; ++index) {
+        double result = 0.0;
+        MU_ASSERT(
+            ac_split_find_ws(&workspace, values, kCount, index, &result) == 0
+        );
+        MU_ASSERT(result == sorted[index]);
+    }
+    MU_ASSERT(values[0] == 9.0 && values[6] == 3.0);
+
+    double result = 0.0;
+    MU_ASSERT(
+        ac_split_find_ws(&workspace, values, kCount, kCount, &result) ==
+        -EINVAL
+    );
+    MU_ASSERT(
+        ac_sort_workspace_init_buffer(&workspace, storage, sizeof(double)) == 0
+    );
+    MU_ASSERT(
+        ac_split_find_ws(&workspace, values, kCount, 0, &result) == -ENOSPC
+    );
+    MU_ASSERT(
+        ac_split_find_workspace_bytes(kCount) >= kCount * sizeof(double)
+    );
+}
+
+static void test_damerau_levenshtein_ws_matches_allocating_version(void) {
+    const char *pairs[][2] = {
+        {"", ""},
+        {"abc", ""},
+        {"ca", "ac"},
+        {"kitten", "sitting"},
+        {"a cat", "an abct"},
+        {"transposition", "tarnspositoin"},
+    };
+    ac_sort_workspace workspace;
+    MU_ASSERT(
+        ac_sort_workspace_init(
+            &workspace, ac_damerau_levenshtein_workspace_bytes(16, 16)
+        ) == 0
+    );
+
+    for (size_t i = 0; i < sizeof(pairs) / sizeof(pairs[0]); ++i) {
+        int expected =
+            ac_damerau_levenshtein_distance(pairs[i][0], pairs[i][1]);
+        MU_ASSERT(expected >= 0);
+        MU_ASSERT(
+            ac_damerau_levenshtein_distance_ws(
+                &workspace, pairs[i][0], pairs[i][1]
+            ) == expected
+        );
+        MU_ASSERT(
+            ac_damerau_levenshtein_distance_ws(
+                &workspace, pairs[i][1], pairs[i][0]
+            ) == expected
+        );
+    }
+
+    MU_ASSERT(
+        ac_damerau_levenshtein_distance_ws(
+            &workspace, "abcdefghijklmnopqrstuvwxyz",
+            "zyxwvutsrqponmlkjihgfedcba"
+        ) == -ENOSPC
+    );
+    MU_ASSERT(
+        ac_damerau_levenshtein_distance_ws(&workspace, NULL, "a") == -EINVAL
+    );
+    MU_ASSERT(ac_damerau_levenshtein_distance_ws(NULL, "a", "b") == -EINVAL);
+    ac_sort_workspace_destroy(&workspace);
+}
+
+int main(void) {
+    srand(909u);
+    run_test(test_workspace_sorts_match_qsort);
+    run_test(test_stable_workspace_sorts_keep_ties_in_order);
+    run_test(test_small_workspace_reports_enospc);
+    run_test(test_tim_sort_ws_with_one_element_workspace);
+    run_test(test_workspace_invalid_arguments);
+    run_test(test_reserve_aligns_typed_storage);
+    run_test(test_split_find_ws_leaves_input_untouched);
+    run_test(test_damerau_levenshtein_ws_matches_allocating_version);
+    return summary();
+}
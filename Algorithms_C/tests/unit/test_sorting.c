@@ -1,4 +1,9 @@
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "algorithms_c/algorithms/sorting.h"
 #include "algorithms_c/structures/vector.h"
 #include "algorithms_c/utils/minunit.h"
@@ -147,6 +152,247 @@ static void test_merge_sort_double_invalid_arguments_are_noop(void) {
     MU_ASSERT(data[1] == -1.0);
 }
 
+typedef struct {
+    int key;
+    int sequence;
+} keyed_record;
+
+static int compare_keyed_record(const void *lhs, const void *rhs) {
+    return ac_compare_int(
+        &((const keyed_record *)lhs)->key, &((const keyed_record *)rhs)->key
+    );
+}
+
+static void test_merge_sort_parallel_matches_serial(void) {
+    enum { kSize = 100000 };
+    static keyed_record expected[kSize];
+    static keyed_record actual[kSize];
+    const size_t thread_counts[] = {1, 2, 3, 4, 8};
+
+    for (size_t i = 0; i < kSize; ++i) {
+        expected[i].key = rand() % 1000;
+        expected[i].sequence = (int)i;
+    }
+    memcpy(actual, expected, sizeof(expected));
+    ac_merge_sort(expected, kSize, sizeof(keyed_record), compare_keyed_record);
+
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]);
+         ++t) {
+        keyed_record *work = (keyed_record *)malloc(sizeof(actual));
+        MU_ASSERT(work != NULL);
+        if (work == NULL) {
+            return;
+        }
+        memcpy(work, actual, sizeof(actual));
+        ac_merge_sort_parallel(
+            work, kSize, sizeof(keyed_record), compare_keyed_record,
+            thread_counts[t]
+        );
+        MU_ASSERT(memcmp(work, expected, sizeof(expected)) == 0);
+        free(work);
+    }
+}
+
+static void test_merge_sort_parallel_small_and_invalid_inputs(void) {
+    int data[] = {4, 3, 2, 1};
+    ac_merge_sort_parallel(NULL, 4, sizeof(int), ac_compare_int, 4);
+    ac_merge_sort_parallel(data, 4, sizeof(int), NULL, 4);
+    MU_ASSERT(data[0] == 4);
+    ac_merge_sort_parallel(data, 4, sizeof(int), ac_compare_int, 0);
+    assert_sorted(data, 4);
+}
+
+static void test_sample_sort_matches_qsort(void) {
+    enum { kSize = 200000 };
+    static int data[kSize];
+    static int expected[kSize];
+    const int moduli[] = {1000000, 7, 1};
+    const size_t thread_counts[] = {1, 2, 4, 16};
+
+    for (size_t m = 0; m < sizeof(moduli) / sizeof(moduli[0]); ++m) {
+        for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]);
+             ++t) {
+            for (size_t i = 0; i < kSize; ++i) {
+                data[i] = rand() % moduli[m];
+                expected[i] = data[i];
+            }
+            qsort(expected, kSize, sizeof(int), ac_compare_int);
+            ac_sample_sort(
+                data, kSize, sizeof(int), ac_compare_int, thread_counts[t]
+            );
+            MU_ASSERT(memcmp(data, expected, sizeof(expected)) == 0);
+        }
+    }
+}
+
+static size_t counted_comparisons = 0;
+
+static int compare_keyed_record_counted(const void *lhs, const void *rhs) {
+    ++counted_comparisons;
+    return compare_keyed_record(lhs, rhs);
+}
+
+static void test_tim_sort_matches_stable_merge_sort(void) {
+    enum { kSize = 20000 };
+    static keyed_record expected[kSize];
+    static keyed_record actual[kSize];
+
+    for (int pattern = 0; pattern < 5; ++pattern) {
+        for (size_t i = 0; i < kSize; ++i) {
+            int key;
+            switch (pattern) {
+            case 0:
+                key = rand() % 50;
+                break;
+            case 1:
+                key = (int)(kSize - i);
+                break;
+            case 2:
+                // Concatenated sorted chunks.
+                key = (int)(i % 1500U);
+                break;
+            case 3:
+                // Alternating ascending and descending stretches.
+                key = ((i / 700U) % 2U) ? (int)(kSize - i) : (int)i;
+                break;
+            default:
+                key = rand();
+                break;
+            }
+            expected[i].key = key;
+            expected[i].sequence = (int)i;
+        }
+        memcpy(actual, expected, sizeof(expected));
+        ac_merge_sort(
+            expected, kSize, sizeof(keyed_record), compare_keyed_record
+        );
+        ac_tim_sort(actual, kSize, sizeof(keyed_record), compare_keyed_record);
+        MU_ASSERT(memcmp(actual, expected, sizeof(expected)) == 0);
+    }
+}
+
+static void test_inplace_merge_sort_matches_stable_merge_sort(void) {
+    enum { kSize = 20000 };
+    static keyed_record expected[kSize];
+    static keyed_record actual[kSize];
+    static keyed_record buffer[kSize / 2];
+    const size_t sizes[] = {0U, 1U, 2U, 31U, 33U, 1000U, kSize};
+
+    for (int pattern = 0; pattern < 4; ++pattern) {
+        for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+            size_t size = sizes[s];
+            for (size_t i = 0; i < size; ++i) {
+                int key = pattern == 0   ? rand() % 30
+                          : pattern == 1 ? (int)(size - i) / 3
+                          : pattern == 2 ? (int)(i % 700U)
+                                         : rand();
+                expected[i].key = key;
+                expected[i].sequence = (int)i;
+            }
+            ac_merge_sort(
+                expected, size, sizeof(keyed_record), compare_keyed_record
+            );
+
+            // Built-in buffer only, a tiny caller buffer, and one large
+            // enough for every merge.
+            const size_t buffer_bytes[] = {0U, 64U, sizeof(buffer)};
+            for (size_t b = 0; b < 3U; ++b) {
+                // Restore the input order recorded in ``sequence``.
+                for (size_t i = 0; i < size; ++i) {
+                    actual[expected[i].sequence] = expected[i];
+                }
+                MU_ASSERT(
+                    ac_inplace_merge_sort_buffered(
+                        actual, size, sizeof(keyed_record),
+                        compare_keyed_record,
+                        buffer_bytes[b] == 0U ? NULL : buffer, buffer_bytes[b]
+                    ) == 0
+                );
+                MU_ASSERT(
+                    memcmp(actual, expected, size * sizeof(keyed_record)) == 0
+                );
+            }
+        }
+    }
+}
+
+static size_t g_binary_insertion_calls = 0;
+
+static int counting_keyed_compare(const void *lhs, const void *rhs) {
+    ++g_binary_insertion_calls;
+    return compare_keyed_record(lhs, rhs);
+}
+
+static void test_binary_insertion_sort_is_stable(void) {
+    enum { kSize = 2000 };
+    static keyed_record expected[kSize];
+    static keyed_record actual[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        expected[i].key = rand() % 40;
+        expected[i].sequence = (int)i;
+    }
+    memcpy(actual, expected, sizeof(expected));
+    ac_merge_sort(expected, kSize, sizeof(keyed_record), compare_keyed_record);
+    g_binary_insertion_calls = 0;
+    ac_binary_insertion_sort(
+        actual, kSize, sizeof(keyed_record), counting_keyed_compare
+    );
+    MU_ASSERT(memcmp(actual, expected, sizeof(expected)) == 0);
+    // At most one check plus ceil(log2(i)) probes per element.
+    MU_ASSERT(g_binary_insertion_calls <= (size_t)kSize * 12U);
+
+    // Sorted input costs one comparison per element and is left untouched.
+    g_binary_insertion_calls = 0;
+    ac_binary_insertion_sort(
+        actual, kSize, sizeof(keyed_record), counting_keyed_compare
+    );
+    MU_ASSERT(g_binary_insertion_calls == kSize - 1U);
+    MU_ASSERT(memcmp(actual, expected, sizeof(expected)) == 0);
+}
+
+static void test_tim_sort_is_linear_on_presorted_input(void) {
+    enum { kSize = 50000 };
+    static keyed_record records[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        records[i].key = (int)(kSize - i);
+        records[i].sequence = (int)i;
+    }
+
+    counted_comparisons = 0;
+    ac_tim_sort(
+        records, kSize, sizeof(keyed_record), compare_keyed_record_counted
+    );
+    MU_ASSERT(counted_comparisons == kSize - 1U);
+    MU_ASSERT(records[0].key == 1);
+    MU_ASSERT(records[kSize - 1U].key == (int)kSize);
+
+    // A handful of misplaced elements should cost little more than a scan.
+    for (size_t i = 0; i < 20; ++i) {
+        size_t a = (size_t)rand() % kSize;
+        size_t b = (size_t)rand() % kSize;
+        keyed_record tmp = records[a];
+        records[a] = records[b];
+        records[b] = tmp;
+    }
+    counted_comparisons = 0;
+    ac_tim_sort(
+        records, kSize, sizeof(keyed_record), compare_keyed_record_counted
+    );
+    MU_ASSERT(counted_comparisons < 2U * kSize);
+    for (size_t i = 0; i < kSize; ++i) {
+        MU_ASSERT(records[i].key == (int)(i + 1U));
+    }
+}
+
+static void test_tim_sort_invalid_arguments_are_noop(void) {
+    int data[] = {2, 1};
+    ac_tim_sort(NULL, 2, sizeof(int), ac_compare_int);
+    ac_tim_sort(data, 2, sizeof(int), NULL);
+    ac_tim_sort(data, 2, 0, ac_compare_int);
+    MU_ASSERT(data[0] == 2);
+    MU_ASSERT(data[1] == 1);
+}
+
 static void test_quick_sort(void) {
     int data[128];
     fill_random(data, 128);
@@ -154,6 +400,254 @@ static void test_quick_sort(void) {
     assert_sorted(data, 128);
 }
 
+static void test_quick_sort_adversarial_patterns(void) {
+    enum { kSize = 5000 };
+    static int data[kSize];
+
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = (int)i;
+    }
+    ac_quick_sort(data, kSize, sizeof(int), ac_compare_int);
+    assert_sorted(data, kSize);
+
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = (int)(kSize - i);
+    }
+    ac_quick_sort(data, kSize, sizeof(int), ac_compare_int);
+    assert_sorted(data, kSize);
+
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = 7;
+    }
+    ac_quick_sort(data, kSize, sizeof(int), ac_compare_int);
+    assert_sorted(data, kSize);
+
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = (int)(i < kSize / 2 ? i : kSize - i);
+    }
+    ac_quick_sort(data, kSize, sizeof(int), ac_compare_int);
+    assert_sorted(data, kSize);
+
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = rand() % 4;
+    }
+    ac_quick_sort(data, kSize, sizeof(int), ac_compare_int);
+    assert_sorted(data, kSize);
+}
+
+/*
+ * McIlroy's "killer adversary" for quicksort: values are decided lazily, and
+ * whenever two undecided ("gas") values meet, the one that is not the likely
+ * pivot is frozen to the next smallest value.  Without a depth limit the
+ * introsort would need a quadratic number of comparisons.
+ */
+static int *g_adversary_values;
+static int g_adversary_solid;
+static int g_adversary_candidate;
+static int g_adversary_gas;
+static size_t g_adversary_comparisons;
+
+static int compare_adversary(const void *lhs, const void *rhs) {
+    int x = *(const int *)lhs;
+    int y = *(const int *)rhs;
+    ++g_adversary_comparisons;
+    if (g_adversary_values[x] == g_adversary_gas &&
+        g_adversary_values[y] == g_adversary_gas) {
+        g_adversary_values[x == g_adversary_candidate ? x : y] =
+            g_adversary_solid++;
+    }
+    if (g_adversary_values[x] == g_adversary_gas) {
+        g_adversary_candidate = x;
+    } else if (g_adversary_values[y] == g_adversary_gas) {
+        g_adversary_candidate = y;
+    }
+    return (g_adversary_values[x] > g_adversary_values[y]) -
+           (g_adversary_values[x] < g_adversary_values[y]);
+}
+
+static void test_quick_sort_survives_killer_adversary(void) {
+    enum { kSize = 20000 };
+    static int indices[kSize];
+    static int values[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        indices[i] = (int)i;
+        values[i] = kSize;
+    }
+    g_adversary_values = values;
+    g_adversary_solid = 0;
+    g_adversary_candidate = 0;
+    g_adversary_gas = kSize;
+    g_adversary_comparisons = 0;
+
+    ac_quick_sort(indices, kSize, sizeof(int), compare_adversary);
+    for (size_t i = 1; i < kSize; ++i) {
+        MU_ASSERT(values[indices[i - 1U]] <= values[indices[i]]);
+    }
+    // About 3 n log2 n are spent, partly partitioning before the heap sort
+    // fallback takes over; quadratic behaviour would need ~n^2 / 4.
+    MU_ASSERT(g_adversary_comparisons < 5U * kSize * 15U);
+}
+
+typedef struct {
+    int key;
+    unsigned char payload[300];
+} wide_record;
+
+static int compare_wide_record(const void *lhs, const void *rhs) {
+    return ac_compare_int(
+        &((const wide_record *)lhs)->key, &((const wide_record *)rhs)->key
+    );
+}
+
+static void test_quick_sort_wide_elements(void) {
+    static wide_record records[200];
+    for (size_t i = 0; i < 200; ++i) {
+        records[i].key = rand() % 50;
+        records[i].payload[0] = (unsigned char)records[i].key;
+    }
+    ac_quick_sort(records, 200, sizeof(wide_record), compare_wide_record);
+    for (size_t i = 0; i < 200; ++i) {
+        MU_ASSERT(records[i].payload[0] == (unsigned char)records[i].key);
+        if (i > 0) {
+            MU_ASSERT(records[i - 1].key <= records[i].key);
+        }
+    }
+}
+
+static void test_sample_sort_wide_elements(void) {
+    enum { kSize = 70000 };
+    wide_record *records = (wide_record *)malloc(kSize * sizeof(wide_record));
+    MU_ASSERT(records != NULL);
+    if (records == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < kSize; ++i) {
+        records[i].key = rand() % 5000;
+        records[i].payload[0] = (unsigned char)(records[i].key & 0xFF);
+    }
+    ac_sample_sort(
+        records, kSize, sizeof(wide_record), compare_wide_record, 3
+    );
+    for (size_t i = 1; i < kSize; ++i) {
+        MU_ASSERT(records[i - 1].key <= records[i].key);
+        MU_ASSERT(
+            records[i].payload[0] == (unsigned char)(records[i].key & 0xFF)
+        );
+    }
+    free(records);
+}
+
+static void test_binary_insertion_sort_wide_and_invalid(void) {
+    static wide_record records[150];
+    for (size_t i = 0; i < 150; ++i) {
+        records[i].key = (int)(150U - i);
+        records[i].payload[299] = (unsigned char)records[i].key;
+    }
+    ac_binary_insertion_sort(
+        records, 150, sizeof(wide_record), compare_wide_record
+    );
+    for (size_t i = 0; i < 150; ++i) {
+        MU_ASSERT(records[i].key == (int)(i + 1U));
+        MU_ASSERT(records[i].payload[299] == (unsigned char)records[i].key);
+    }
+
+    int data[] = {3, 1, 2};
+    ac_binary_insertion_sort(NULL, 3, sizeof(int), ac_compare_int);
+    ac_binary_insertion_sort(data, 3, 0, ac_compare_int);
+    ac_binary_insertion_sort(data, 3, sizeof(int), NULL);
+    MU_ASSERT(data[0] == 3);
+    MU_ASSERT(data[1] == 1);
+    MU_ASSERT(data[2] == 2);
+}
+
+static void test_inplace_merge_sort_wide_and_invalid(void) {
+    // Records wider than the built-in buffer rotate by reversal.
+    enum { kWidth = 5000, kCount = 90 };
+    unsigned char *records = (unsigned char *)malloc(kWidth * kCount);
+    MU_ASSERT(records != NULL);
+    if (records == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < kCount; ++i) {
+        int key = rand() % 10;
+        memset(records + (i * kWidth), (int)i, kWidth);
+        memcpy(records + (i * kWidth), &key, sizeof(int));
+    }
+    ac_inplace_merge_sort(records, kCount, kWidth, ac_compare_int);
+    int previous_key = INT_MIN;
+    int previous_tag = -1;
+    for (size_t i = 0; i < kCount; ++i) {
+        const unsigned char *record = records + (i * kWidth);
+        int key;
+        memcpy(&key, record, sizeof(int));
+        int tag = record[kWidth - 1U];
+        MU_ASSERT(previous_key <= key);
+        MU_ASSERT(previous_key < key || previous_tag < tag);
+        previous_key = key;
+        previous_tag = tag;
+    }
+    free(records);
+
+    int data[] = {2, 1};
+    int scratch[4];
+    ac_inplace_merge_sort(NULL, 2, sizeof(int), ac_compare_int);
+    ac_inplace_merge_sort(data, 2, sizeof(int), NULL);
+    MU_ASSERT(data[0] == 2);
+    MU_ASSERT(
+        ac_inplace_merge_sort_buffered(
+            data, 2, sizeof(int), ac_compare_int, NULL, 16U
+        ) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_inplace_merge_sort_buffered(
+            data, 2, 0, ac_compare_int, scratch, sizeof(scratch)
+        ) == -EINVAL
+    );
+    MU_ASSERT(
+        ac_inplace_merge_sort_buffered(
+            data, 2, sizeof(int), ac_compare_int, scratch, sizeof(scratch)
+        ) == 0
+    );
+    MU_ASSERT(data[0] == 1);
+    MU_ASSERT(data[1] == 2);
+}
+
+/** Shell-sort ``count`` records of ``width`` bytes keyed by a leading int. */
+static void check_shell_sort_width(size_t width, size_t count) {
+    unsigned char *records = (unsigned char *)malloc(count * width);
+    MU_ASSERT(records != NULL);
+    if (records == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        int key = rand() % 2000;
+        memset(records + (i * width), (unsigned char)key, width);
+        memcpy(records + (i * width), &key, sizeof(int));
+    }
+    ac_shell_sort(records, count, width, ac_compare_int);
+    int previous = INT_MIN;
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char *record = records + (i * width);
+        int key;
+        memcpy(&key, record, sizeof(int));
+        MU_ASSERT(previous <= key);
+        if (width > sizeof(int)) {
+            MU_ASSERT(record[width - 1U] == (unsigned char)key);
+        }
+        previous = key;
+    }
+    free(records);
+}
+
+static void test_shell_sort_element_widths(void) {
+    // Fixed-width paths, the generic path and the heap-allocated scratch.
+    const size_t widths[] = {4U, 8U, 16U, 12U, 300U};
+    for (size_t w = 0; w < sizeof(widths) / sizeof(widths[0]); ++w) {
+        check_shell_sort_width(widths[w], 5000U);
+        check_shell_sort_width(widths[w], 3U);
+    }
+}
+
 static void test_quick_sort_double(void) {
     double data[] = {4.4, -2.1, 4.4, 0.0, 7.8, -10.0};
     ac_quick_sort_double(data, sizeof(data) / sizeof(data[0]));
@@ -243,6 +737,13 @@ static void test_partition_small_double_invalid_arguments(void) {
     MU_ASSERT(ac_partition_small_double(data, 0, 2, NULL) == -1);
 }
 
+static size_t g_heap_comparisons = 0;
+
+static int compare_int_counted(const void *lhs, const void *rhs) {
+    ++g_heap_comparisons;
+    return ac_compare_int(lhs, rhs);
+}
+
 static void test_heap_sort(void) {
     int data[64];
     fill_random(data, 64);
@@ -250,6 +751,18 @@ static void test_heap_sort(void) {
     assert_sorted(data, 64);
 }
 
+static void test_heap_sort_bottom_up_comparisons(void) {
+    enum { kSize = 4096, kLog2 = 12 };
+    static int data[kSize];
+    fill_random(data, kSize);
+    g_heap_comparisons = 0;
+    ac_heap_sort(data, kSize, sizeof(int), compare_int_counted);
+    assert_sorted(data, kSize);
+    // Floyd's build needs under 2n comparisons and the bottom-up sort-down
+    // about n log2 n; the classic sift-down would need 2 n log2 n.
+    MU_ASSERT(g_heap_comparisons < (kSize * kLog2) + (3U * kSize));
+}
+
 static void test_counting_sort(void) {
     int data[100];
     for (size_t i = 0; i < 100; ++i) {
@@ -273,6 +786,49 @@ static void test_count_sort_auto_invalid_arguments_are_noop(void) {
     MU_ASSERT(data[1] == 1);
 }
 
+static void test_counting_sort_parallel_matches_qsort(void) {
+    enum { kSize = 600000 };
+    static int data[kSize];
+    static int expected[kSize];
+    // Sub-histogram range, wide counted range, radix fallback, one value.
+    const int spans[] = {100, 500000, 2000000000, 1};
+    const size_t thread_counts[] = {1, 3, 8};
+
+    for (size_t s = 0; s < sizeof(spans) / sizeof(spans[0]); ++s) {
+        for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]);
+             ++t) {
+            for (size_t i = 0; i < kSize; ++i) {
+                data[i] = (int)((unsigned)rand() % (unsigned)spans[s]) -
+                          (spans[s] / 2);
+                expected[i] = data[i];
+            }
+            // Long runs of one key.
+            for (size_t i = kSize / 2; i < kSize / 2 + 5000; ++i) {
+                data[i] = 0;
+                expected[i] = 0;
+            }
+            qsort(expected, kSize, sizeof(int), ac_compare_int);
+            ac_counting_sort_int_parallel(
+                data, kSize, -(spans[s] / 2), spans[s] - (spans[s] / 2),
+                thread_counts[t]
+            );
+            MU_ASSERT(memcmp(data, expected, sizeof(expected)) == 0);
+        }
+    }
+}
+
+static void test_count_sort_auto_extreme_bounds(void) {
+    int data[] = {INT_MAX, 0, INT_MIN, -1, INT_MAX, 5, INT_MIN};
+    size_t size = sizeof(data) / sizeof(data[0]);
+    ac_count_sort_int_auto(data, size);
+    assert_sorted(data, size);
+    MU_ASSERT(data[0] == INT_MIN && data[size - 1] == INT_MAX);
+
+    int few[] = {3, -2, 3, 3, -2, 1, 0, 3};
+    ac_counting_sort_int(few, 8, 3, -2);
+    assert_sorted(few, 8);
+}
+
 static void test_digit_sort(void) {
     int data[] = {170, 45, 75, 90, 802, 24, 2, 66, -5, -300, 45};
     ac_digit_sort_int(data, sizeof(data) / sizeof(data[0]), 10);
@@ -303,6 +859,113 @@ static void test_digit_sort_invalid_arguments_are_noop(void) {
     MU_ASSERT(data[2] == 2);
 }
 
+static int compare_int64_values(const void *lhs, const void *rhs) {
+    int64_t left = *(const int64_t *)lhs;
+    int64_t right = *(const int64_t *)rhs;
+    return (left > right) - (left < right);
+}
+
+static int compare_uint32_values(const void *lhs, const void *rhs) {
+    uint32_t left = *(const uint32_t *)lhs;
+    uint32_t right = *(const uint32_t *)rhs;
+    return (left > right) - (left < right);
+}
+
+static void test_radix_sort_int32_matches_qsort(void) {
+    enum { kSize = 3000 };
+    static int32_t data[kSize];
+    static int32_t expected[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = (int32_t)((rand() % 2000001) - 1000000);
+        expected[i] = data[i];
+    }
+    data[0] = INT32_MIN;
+    data[1] = INT32_MAX;
+    expected[0] = INT32_MIN;
+    expected[1] = INT32_MAX;
+    qsort(expected, kSize, sizeof(int32_t), ac_compare_int);
+    ac_radix_sort_int32(data, kSize);
+    MU_ASSERT(memcmp(data, expected, sizeof(data)) == 0);
+}
+
+static void test_radix_sort_uint32_skips_shared_digits(void) {
+    enum { kSize = 500 };
+    static uint32_t data[kSize];
+    static uint32_t expected[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = UINT32_C(0xABC00000) | (uint32_t)(rand() % 2048);
+        expected[i] = data[i];
+    }
+    qsort(expected, kSize, sizeof(uint32_t), compare_uint32_values);
+    ac_radix_sort_uint32(data, kSize);
+    MU_ASSERT(memcmp(data, expected, sizeof(data)) == 0);
+}
+
+static void test_radix_sort_int64_matches_qsort(void) {
+    enum { kSize = 3000 };
+    static int64_t data[kSize];
+    static int64_t expected[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        int64_t high = (int64_t)(rand() % 65536) - 32768;
+        data[i] = (high * 4294967296LL) + rand();
+        expected[i] = data[i];
+    }
+    qsort(expected, kSize, sizeof(int64_t), compare_int64_values);
+    ac_radix_sort_int64(data, kSize);
+    MU_ASSERT(memcmp(data, expected, sizeof(data)) == 0);
+
+    uint64_t unsigned_data[] = {UINT64_MAX, 0U, 42U, UINT64_C(1) << 63};
+    ac_radix_sort_uint64(unsigned_data, 4);
+    MU_ASSERT(unsigned_data[0] == 0U);
+    MU_ASSERT(unsigned_data[1] == 42U);
+    MU_ASSERT(unsigned_data[2] == UINT64_C(1) << 63);
+    MU_ASSERT(unsigned_data[3] == UINT64_MAX);
+}
+
+static void test_radix_sort_double_total_order(void) {
+    enum { kSize = 2000 };
+    static double data[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = ((double)rand() / RAND_MAX - 0.5) * 1e6;
+    }
+    data[0] = -0.0;
+    data[1] = 0.0;
+    data[2] = INFINITY;
+    data[3] = -INFINITY;
+    data[4] = NAN;
+    ac_radix_sort_double(data, kSize);
+    MU_ASSERT(data[0] == -INFINITY);
+    MU_ASSERT(isnan(data[kSize - 1]));
+    MU_ASSERT(data[kSize - 2] == INFINITY);
+    for (size_t i = 1; i < kSize - 1; ++i) {
+        MU_ASSERT(data[i - 1] <= data[i]);
+        if (data[i - 1] == 0.0 && data[i] == 0.0) {
+            MU_ASSERT(!(signbit(data[i]) && !signbit(data[i - 1])));
+        }
+    }
+}
+
+static void test_radix_sort_float_small_input(void) {
+    float data[] = {2.5f, -0.0f, 0.0f, -3.0f, 1e-30f, -1e30f};
+    ac_radix_sort_float(data, sizeof(data) / sizeof(data[0]));
+    MU_ASSERT(data[0] == -1e30f);
+    MU_ASSERT(data[1] == -3.0f);
+    MU_ASSERT(signbit(data[2]));
+    MU_ASSERT(data[3] == 0.0f && !signbit(data[3]));
+    MU_ASSERT(data[4] == 1e-30f);
+    MU_ASSERT(data[5] == 2.5f);
+}
+
+static void test_digit_sort_opt_large_input(void) {
+    enum { kSize = 4000 };
+    static int data[kSize];
+    for (size_t i = 0; i < kSize; ++i) {
+        data[i] = rand() - (RAND_MAX / 2);
+    }
+    ac_digit_sort_opt_int(data, kSize, 10);
+    assert_sorted(data, kSize);
+}
+
 static void test_selection_sort_invalid_arguments_are_noop(void) {
     int data[] = {3, 1, 2};
     ac_selection_sort(NULL, 3, sizeof(int), ac_compare_int);
@@ -360,22 +1023,44 @@ int main(void) {
     run_test(test_bubble_sort);
     run_test(test_selection_sort);
     run_test(test_shell_sort);
+    run_test(test_binary_insertion_sort_is_stable);
+    run_test(test_inplace_merge_sort_matches_stable_merge_sort);
+    run_test(test_inplace_merge_sort_wide_and_invalid);
+    run_test(test_binary_insertion_sort_wide_and_invalid);
+    run_test(test_shell_sort_element_widths);
     run_test(test_comb_sort);
     run_test(test_selection_sort_handles_duplicates_and_negatives);
     run_test(test_merge_sort);
+    run_test(test_merge_sort_parallel_matches_serial);
+    run_test(test_merge_sort_parallel_small_and_invalid_inputs);
+    run_test(test_tim_sort_matches_stable_merge_sort);
+    run_test(test_tim_sort_is_linear_on_presorted_input);
+    run_test(test_tim_sort_invalid_arguments_are_noop);
     run_test(test_merge_double_arrays);
     run_test(test_merge_sort_double);
     run_test(test_quick_sort);
+    run_test(test_sample_sort_matches_qsort);
+    run_test(test_sample_sort_wide_elements);
+    run_test(test_quick_sort_adversarial_patterns);
+    run_test(test_quick_sort_survives_killer_adversary);
+    run_test(test_quick_sort_wide_elements);
     run_test(test_quick_sort_double);
     run_test(test_split_double_by_pivot);
     run_test(test_closest_to_average_double);
     run_test(test_median_of_three_double);
     run_test(test_partition_small_double);
     run_test(test_heap_sort);
+    run_test(test_heap_sort_bottom_up_comparisons);
     run_test(test_counting_sort);
     run_test(test_count_sort_auto);
     run_test(test_digit_sort);
     run_test(test_digit_sort_opt);
+    run_test(test_radix_sort_int32_matches_qsort);
+    run_test(test_radix_sort_uint32_skips_shared_digits);
+    run_test(test_radix_sort_int64_matches_qsort);
+    run_test(test_radix_sort_double_total_order);
+    run_test(test_radix_sort_float_small_input);
+    run_test(test_digit_sort_opt_large_input);
     run_test(test_selection_sort_invalid_arguments_are_noop);
     run_test(test_bubble_sort_handles_sorted_input);
     run_test(test_bubble_sort_invalid_arguments_are_noop);
@@ -383,6 +1068,8 @@ int main(void) {
     run_test(test_comb_sort_invalid_arguments_are_noop);
     run_test(test_digit_sort_invalid_arguments_are_noop);
     run_test(test_count_sort_auto_invalid_arguments_are_noop);
+    run_test(test_counting_sort_parallel_matches_qsort);
+    run_test(test_count_sort_auto_extreme_bounds);
     run_test(test_digit_sort_opt_invalid_arguments_are_noop);
     run_test(test_insertion_sort_opt_double_invalid_arguments_are_noop);
     run_test(test_insertion_sort_double_invalid_arguments_are_noop);
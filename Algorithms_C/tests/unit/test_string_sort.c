@@ -0,0 +1,202 @@
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "algorithms_c/algorithms/string_sort.h"
+#include "algorithms_c/utils/minunit.h"
+
+static int compare_cstrings(const void *lhs, const void *rhs) {
+    return strcmp(*(const char *const *)lhs, *(const char *const *)rhs);
+}
+
+static int compare_views(const void *lhs, const void *rhs) {
+    const ac_string_view *left = (const ac_string_view *)lhs;
+    const ac_string_view *right = (const ac_string_view *)rhs;
+    size_t common = left->size < right->size ? left->size : right->size;
+    int order = common == 0 ? 0 : memcmp(left->data, right->data, common);
+    if (order != 0) {
+        return order;
+    }
+    return (left->size > right->size) - (left->size < right->size);
+}
+
+/** Write ``count`` URL-like keys sharing long prefixes into ``storage``. */
+static void make_urls(
+    char *storage,
+    size_t stride,
+    const char **strs,
+    size_t count,
+    unsigned hosts
+) {
+    static const char *const kPaths[] = {
+        "api/v1/users", "api/v1/orders", "static/img", "", "api/v2/users",
+    };
+    for (size_t i = 0; i < count; ++i) {
+        char *slot = storage + (i * stride);
+        (void)snprintf(
+            slot, stride, "https://www.example-%u.com/%s/%d",
+            (unsigned)rand() % hosts, kPaths[(size_t)rand() % 5U],
+            rand() % 1000
+        );
+        strs[i] = slot;
+    }
+}
+
+static void test_sort_strings_small_cases(void) {
+    const char *strs[] = {
+        "banana", "", "apple", "app", "\xff", "apple", "b", "application",
+        "Zebra", "app",
+    };
+    const char *expected[] = {
+        "", "Zebra", "app", "app", "apple", "apple", "application", "b",
+        "banana", "\xff",
+    };
+    size_t count = sizeof(strs) / sizeof(strs[0]);
+
+    MU_ASSERT(ac_sort_strings(strs, count) == 0);
+    for (size_t i = 0; i < count; ++i) {
+        MU_ASSERT(strcmp(strs[i], expected[i]) == 0);
+    }
+}
+
+static void test_sort_strings_matches_strcmp(void) {
+    enum { kStride = 64 };
+    static const size_t kSizes[] = {0, 1, 2, 17, 1000, 4096, 30000};
+    static const unsigned kHosts[] = {1, 3, 50};
+    size_t max_size = kSizes[sizeof(kSizes) / sizeof(kSizes[0]) - 1U];
+    char *storage = (char *)malloc(max_size * kStride);
+    const char **strs = (const char **)malloc(max_size * sizeof(char *));
+    const char **expected = (const char **)malloc(max_size * sizeof(char *));
+    MU_ASSERT(storage != NULL && strs != NULL && expected != NULL);
+    if (storage == NULL || strs == NULL || expected == NULL) {
+        free(storage);
+        free((void *)strs);
+        free((void *)expected);
+        return;
+    }
+
+    for (size_t h = 0; h < sizeof(kHosts) / sizeof(kHosts[0]); ++h) {
+        for (size_t s = 0; s < sizeof(kSizes) / sizeof(kSizes[0]); ++s) {
+            size_t size = kSizes[s];
+            make_urls(storage, kStride, strs, size, kHosts[h]);
+            if (size != 0) {
+                memcpy(
+                    (void *)expected, (const void *)strs,
+                    size * sizeof(char *)
+                );
+                qsort(
+                    (void *)expected, size, sizeof(char *), compare_cstrings
+                );
+            }
+            MU_ASSERT(ac_sort_strings(strs, size) == 0);
+            for (size_t i = 0; i < size; ++i) {
+                MU_ASSERT(strcmp(strs[i], expected[i]) == 0);
+            }
+        }
+    }
+    free(storage);
+    free((void *)strs);
+    free((void *)expected);
+}
+
+static void test_sort_strings_identical_long_keys(void) {
+    enum { kSize = 5000, kLength = 600 };
+    char *shared = (char *)malloc(kLength + 1U);
+    char *last = (char *)malloc(kLength + 2U);
+    const char **strs = (const char **)malloc(kSize * sizeof(char *));
+    MU_ASSERT(shared != NULL && last != NULL && strs != NULL);
+    if (shared == NULL || last == NULL || strs == NULL) {
+        free(shared);
+        free(last);
+        free((void *)strs);
+        return;
+    }
+
+    memset(shared, 'k', kLength);
+    shared[kLength] = '\0';
+    memset(last, 'k', kLength + 1U);
+    last[kLength + 1U] = '\0';
+    for (size_t i = 0; i < kSize; ++i) {
+        strs[i] = shared;
+    }
+    strs[kSize / 2] = last;
+
+    MU_ASSERT(ac_sort_strings(strs, kSize) == 0);
+    for (size_t i = 0; i + 1U < kSize; ++i) {
+        MU_ASSERT(strs[i] == shared);
+    }
+    MU_ASSERT(strs[kSize - 1] == last);
+    free(shared);
+    free(last);
+    free((void *)strs);
+}
+
+static void test_sort_string_views_embedded_nul(void) {
+    ac_string_view views[] = {
+        {"ab\0c", 4}, {"ab", 2}, {NULL, 0}, {"ab\0", 3}, {"a\xff", 2},
+        {"ab\0b", 4}, {"b", 1},
+    };
+    ac_string_view expected[] = {
+        {NULL, 0}, {"ab", 2}, {"ab\0", 3}, {"ab\0b", 4}, {"ab\0c", 4},
+        {"a\xff", 2}, {"b", 1},
+    };
+    size_t count = sizeof(views) / sizeof(views[0]);
+
+    MU_ASSERT(ac_sort_string_views(views, count) == 0);
+    for (size_t i = 0; i < count; ++i) {
+        MU_ASSERT(compare_views(&views[i], &expected[i]) == 0);
+    }
+}
+
+static void test_sort_string_views_matches_memcmp(void) {
+    enum { kSize = 20000, kBytes = 8 };
+    unsigned char *storage = (unsigned char *)malloc(kSize * kBytes);
+    ac_string_view *views =
+        (ac_string_view *)malloc(kSize * sizeof(ac_string_view));
+    ac_string_view *expected =
+        (ac_string_view *)malloc(kSize * sizeof(ac_string_view));
+    MU_ASSERT(storage != NULL && views != NULL && expected != NULL);
+    if (storage == NULL || views == NULL || expected == NULL) {
+        free(storage);
+        free(views);
+        free(expected);
+        return;
+    }
+
+    // A tiny alphabet including NUL forces deep, unbalanced buckets.
+    for (size_t i = 0; i < kSize * kBytes; ++i) {
+        storage[i] = (unsigned char)(rand() % 3);
+    }
+    for (size_t i = 0; i < kSize; ++i) {
+        views[i].data = (const char *)storage + (i * kBytes);
+        views[i].size = (size_t)rand() % (kBytes + 1U);
+    }
+    memcpy(expected, views, kSize * sizeof(ac_string_view));
+    qsort(expected, kSize, sizeof(ac_string_view), compare_views);
+
+    MU_ASSERT(ac_sort_string_views(views, kSize) == 0);
+    for (size_t i = 0; i < kSize; ++i) {
+        MU_ASSERT(compare_views(&views[i], &expected[i]) == 0);
+    }
+    free(storage);
+    free(views);
+    free(expected);
+}
+
+static void test_sort_strings_invalid_arguments(void) {
+    MU_ASSERT(ac_sort_strings(NULL, 3) == -EINVAL);
+    MU_ASSERT(ac_sort_string_views(NULL, 3) == -EINVAL);
+    MU_ASSERT(ac_sort_strings(NULL, 0) == 0);
+    MU_ASSERT(ac_sort_string_views(NULL, 0) == 0);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_sort_strings_small_cases);
+    run_test(test_sort_strings_matches_strcmp);
+    run_test(test_sort_strings_identical_long_keys);
+    run_test(test_sort_string_views_embedded_nul);
+    run_test(test_sort_string_views_matches_memcmp);
+    run_test(test_sort_strings_invalid_arguments);
+    return summary();
+}
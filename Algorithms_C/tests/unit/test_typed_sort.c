@@ -0,0 +1,137 @@
+#include <math.h>
+#include <stdlib.h>
+#include "algorithms_c/algorithms/typed_sort.h"
+#include "algorithms_c/utils/minunit.h"
+
+#define TYPED_SIZE 1000U
+
+typedef void (*int_sort_fn)(int *, size_t);
+
+static int compare_int_values(const void *lhs, const void *rhs) {
+    int left = *(const int *)lhs;
+    int right = *(const int *)rhs;
+    return (left > right) - (left < right);
+}
+
+static void check_int_kernel(int_sort_fn sort, int modulus) {
+    static int data[TYPED_SIZE];
+    static int expected[TYPED_SIZE];
+    for (size_t i = 0; i < TYPED_SIZE; ++i) {
+        data[i] = (rand() % modulus) - (modulus / 2);
+        expected[i] = data[i];
+    }
+    qsort(expected, TYPED_SIZE, sizeof(int), compare_int_values);
+    sort(data, TYPED_SIZE);
+    for (size_t i = 0; i < TYPED_SIZE; ++i) {
+        MU_ASSERT(data[i] == expected[i]);
+    }
+}
+
+static void test_int_kernels_match_qsort(void) {
+    check_int_kernel(ac_insertion_sort_int, 100000);
+    check_int_kernel(ac_binary_insertion_sort_int, 100000);
+    check_int_kernel(ac_binary_insertion_sort_int, 3);
+    check_int_kernel(ac_shell_sort_int, 100000);
+    check_int_kernel(ac_shell_sort_int, 3);
+    check_int_kernel(ac_heap_sort_int, 100000);
+    check_int_kernel(ac_quick_sort_int, 100000);
+    check_int_kernel(ac_merge_sort_int, 100000);
+    check_int_kernel(ac_quick_sort_int, 3);
+    check_int_kernel(ac_merge_sort_int, 3);
+}
+
+static void test_quick_sort_int_sorted_and_reversed(void) {
+    static int data[TYPED_SIZE];
+    for (size_t i = 0; i < TYPED_SIZE; ++i) {
+        data[i] = (int)(TYPED_SIZE - i);
+    }
+    ac_quick_sort_int(data, TYPED_SIZE);
+    for (size_t i = 0; i < TYPED_SIZE; ++i) {
+        MU_ASSERT(data[i] == (int)(i + 1U));
+    }
+    ac_quick_sort_int(data, TYPED_SIZE);
+    for (size_t i = 0; i < TYPED_SIZE; ++i) {
+        MU_ASSERT(data[i] == (int)(i + 1U));
+    }
+}
+
+static void test_generic_dispatch(void) {
+    unsigned long long big[] = {5ULL, 18446744073709551615ULL, 0ULL, 7ULL};
+    double reals[] = {2.5, -1.0, 0.0, -7.25, 2.5};
+    float floats[] = {3.0f, -2.0f, 1.5f};
+    long longs[] = {-3L, 9L, 0L, -3L};
+
+    ac_sort(big, 4);
+    ac_sort(reals, 5);
+    ac_stable_sort(floats, 3);
+    ac_stable_sort(longs, 4);
+
+    MU_ASSERT(big[0] == 0ULL);
+    MU_ASSERT(big[1] == 5ULL);
+    MU_ASSERT(big[2] == 7ULL);
+    MU_ASSERT(big[3] == 18446744073709551615ULL);
+    MU_ASSERT(reals[0] == -7.25);
+    MU_ASSERT(reals[4] == 2.5);
+    MU_ASSERT(floats[0] == -2.0f);
+    MU_ASSERT(floats[2] == 3.0f);
+    MU_ASSERT(longs[0] == -3L);
+    MU_ASSERT(longs[1] == -3L);
+    MU_ASSERT(longs[3] == 9L);
+}
+
+static void test_stable_sort_keeps_signed_zero_order(void) {
+    // -0.0 and +0.0 compare equal, so a stable sort must keep their order.
+    static double reals[TYPED_SIZE];
+    static float floats[TYPED_SIZE];
+    for (size_t size = 2; size <= TYPED_SIZE; size += size < 64U ? 1U : 312U) {
+        for (size_t i = 0; i < size; ++i) {
+            reals[i] = i % 2U == 0 ? -0.0 : 0.0;
+            floats[i] = i % 3U == 0 ? 0.0f : -0.0f;
+        }
+        ac_stable_sort(reals, size);
+        ac_stable_sort(floats, size);
+        for (size_t i = 0; i < size; ++i) {
+            MU_ASSERT((signbit(reals[i]) != 0) == (i % 2U == 0));
+            MU_ASSERT((signbit(floats[i]) != 0) == (i % 3U != 0));
+        }
+    }
+}
+
+static void test_nan_input_stays_in_bounds(void) {
+    static double data[TYPED_SIZE];
+    size_t nan_count = 0;
+    for (size_t i = 0; i < TYPED_SIZE; ++i) {
+        data[i] = (i % 7U == 0U) ? NAN : (double)(rand() % 100);
+    }
+    ac_quick_sort_double(data, TYPED_SIZE);
+    ac_shell_sort_double(data, TYPED_SIZE);
+    for (size_t i = 0; i < TYPED_SIZE; ++i) {
+        if (isnan(data[i])) {
+            ++nan_count;
+        }
+    }
+    MU_ASSERT(nan_count == (TYPED_SIZE + 6U) / 7U);
+}
+
+static void test_typed_kernels_invalid_arguments_are_noop(void) {
+    int data[] = {2, 1};
+    ac_quick_sort_int(NULL, 2);
+    ac_merge_sort_int(NULL, 2);
+    ac_heap_sort_int(data, 0);
+    ac_insertion_sort_int(data, 1);
+    ac_shell_sort_int(NULL, 2);
+    ac_binary_insertion_sort_int(data, 1);
+    MU_ASSERT(data[0] == 2);
+    MU_ASSERT(data[1] == 1);
+}
+
+int main(void) {
+    srand(2024u);
+    run_test(test_int_kernels_match_qsort);
+    run_test(test_quick_sort_int_sorted_and_reversed);
+    run_test(test_generic_dispatch);
+    run_test(test_stable_sort_keeps_signed_zero_order);
+    run_test(test_nan_input_stays_in_bounds);
+    run_test(test_typed_kernels_invalid_arguments_are_noop);
+    return summary();
+}